@@ -0,0 +1,190 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on duplicate mb keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebb_*" and one with "cebb_ofs_*" which takes a key        *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct ceb_node) in *
+ * the call to the underlying functions.                                     *
+\*****************************************************************************/
+
+/* Inserts node <node> into tree <tree> based on its key that
+ * immediately follows the node and for <len> bytes. Returns the inserted node, which is
+ * appended after any other one already holding the same key.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _insert, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return _ceb_insert(root, node, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* return the first node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebb, _first, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _ceb_first(root, kofs, CEB_KT_MB);
+}
+
+/* return the last node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebb, _last, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _ceb_last(root, kofs, CEB_KT_MB);
+}
+
+/* calls <cb> with <arg> for each node in ascending order of keys of <len>
+ * bytes, visiting each of them once, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes were
+ * visited. <cb> must not modify the tree.
+ */
+CEB_FDECL5(struct ceb_node *, cebb, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return _ceb_walk(root, kofs, CEB_KT_MB, len, cb, arg);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Keys are <len> bytes long. Duplicates are visited in insertion
+ * order. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEB_FDECL7(struct ceb_node *, cebb, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return _ceb_walk_range(root, kofs, CEB_KT_MB, 0, len, lo, 0, len, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive,
+ * duplicates included. Keys are <len> bytes long.
+ */
+CEB_FDECL5(size_t, cebb, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, size_t, len)
+{
+	return _ceb_count_range(root, kofs, CEB_KT_MB, 0, len, lo, 0, len, hi);
+}
+
+/* look up the specified key <key> of length <len>, and returns either the node
+ * containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _ceb_lookup(root, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key or the highest below it, and returns either the
+ * last node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _ceb_lookup_le(root, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* look up highest key below the specified one, and returns either the
+ * last node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _ceb_lookup_lt(root, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key or the smallest above it, and returns either the
+ * first node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _ceb_lookup_ge(root, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the smallest key above the specified one, and returns either the
+ * first node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _ceb_lookup_gt(root, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. Duplicates are visited in insertion order. The approach consists
+ * in looking up that node, recalling the last time a left turn was made, and
+ * returning the first node along the right branch at that fork. The <len>
+ * field must correspond to the key length in bytes.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _next, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return _ceb_next(root, kofs, CEB_KT_MB, 0, len, key, node);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found. Duplicates are visited in reverse insertion order. The approach
+ * consists in looking up that node, recalling the last time a right turn was
+ * made, and returning the last node along the left branch at that fork. The
+ * <len> field must correspond to the key length in bytes.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _prev, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return _ceb_prev(root, kofs, CEB_KT_MB, 0, len, key, node);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node. Only this exact node is removed, even if other ones
+ * share the same key. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _delete, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return _ceb_delete(root, node, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key, and detaches the first node holding it and
+ * returns it if found, or NULL if not found. The <len> field must correspond to the key length in bytes.
+ */
+CEB_FDECL4(struct ceb_node *, cebb, _pick, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _ceb_delete(root, NULL, kofs, CEB_KT_MB, 0, len, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive,
+ * duplicates included, and returns their number. Keys are <len> bytes long.
+ * Each deleted node is passed to <free_cb> with <arg> once detached, unless
+ * <free_cb> is NULL. The nodes are not passed in any particular order.
+ */
+CEB_FDECL7(size_t, cebb, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg, size_t, len)
+{
+	return _ceb_delete_range(root, kofs, CEB_KT_MB, 0, len, lo, 0, len, hi, free_cb, arg);
+}
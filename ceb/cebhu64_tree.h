@@ -0,0 +1,74 @@
+/*
+ * Compact Elastic Binary Trees - exported functions for operations on u64 keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+#include <inttypes.h>
+
+/* simpler version */
+struct cebh_node *cebhu64_insert(int16_t *root, struct cebh_node *node);
+struct cebh_node *cebhu64_first(int16_t *root);
+struct cebh_node *cebhu64_last(int16_t *root);
+struct cebh_node *cebhu64_walk(int16_t *root, ceb_walk_cb cb, void *arg);
+void cebhu64_iter_init(struct ceb_iter *iter, int16_t *root);
+struct cebh_node *cebhu64_iter_next(struct ceb_iter *iter);
+struct cebh_node *cebhu64_iter_prev(struct ceb_iter *iter);
+struct cebh_node *cebhu64_iter_seek(struct ceb_iter *iter, uint64_t key);
+struct cebh_node *cebhu64_walk_range(int16_t *root, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebhu64_count_range(int16_t *root, uint64_t lo, uint64_t hi);
+struct cebh_node *cebhu64_lookup(int16_t *root, uint64_t key);
+struct cebh_node *cebhu64_lookup_le(int16_t *root, uint64_t key);
+struct cebh_node *cebhu64_lookup_lt(int16_t *root, uint64_t key);
+struct cebh_node *cebhu64_lookup_ge(int16_t *root, uint64_t key);
+struct cebh_node *cebhu64_lookup_gt(int16_t *root, uint64_t key);
+struct cebh_node *cebhu64_next(int16_t *root, struct cebh_node *node);
+struct cebh_node *cebhu64_prev(int16_t *root, struct cebh_node *node);
+struct cebh_node *cebhu64_delete(int16_t *root, struct cebh_node *node);
+struct cebh_node *cebhu64_pick(int16_t *root, uint64_t key);
+size_t cebhu64_delete_range(int16_t *root, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+void cebhu64_default_dump(int16_t *ceb_root, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebh_node *cebhu64_ofs_insert(int16_t *root, ptrdiff_t kofs, struct cebh_node *node);
+struct cebh_node *cebhu64_ofs_first(int16_t *root, ptrdiff_t kofs);
+struct cebh_node *cebhu64_ofs_last(int16_t *root, ptrdiff_t kofs);
+struct cebh_node *cebhu64_ofs_walk(int16_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebhu64_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int16_t *root);
+struct cebh_node *cebhu64_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebh_node *cebhu64_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebh_node *cebhu64_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, uint64_t key);
+struct cebh_node *cebhu64_ofs_walk_range(int16_t *root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebhu64_ofs_count_range(int16_t *root, ptrdiff_t kofs, uint64_t lo, uint64_t hi);
+struct cebh_node *cebhu64_ofs_lookup(int16_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebh_node *cebhu64_ofs_lookup_le(int16_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebh_node *cebhu64_ofs_lookup_lt(int16_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebh_node *cebhu64_ofs_lookup_ge(int16_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebh_node *cebhu64_ofs_lookup_gt(int16_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebh_node *cebhu64_ofs_next(int16_t *root, ptrdiff_t kofs, struct cebh_node *node);
+struct cebh_node *cebhu64_ofs_prev(int16_t *root, ptrdiff_t kofs, struct cebh_node *node);
+struct cebh_node *cebhu64_ofs_delete(int16_t *root, ptrdiff_t kofs, struct cebh_node *node);
+struct cebh_node *cebhu64_ofs_pick(int16_t *root, ptrdiff_t kofs, uint64_t key);
+size_t cebhu64_ofs_delete_range(int16_t *root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+void cebhu64_ofs_default_dump(int16_t *root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -0,0 +1,225 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on mb keys
+ * using the small relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebhub_*" and one with "cebhub_ofs_*" which takes a key    *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct cebh_node)   *
+ * in the call to the underlying functions.                                  *
+\*****************************************************************************/
+
+/* Inserts node <node> into unique tree <tree> based on its key that
+ * immediately follows the node and for <len> bytes. Returns the
+ * inserted node or the one that already contains the same key.
+ * NULL is returned if the node is not within the 64 kB following the root.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _insert, int16_t *, root, ptrdiff_t, kofs, struct cebh_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebh_node *)_cebu_insert((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* return the first node or NULL if not found. */
+CEBH_FDECL2(struct cebh_node *, cebhub, _first, int16_t *, root, ptrdiff_t, kofs)
+{
+	return (struct cebh_node *)_cebu_first((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB);
+}
+
+/* return the last node or NULL if not found. */
+CEBH_FDECL2(struct cebh_node *, cebhub, _last, int16_t *, root, ptrdiff_t, kofs)
+{
+	return (struct cebh_node *)_cebu_last((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB);
+}
+
+/* calls <cb> with <arg> for each node in ascending order of keys of <len>
+ * bytes, visiting each of them once, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes were
+ * visited. <cb> must not modify the tree.
+ */
+CEBH_FDECL5(struct cebh_node *, cebhub, _walk, int16_t *, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return (struct cebh_node *)_cebu_walk((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, len, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEBH_FDECL3(void, cebhub, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, int16_t *, root)
+{
+	_cebu_iter_init(iter, (struct ceb_node **)root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. Keys are <len> bytes long. NULL is also returned once the
+ * iterator is stale.
+ */
+CEBH_FDECL3(struct cebh_node *, cebhub, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs, size_t, len)
+{
+	return (struct cebh_node *)_cebu_iter_step(iter, kofs, CEB_AM_H, CEB_KT_MB, len, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. Keys are <len> bytes long. NULL is also returned once the
+ * iterator is stale.
+ */
+CEBH_FDECL3(struct cebh_node *, cebhub, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs, size_t, len)
+{
+	return (struct cebh_node *)_cebu_iter_step(iter, kofs, CEB_AM_H, CEB_KT_MB, len, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_iter_seek(iter, kofs, CEB_AM_H, CEB_KT_MB, 0, len, key);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Keys are <len> bytes long. Returns the node the walk stopped
+ * on, or NULL once all nodes in the range were visited. The walk descends
+ * once towards <lo>, then visits the following nodes until the first one
+ * past <hi>. <cb> must not modify the tree.
+ */
+CEBH_FDECL7(struct cebh_node *, cebhub, _walk_range, int16_t *, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return (struct cebh_node *)_cebu_walk_range((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, lo, 0, len, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ * Keys are <len> bytes long.
+ */
+CEBH_FDECL5(size_t, cebhub, _count_range, int16_t *, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, size_t, len)
+{
+	return _cebu_count_range((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, lo, 0, len, hi);
+}
+
+/* look up the specified key <key> of length <len>, and returns either the node
+ * containing it, or NULL if not found.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _lookup, int16_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_lookup((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key or the highest below it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _lookup_le, int16_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_lookup_le((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up highest key below the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _lookup_lt, int16_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_lookup_lt((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key or the smallest above it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _lookup_ge, int16_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_lookup_ge((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the smallest key above the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _lookup_gt, int16_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_lookup_gt((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a left turn was made, and returning the first node along the right
+ * branch at that fork. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _next, int16_t *, root, ptrdiff_t, kofs, struct cebh_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebh_node *)_cebu_next((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a right turn was made, and returning the last node along the left
+ * branch at that fork. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _prev, int16_t *, root, ptrdiff_t, kofs, struct cebh_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebh_node *)_cebu_prev((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _delete, int16_t *, root, ptrdiff_t, kofs, struct cebh_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebh_node *)_cebu_delete((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key, and detaches it and returns it if found, or NULL
+ * if not found. The <len> field must correspond to the key length in bytes.
+ */
+CEBH_FDECL4(struct cebh_node *, cebhub, _pick, int16_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebh_node *)_cebu_delete((struct ceb_node **)root, NULL, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Keys are <len> bytes long. Each deleted node is
+ * passed to <free_cb> with <arg> once detached, unless <free_cb> is NULL.
+ * The nodes are not passed in any particular order.
+ */
+CEBH_FDECL7(size_t, cebhub, _delete_range, int16_t *, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg, size_t, len)
+{
+	return _cebu_delete_range((struct ceb_node **)root, kofs, CEB_AM_H, NULL, CEB_KT_MB, 0, len, lo, 0, len, hi, free_cb, arg);
+}
@@ -0,0 +1,72 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on mb keys
+ * using the small relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct cebh_node *cebhub_insert(int16_t *root, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_first(int16_t *root);
+struct cebh_node *cebhub_last(int16_t *root);
+struct cebh_node *cebhub_walk(int16_t *root, ceb_walk_cb cb, void *arg, size_t len);
+void cebhub_iter_init(struct ceb_iter *iter, int16_t *root);
+struct cebh_node *cebhub_iter_next(struct ceb_iter *iter, size_t len);
+struct cebh_node *cebhub_iter_prev(struct ceb_iter *iter, size_t len);
+struct cebh_node *cebhub_iter_seek(struct ceb_iter *iter, const void *key, size_t len);
+struct cebh_node *cebhub_walk_range(int16_t *root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebhub_count_range(int16_t *root, const void *lo, const void *hi, size_t len);
+struct cebh_node *cebhub_lookup(int16_t *root, const void *key, size_t len);
+struct cebh_node *cebhub_lookup_le(int16_t *root, const void *key, size_t len);
+struct cebh_node *cebhub_lookup_lt(int16_t *root, const void *key, size_t len);
+struct cebh_node *cebhub_lookup_ge(int16_t *root, const void *key, size_t len);
+struct cebh_node *cebhub_lookup_gt(int16_t *root, const void *key, size_t len);
+struct cebh_node *cebhub_next(int16_t *root, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_prev(int16_t *root, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_delete(int16_t *root, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_pick(int16_t *root, const void *key, size_t len);
+size_t cebhub_delete_range(int16_t *root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
+
+/* version taking a key offset */
+struct cebh_node *cebhub_ofs_insert(int16_t *root, ptrdiff_t kofs, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_ofs_first(int16_t *root, ptrdiff_t kofs);
+struct cebh_node *cebhub_ofs_last(int16_t *root, ptrdiff_t kofs);
+struct cebh_node *cebhub_ofs_walk(int16_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg, size_t len);
+void cebhub_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int16_t *root);
+struct cebh_node *cebhub_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct cebh_node *cebhub_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct cebh_node *cebhub_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key, size_t len);
+struct cebh_node *cebhub_ofs_walk_range(int16_t *root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebhub_ofs_count_range(int16_t *root, ptrdiff_t kofs, const void *lo, const void *hi, size_t len);
+struct cebh_node *cebhub_ofs_lookup(int16_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebh_node *cebhub_ofs_lookup_le(int16_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebh_node *cebhub_ofs_lookup_lt(int16_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebh_node *cebhub_ofs_lookup_ge(int16_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebh_node *cebhub_ofs_lookup_gt(int16_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebh_node *cebhub_ofs_next(int16_t *root, ptrdiff_t kofs, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_ofs_prev(int16_t *root, ptrdiff_t kofs, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_ofs_delete(int16_t *root, ptrdiff_t kofs, struct cebh_node *node, size_t len);
+struct cebh_node *cebhub_ofs_pick(int16_t *root, ptrdiff_t kofs, const void *key, size_t len);
+size_t cebhub_ofs_delete_range(int16_t *root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
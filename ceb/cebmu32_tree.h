@@ -0,0 +1,75 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on u32 keys
+ * using the medium relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+#include <inttypes.h>
+
+/* simpler version */
+struct cebm_node *cebmu32_insert(int32_t *root, struct cebm_node *node);
+struct cebm_node *cebmu32_first(int32_t *root);
+struct cebm_node *cebmu32_last(int32_t *root);
+struct cebm_node *cebmu32_walk(int32_t *root, ceb_walk_cb cb, void *arg);
+void cebmu32_iter_init(struct ceb_iter *iter, int32_t *root);
+struct cebm_node *cebmu32_iter_next(struct ceb_iter *iter);
+struct cebm_node *cebmu32_iter_prev(struct ceb_iter *iter);
+struct cebm_node *cebmu32_iter_seek(struct ceb_iter *iter, uint32_t key);
+struct cebm_node *cebmu32_walk_range(int32_t *root, uint32_t lo, uint32_t hi, ceb_walk_cb cb, void *arg);
+size_t cebmu32_count_range(int32_t *root, uint32_t lo, uint32_t hi);
+struct cebm_node *cebmu32_lookup(int32_t *root, uint32_t key);
+struct cebm_node *cebmu32_lookup_le(int32_t *root, uint32_t key);
+struct cebm_node *cebmu32_lookup_lt(int32_t *root, uint32_t key);
+struct cebm_node *cebmu32_lookup_ge(int32_t *root, uint32_t key);
+struct cebm_node *cebmu32_lookup_gt(int32_t *root, uint32_t key);
+struct cebm_node *cebmu32_next(int32_t *root, struct cebm_node *node);
+struct cebm_node *cebmu32_prev(int32_t *root, struct cebm_node *node);
+struct cebm_node *cebmu32_delete(int32_t *root, struct cebm_node *node);
+struct cebm_node *cebmu32_pick(int32_t *root, uint32_t key);
+size_t cebmu32_delete_range(int32_t *root, uint32_t lo, uint32_t hi, ceb_free_cb free_cb, void *arg);
+void cebmu32_default_dump(int32_t *ceb_root, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebm_node *cebmu32_ofs_insert(int32_t *root, ptrdiff_t kofs, struct cebm_node *node);
+struct cebm_node *cebmu32_ofs_first(int32_t *root, ptrdiff_t kofs);
+struct cebm_node *cebmu32_ofs_last(int32_t *root, ptrdiff_t kofs);
+struct cebm_node *cebmu32_ofs_walk(int32_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebmu32_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int32_t *root);
+struct cebm_node *cebmu32_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebm_node *cebmu32_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebm_node *cebmu32_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, uint32_t key);
+struct cebm_node *cebmu32_ofs_walk_range(int32_t *root, ptrdiff_t kofs, uint32_t lo, uint32_t hi, ceb_walk_cb cb, void *arg);
+size_t cebmu32_ofs_count_range(int32_t *root, ptrdiff_t kofs, uint32_t lo, uint32_t hi);
+struct cebm_node *cebmu32_ofs_lookup(int32_t *root, ptrdiff_t kofs, uint32_t key);
+struct cebm_node *cebmu32_ofs_lookup_le(int32_t *root, ptrdiff_t kofs, uint32_t key);
+struct cebm_node *cebmu32_ofs_lookup_lt(int32_t *root, ptrdiff_t kofs, uint32_t key);
+struct cebm_node *cebmu32_ofs_lookup_ge(int32_t *root, ptrdiff_t kofs, uint32_t key);
+struct cebm_node *cebmu32_ofs_lookup_gt(int32_t *root, ptrdiff_t kofs, uint32_t key);
+struct cebm_node *cebmu32_ofs_next(int32_t *root, ptrdiff_t kofs, struct cebm_node *node);
+struct cebm_node *cebmu32_ofs_prev(int32_t *root, ptrdiff_t kofs, struct cebm_node *node);
+struct cebm_node *cebmu32_ofs_delete(int32_t *root, ptrdiff_t kofs, struct cebm_node *node);
+struct cebm_node *cebmu32_ofs_pick(int32_t *root, ptrdiff_t kofs, uint32_t key);
+size_t cebmu32_ofs_delete_range(int32_t *root, ptrdiff_t kofs, uint32_t lo, uint32_t hi, ceb_free_cb free_cb, void *arg);
+void cebmu32_ofs_default_dump(int32_t *root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -0,0 +1,72 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on mb keys
+ * using the medium relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct cebm_node *cebmub_insert(int32_t *root, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_first(int32_t *root);
+struct cebm_node *cebmub_last(int32_t *root);
+struct cebm_node *cebmub_walk(int32_t *root, ceb_walk_cb cb, void *arg, size_t len);
+void cebmub_iter_init(struct ceb_iter *iter, int32_t *root);
+struct cebm_node *cebmub_iter_next(struct ceb_iter *iter, size_t len);
+struct cebm_node *cebmub_iter_prev(struct ceb_iter *iter, size_t len);
+struct cebm_node *cebmub_iter_seek(struct ceb_iter *iter, const void *key, size_t len);
+struct cebm_node *cebmub_walk_range(int32_t *root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebmub_count_range(int32_t *root, const void *lo, const void *hi, size_t len);
+struct cebm_node *cebmub_lookup(int32_t *root, const void *key, size_t len);
+struct cebm_node *cebmub_lookup_le(int32_t *root, const void *key, size_t len);
+struct cebm_node *cebmub_lookup_lt(int32_t *root, const void *key, size_t len);
+struct cebm_node *cebmub_lookup_ge(int32_t *root, const void *key, size_t len);
+struct cebm_node *cebmub_lookup_gt(int32_t *root, const void *key, size_t len);
+struct cebm_node *cebmub_next(int32_t *root, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_prev(int32_t *root, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_delete(int32_t *root, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_pick(int32_t *root, const void *key, size_t len);
+size_t cebmub_delete_range(int32_t *root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
+
+/* version taking a key offset */
+struct cebm_node *cebmub_ofs_insert(int32_t *root, ptrdiff_t kofs, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_ofs_first(int32_t *root, ptrdiff_t kofs);
+struct cebm_node *cebmub_ofs_last(int32_t *root, ptrdiff_t kofs);
+struct cebm_node *cebmub_ofs_walk(int32_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg, size_t len);
+void cebmub_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int32_t *root);
+struct cebm_node *cebmub_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct cebm_node *cebmub_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct cebm_node *cebmub_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key, size_t len);
+struct cebm_node *cebmub_ofs_walk_range(int32_t *root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebmub_ofs_count_range(int32_t *root, ptrdiff_t kofs, const void *lo, const void *hi, size_t len);
+struct cebm_node *cebmub_ofs_lookup(int32_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebm_node *cebmub_ofs_lookup_le(int32_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebm_node *cebmub_ofs_lookup_lt(int32_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebm_node *cebmub_ofs_lookup_ge(int32_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebm_node *cebmub_ofs_lookup_gt(int32_t *root, ptrdiff_t kofs, const void *key, size_t len);
+struct cebm_node *cebmub_ofs_next(int32_t *root, ptrdiff_t kofs, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_ofs_prev(int32_t *root, ptrdiff_t kofs, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_ofs_delete(int32_t *root, ptrdiff_t kofs, struct cebm_node *node, size_t len);
+struct cebm_node *cebmub_ofs_pick(int32_t *root, ptrdiff_t kofs, const void *key, size_t len);
+size_t cebmub_ofs_delete_range(int32_t *root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
@@ -0,0 +1,294 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on ulong keys
+ * using the medium relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebu32_*" and one with "cebu32_ofs_*" which takes a key    *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct cebm_node)   *
+ * in the call to the underlying functions.                                  *
+\*****************************************************************************/
+
+/* Inserts node <node> into unique tree <tree> based on its key that
+ * immediately follows the node. Returns the inserted node or the one
+ * that already contains the same key.
+ * NULL is returned if the node is located too far away from the root.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _insert, int32_t *, root, ptrdiff_t, kofs, struct cebm_node *, node)
+{
+	unsigned long key = NODEK(node, kofs)->ul;
+
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_insert((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_insert((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* return the first node or NULL if not found. */
+CEBM_FDECL2(struct cebm_node *, cebmul, _first, int32_t *, root, ptrdiff_t, kofs)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_first((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32);
+	else
+		return (struct cebm_node *)_cebu_first((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64);
+}
+
+/* return the last node or NULL if not found. */
+CEBM_FDECL2(struct cebm_node *, cebmul, _last, int32_t *, root, ptrdiff_t, kofs)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_last((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32);
+	else
+		return (struct cebm_node *)_cebu_last((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEBM_FDECL4(struct cebm_node *, cebmul, _walk, int32_t *, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_walk((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, 0, cb, arg);
+	else
+		return (struct cebm_node *)_cebu_walk((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEBM_FDECL3(void, cebmul, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, int32_t *, root)
+{
+	_cebu_iter_init(iter, (struct ceb_node **)root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEBM_FDECL2(struct cebm_node *, cebmul, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_iter_step(iter, kofs, CEB_AM_M, CEB_KT_U32, 0, 0);
+	else
+		return (struct cebm_node *)_cebu_iter_step(iter, kofs, CEB_AM_M, CEB_KT_U64, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEBM_FDECL2(struct cebm_node *, cebmul, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_iter_step(iter, kofs, CEB_AM_M, CEB_KT_U32, 0, 1);
+	else
+		return (struct cebm_node *)_cebu_iter_step(iter, kofs, CEB_AM_M, CEB_KT_U64, 0, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_iter_seek(iter, kofs, CEB_AM_M, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_iter_seek(iter, kofs, CEB_AM_M, CEB_KT_U64, 0, key, NULL);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEBM_FDECL6(struct cebm_node *, cebmul, _walk_range, int32_t *, root, ptrdiff_t, kofs, unsigned long, lo, unsigned long, hi, ceb_walk_cb, cb, void *, arg)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_walk_range((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, lo, 0, NULL, hi, 0, NULL, cb, arg);
+	else
+		return (struct cebm_node *)_cebu_walk_range((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ */
+CEBM_FDECL4(size_t, cebmul, _count_range, int32_t *, root, ptrdiff_t, kofs, unsigned long, lo, unsigned long, hi)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_count_range((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, lo, 0, NULL, hi, 0, NULL);
+	else
+		return _cebu_count_range((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL);
+}
+
+/* look up the specified key, and returns either the node containing it, or
+ * NULL if not found.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _lookup, int32_t *, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_lookup((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_lookup((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the specified key or the highest below it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _lookup_le, int32_t *, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_lookup_le((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_lookup_le((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up highest key below the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _lookup_lt, int32_t *, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_lookup_lt((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_lookup_lt((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the specified key or the smallest above it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _lookup_ge, int32_t *, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_lookup_ge((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_lookup_ge((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the smallest key above the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _lookup_gt, int32_t *, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_lookup_gt((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_lookup_gt((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a left turn was made, and returning the first node along the right
+ * branch at that fork.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _next, int32_t *, root, ptrdiff_t, kofs, struct cebm_node *, node)
+{
+	unsigned long key = NODEK(node, kofs)->ul;
+
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_next((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_next((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a right turn was made, and returning the last node along the left
+ * branch at that fork.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _prev, int32_t *, root, ptrdiff_t, kofs, struct cebm_node *, node)
+{
+	unsigned long key = NODEK(node, kofs)->ul;
+
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_prev((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_prev((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _delete, int32_t *, root, ptrdiff_t, kofs, struct cebm_node *, node)
+{
+	unsigned long key = NODEK(node, kofs)->ul;
+
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_delete((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_delete((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the specified key, and detaches it and returns it if found, or NULL
+ * if not found.
+ */
+CEBM_FDECL3(struct cebm_node *, cebmul, _pick, int32_t *, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return (struct cebm_node *)_cebu_delete((struct ceb_node **)root, NULL, kofs, CEB_AM_M, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return (struct cebm_node *)_cebu_delete((struct ceb_node **)root, NULL, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Each deleted node is passed to <free_cb> with <arg>
+ * once detached, unless <free_cb> is NULL. The nodes are not passed in any
+ * particular order.
+ */
+CEBM_FDECL6(size_t, cebmul, _delete_range, int32_t *, root, ptrdiff_t, kofs, unsigned long, lo, unsigned long, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_delete_range((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U32, lo, 0, NULL, hi, 0, NULL, free_cb, arg);
+	else
+		return _cebu_delete_range((struct ceb_node **)root, kofs, CEB_AM_M, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL, free_cb, arg);
+}
+
+/* dumps a cebm_node tree using the default functions above. If a node matches
+ * <ctx>, this one will be highlighted in red.
+ */
+CEBM_FDECL4(void, cebmul, _default_dump, int32_t *, root, ptrdiff_t, kofs, const char *, label, const void *, ctx)
+{
+	printf("\ndigraph cebmul_tree {\n"
+	       "  fontname=\"fixed\";\n"
+	       "  fontsize=8\n"
+	       "  label=\"%s\"\n"
+	       "", label);
+
+	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
+	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
+
+	cebu_default_dump_tree(kofs, CEB_AM_M, NULL, sizeof(long) <= 4 ? CEB_KT_U32 : CEB_KT_U64, (struct ceb_node **)root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+
+	printf("}\n");
+}
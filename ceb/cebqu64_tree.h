@@ -0,0 +1,74 @@
+/*
+ * Compact Elastic Binary Trees - exported functions for operations on u64 keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+#include <inttypes.h>
+
+/* simpler version */
+struct cebq_node *cebqu64_insert(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqu64_first(int64_t *root);
+struct cebq_node *cebqu64_last(int64_t *root);
+struct cebq_node *cebqu64_walk(int64_t *root, ceb_walk_cb cb, void *arg);
+void cebqu64_iter_init(struct ceb_iter *iter, int64_t *root);
+struct cebq_node *cebqu64_iter_next(struct ceb_iter *iter);
+struct cebq_node *cebqu64_iter_prev(struct ceb_iter *iter);
+struct cebq_node *cebqu64_iter_seek(struct ceb_iter *iter, uint64_t key);
+struct cebq_node *cebqu64_walk_range(int64_t *root, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebqu64_count_range(int64_t *root, uint64_t lo, uint64_t hi);
+struct cebq_node *cebqu64_lookup(int64_t *root, uint64_t key);
+struct cebq_node *cebqu64_lookup_le(int64_t *root, uint64_t key);
+struct cebq_node *cebqu64_lookup_lt(int64_t *root, uint64_t key);
+struct cebq_node *cebqu64_lookup_ge(int64_t *root, uint64_t key);
+struct cebq_node *cebqu64_lookup_gt(int64_t *root, uint64_t key);
+struct cebq_node *cebqu64_next(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqu64_prev(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqu64_delete(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqu64_pick(int64_t *root, uint64_t key);
+size_t cebqu64_delete_range(int64_t *root, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+void cebqu64_default_dump(int64_t *ceb_root, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebq_node *cebqu64_ofs_insert(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqu64_ofs_first(int64_t *root, ptrdiff_t kofs);
+struct cebq_node *cebqu64_ofs_last(int64_t *root, ptrdiff_t kofs);
+struct cebq_node *cebqu64_ofs_walk(int64_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebqu64_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int64_t *root);
+struct cebq_node *cebqu64_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebq_node *cebqu64_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebq_node *cebqu64_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, uint64_t key);
+struct cebq_node *cebqu64_ofs_walk_range(int64_t *root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebqu64_ofs_count_range(int64_t *root, ptrdiff_t kofs, uint64_t lo, uint64_t hi);
+struct cebq_node *cebqu64_ofs_lookup(int64_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebq_node *cebqu64_ofs_lookup_le(int64_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebq_node *cebqu64_ofs_lookup_lt(int64_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebq_node *cebqu64_ofs_lookup_ge(int64_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebq_node *cebqu64_ofs_lookup_gt(int64_t *root, ptrdiff_t kofs, uint64_t key);
+struct cebq_node *cebqu64_ofs_next(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqu64_ofs_prev(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqu64_ofs_delete(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqu64_ofs_pick(int64_t *root, ptrdiff_t kofs, uint64_t key);
+size_t cebqu64_ofs_delete_range(int64_t *root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+void cebqu64_ofs_default_dump(int64_t *root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -0,0 +1,224 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on mb keys
+ * using the large relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebqub_*" and one with "cebqub_ofs_*" which takes a key    *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct cebq_node)   *
+ * in the call to the underlying functions.                                  *
+\*****************************************************************************/
+
+/* Inserts node <node> into unique tree <tree> based on its key that
+ * immediately follows the node and for <len> bytes. Returns the
+ * inserted node or the one that already contains the same key.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _insert, int64_t *, root, ptrdiff_t, kofs, struct cebq_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebq_node *)_cebu_insert((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* return the first node or NULL if not found. */
+CEBQ_FDECL2(struct cebq_node *, cebqub, _first, int64_t *, root, ptrdiff_t, kofs)
+{
+	return (struct cebq_node *)_cebu_first((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB);
+}
+
+/* return the last node or NULL if not found. */
+CEBQ_FDECL2(struct cebq_node *, cebqub, _last, int64_t *, root, ptrdiff_t, kofs)
+{
+	return (struct cebq_node *)_cebu_last((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB);
+}
+
+/* calls <cb> with <arg> for each node in ascending order of keys of <len>
+ * bytes, visiting each of them once, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes were
+ * visited. <cb> must not modify the tree.
+ */
+CEBQ_FDECL5(struct cebq_node *, cebqub, _walk, int64_t *, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return (struct cebq_node *)_cebu_walk((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, len, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEBQ_FDECL3(void, cebqub, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, int64_t *, root)
+{
+	_cebu_iter_init(iter, (struct ceb_node **)root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. Keys are <len> bytes long. NULL is also returned once the
+ * iterator is stale.
+ */
+CEBQ_FDECL3(struct cebq_node *, cebqub, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs, size_t, len)
+{
+	return (struct cebq_node *)_cebu_iter_step(iter, kofs, CEB_AM_Q, CEB_KT_MB, len, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. Keys are <len> bytes long. NULL is also returned once the
+ * iterator is stale.
+ */
+CEBQ_FDECL3(struct cebq_node *, cebqub, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs, size_t, len)
+{
+	return (struct cebq_node *)_cebu_iter_step(iter, kofs, CEB_AM_Q, CEB_KT_MB, len, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_iter_seek(iter, kofs, CEB_AM_Q, CEB_KT_MB, 0, len, key);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Keys are <len> bytes long. Returns the node the walk stopped
+ * on, or NULL once all nodes in the range were visited. The walk descends
+ * once towards <lo>, then visits the following nodes until the first one
+ * past <hi>. <cb> must not modify the tree.
+ */
+CEBQ_FDECL7(struct cebq_node *, cebqub, _walk_range, int64_t *, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return (struct cebq_node *)_cebu_walk_range((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, lo, 0, len, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ * Keys are <len> bytes long.
+ */
+CEBQ_FDECL5(size_t, cebqub, _count_range, int64_t *, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, size_t, len)
+{
+	return _cebu_count_range((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, lo, 0, len, hi);
+}
+
+/* look up the specified key <key> of length <len>, and returns either the node
+ * containing it, or NULL if not found.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _lookup, int64_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_lookup((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key or the highest below it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _lookup_le, int64_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_lookup_le((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up highest key below the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _lookup_lt, int64_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_lookup_lt((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key or the smallest above it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _lookup_ge, int64_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_lookup_ge((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the smallest key above the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _lookup_gt, int64_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_lookup_gt((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a left turn was made, and returning the first node along the right
+ * branch at that fork. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _next, int64_t *, root, ptrdiff_t, kofs, struct cebq_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebq_node *)_cebu_next((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a right turn was made, and returning the last node along the left
+ * branch at that fork. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _prev, int64_t *, root, ptrdiff_t, kofs, struct cebq_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebq_node *)_cebu_prev((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node. The <len> field must correspond to the key length in
+ * bytes.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _delete, int64_t *, root, ptrdiff_t, kofs, struct cebq_node *, node, size_t, len)
+{
+	const void *key = NODEK(node, kofs)->mb;
+
+	return (struct cebq_node *)_cebu_delete((struct ceb_node **)root, (struct ceb_node *)node, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* look up the specified key, and detaches it and returns it if found, or NULL
+ * if not found. The <len> field must correspond to the key length in bytes.
+ */
+CEBQ_FDECL4(struct cebq_node *, cebqub, _pick, int64_t *, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return (struct cebq_node *)_cebu_delete((struct ceb_node **)root, NULL, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Keys are <len> bytes long. Each deleted node is
+ * passed to <free_cb> with <arg> once detached, unless <free_cb> is NULL.
+ * The nodes are not passed in any particular order.
+ */
+CEBQ_FDECL7(size_t, cebqub, _delete_range, int64_t *, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg, size_t, len)
+{
+	return _cebu_delete_range((struct ceb_node **)root, kofs, CEB_AM_Q, NULL, CEB_KT_MB, 0, len, lo, 0, len, hi, free_cb, arg);
+}
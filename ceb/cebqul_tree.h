@@ -0,0 +1,74 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on ulong keys
+ * using the large relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct cebq_node *cebqul_insert(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqul_first(int64_t *root);
+struct cebq_node *cebqul_last(int64_t *root);
+struct cebq_node *cebqul_walk(int64_t *root, ceb_walk_cb cb, void *arg);
+void cebqul_iter_init(struct ceb_iter *iter, int64_t *root);
+struct cebq_node *cebqul_iter_next(struct ceb_iter *iter);
+struct cebq_node *cebqul_iter_prev(struct ceb_iter *iter);
+struct cebq_node *cebqul_iter_seek(struct ceb_iter *iter, unsigned long key);
+struct cebq_node *cebqul_walk_range(int64_t *root, unsigned long lo, unsigned long hi, ceb_walk_cb cb, void *arg);
+size_t cebqul_count_range(int64_t *root, unsigned long lo, unsigned long hi);
+struct cebq_node *cebqul_lookup(int64_t *root, unsigned long key);
+struct cebq_node *cebqul_lookup_le(int64_t *root, unsigned long key);
+struct cebq_node *cebqul_lookup_lt(int64_t *root, unsigned long key);
+struct cebq_node *cebqul_lookup_ge(int64_t *root, unsigned long key);
+struct cebq_node *cebqul_lookup_gt(int64_t *root, unsigned long key);
+struct cebq_node *cebqul_next(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqul_prev(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqul_delete(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqul_pick(int64_t *root, unsigned long key);
+size_t cebqul_delete_range(int64_t *root, unsigned long lo, unsigned long hi, ceb_free_cb free_cb, void *arg);
+void cebqul_default_dump(int64_t *ceb_root, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebq_node *cebqul_ofs_insert(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqul_ofs_first(int64_t *root, ptrdiff_t kofs);
+struct cebq_node *cebqul_ofs_last(int64_t *root, ptrdiff_t kofs);
+struct cebq_node *cebqul_ofs_walk(int64_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebqul_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int64_t *root);
+struct cebq_node *cebqul_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebq_node *cebqul_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebq_node *cebqul_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, unsigned long key);
+struct cebq_node *cebqul_ofs_walk_range(int64_t *root, ptrdiff_t kofs, unsigned long lo, unsigned long hi, ceb_walk_cb cb, void *arg);
+size_t cebqul_ofs_count_range(int64_t *root, ptrdiff_t kofs, unsigned long lo, unsigned long hi);
+struct cebq_node *cebqul_ofs_lookup(int64_t *root, ptrdiff_t kofs, unsigned long key);
+struct cebq_node *cebqul_ofs_lookup_le(int64_t *root, ptrdiff_t kofs, unsigned long key);
+struct cebq_node *cebqul_ofs_lookup_lt(int64_t *root, ptrdiff_t kofs, unsigned long key);
+struct cebq_node *cebqul_ofs_lookup_ge(int64_t *root, ptrdiff_t kofs, unsigned long key);
+struct cebq_node *cebqul_ofs_lookup_gt(int64_t *root, ptrdiff_t kofs, unsigned long key);
+struct cebq_node *cebqul_ofs_next(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqul_ofs_prev(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqul_ofs_delete(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqul_ofs_pick(int64_t *root, ptrdiff_t kofs, unsigned long key);
+size_t cebqul_ofs_delete_range(int64_t *root, ptrdiff_t kofs, unsigned long lo, unsigned long hi, ceb_free_cb free_cb, void *arg);
+void cebqul_ofs_default_dump(int64_t *root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -0,0 +1,74 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on string keys
+ * using the large relative addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct cebq_node *cebqus_insert(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqus_first(int64_t *root);
+struct cebq_node *cebqus_last(int64_t *root);
+struct cebq_node *cebqus_walk(int64_t *root, ceb_walk_cb cb, void *arg);
+void cebqus_iter_init(struct ceb_iter *iter, int64_t *root);
+struct cebq_node *cebqus_iter_next(struct ceb_iter *iter);
+struct cebq_node *cebqus_iter_prev(struct ceb_iter *iter);
+struct cebq_node *cebqus_iter_seek(struct ceb_iter *iter, const void *key);
+struct cebq_node *cebqus_walk_range(int64_t *root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebqus_count_range(int64_t *root, const void *lo, const void *hi);
+struct cebq_node *cebqus_lookup(int64_t *root, const void *key);
+struct cebq_node *cebqus_lookup_le(int64_t *root, const void *key);
+struct cebq_node *cebqus_lookup_lt(int64_t *root, const void *key);
+struct cebq_node *cebqus_lookup_ge(int64_t *root, const void *key);
+struct cebq_node *cebqus_lookup_gt(int64_t *root, const void *key);
+struct cebq_node *cebqus_next(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqus_prev(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqus_delete(int64_t *root, struct cebq_node *node);
+struct cebq_node *cebqus_pick(int64_t *root, const void *key);
+size_t cebqus_delete_range(int64_t *root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+void cebqus_default_dump(int64_t *root, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebq_node *cebqus_ofs_insert(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqus_ofs_first(int64_t *root, ptrdiff_t kofs);
+struct cebq_node *cebqus_ofs_last(int64_t *root, ptrdiff_t kofs);
+struct cebq_node *cebqus_ofs_walk(int64_t *root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebqus_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, int64_t *root);
+struct cebq_node *cebqus_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebq_node *cebqus_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebq_node *cebqus_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key);
+struct cebq_node *cebqus_ofs_walk_range(int64_t *root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebqus_ofs_count_range(int64_t *root, ptrdiff_t kofs, const void *lo, const void *hi);
+struct cebq_node *cebqus_ofs_lookup(int64_t *root, ptrdiff_t kofs, const void *key);
+struct cebq_node *cebqus_ofs_lookup_le(int64_t *root, ptrdiff_t kofs, const void *key);
+struct cebq_node *cebqus_ofs_lookup_lt(int64_t *root, ptrdiff_t kofs, const void *key);
+struct cebq_node *cebqus_ofs_lookup_ge(int64_t *root, ptrdiff_t kofs, const void *key);
+struct cebq_node *cebqus_ofs_lookup_gt(int64_t *root, ptrdiff_t kofs, const void *key);
+struct cebq_node *cebqus_ofs_next(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqus_ofs_prev(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqus_ofs_delete(int64_t *root, ptrdiff_t kofs, struct cebq_node *node);
+struct cebq_node *cebqus_ofs_pick(int64_t *root, ptrdiff_t kofs, const void *key);
+size_t cebqus_ofs_delete_range(int64_t *root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+void cebqus_ofs_default_dump(int64_t *root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -0,0 +1,205 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on duplicate string keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebs_*" and one with "cebs_ofs_*" which takes a key        *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct ceb_node) in *
+ * the call to the underlying functions.                                     *
+\*****************************************************************************/
+
+/* Inserts node <node> into tree <tree> based on its key that
+ * immediately follows the node. Returns the inserted node, which is
+ * appended after any other one already holding the same key.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _insert, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->str;
+
+	return _ceb_insert(root, node, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* return the first node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebs, _first, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _ceb_first(root, kofs, CEB_KT_ST);
+}
+
+/* return the last node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebs, _last, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _ceb_last(root, kofs, CEB_KT_ST);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebs, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _ceb_walk(root, kofs, CEB_KT_ST, 0, cb, arg);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Duplicates are visited in insertion order. Returns the node the
+ * walk stopped on, or NULL once all nodes in the range were visited. The
+ * walk descends once towards <lo>, then visits the following nodes until
+ * the first one past <hi>. <cb> must not modify the tree.
+ */
+CEB_FDECL6(struct ceb_node *, cebs, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg)
+{
+	return _ceb_walk_range(root, kofs, CEB_KT_ST, 0, 0, lo, 0, 0, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive,
+ * duplicates included.
+ */
+CEB_FDECL4(size_t, cebs, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi)
+{
+	return _ceb_count_range(root, kofs, CEB_KT_ST, 0, 0, lo, 0, 0, hi);
+}
+
+/* look up the specified key, and returns either the first node containing it,
+ * or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
+{
+	return _ceb_lookup(root, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* look up the specified key or the highest below it, and returns either the
+ * last node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
+{
+	return _ceb_lookup_le(root, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* look up highest key below the specified one, and returns either the
+ * last node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
+{
+	return _ceb_lookup_lt(root, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* look up the specified key or the smallest above it, and returns either the
+ * first node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
+{
+	return _ceb_lookup_ge(root, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* look up the smallest key above the specified one, and returns either the
+ * first node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
+{
+	return _ceb_lookup_gt(root, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. Duplicates are visited in insertion order. The approach consists
+ * in looking up that node, recalling the last time a left turn was made, and
+ * returning the first node along the right branch at that fork.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _next, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->str;
+
+	return _ceb_next(root, kofs, CEB_KT_ST, 0, 0, key, node);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found. Duplicates are visited in reverse insertion order. The approach
+ * consists in looking up that node, recalling the last time a right turn was
+ * made, and returning the last node along the left branch at that fork.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _prev, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->str;
+
+	return _ceb_prev(root, kofs, CEB_KT_ST, 0, 0, key, node);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node. Only this exact node is removed, even if other ones
+ * share the same key.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _delete, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->str;
+
+	return _ceb_delete(root, node, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* look up the specified key, and detaches the first node holding it and
+ * returns it if found, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebs, _pick, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
+{
+	return _ceb_delete(root, NULL, kofs, CEB_KT_ST, 0, 0, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive,
+ * duplicates included, and returns their number. Each deleted node is
+ * passed to <free_cb> with <arg> once detached, unless <free_cb> is NULL.
+ * The nodes are not passed in any particular order.
+ */
+CEB_FDECL6(size_t, cebs, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	return _ceb_delete_range(root, kofs, CEB_KT_ST, 0, 0, lo, 0, 0, hi, free_cb, arg);
+}
+
+/* dumps a ceb_node tree using the default functions above. If a node matches
+ * <ctx>, this one will be highlighted in red.
+ */
+CEB_FDECL4(void, cebs, _default_dump, struct ceb_node **, root, ptrdiff_t, kofs, const char *, label, const void *, ctx)
+{
+	printf("\ndigraph cebs_tree {\n"
+	       "  fontname=\"fixed\";\n"
+	       "  fontsize=8\n"
+	       "  label=\"%s\"\n"
+	       "", label);
+
+	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
+	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
+
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, CEB_KT_ST, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+
+	printf("}\n");
+}
@@ -102,16 +102,22 @@
  * Both rely on a forced inline version with a body that immediately follows
  * the declaration, so that the declaration looks like a single decorated
  * function while 2 are built in practice. There are variants for the basic one
- * with 0, 1 and 2 extra arguments after the root. The root and the key offset
+ * with 0 to 6 extra arguments after the root. The root and the key offset
  * are always the first two arguments, and the key offset never appears in the
  * first variant, it's always replaced by sizeof(struct ceb_node) in the calls
- * to the inline version.
+ * to the inline version. The CEBQ_*, CEBM_* and CEBH_* variants do the same for
+ * trees using the large, medium and small relative addressing models, whose
+ * nodes are struct cebq_node, struct cebm_node and struct cebh_node
+ * respectively. The CEBX_* variants are for the index model (struct
+ * cebx_node), whose functions always take the base address right after the
+ * key offset, and thus always have at least one more argument. They all rely
+ * on the _CEB_* ones which take the default key offset first.
  */
-#define CEB_FDECL2(type, pfx, sfx, type1, arg1, type2, arg2)		\
+#define _CEB_FDECL2(dofs, type, pfx, sfx, type1, arg1, type2, arg2)	\
 	static inline __attribute__((always_inline))			\
 	type _##pfx##sfx(type1 arg1, type2 arg2);			\
 	type pfx##sfx(type1 arg1) {					\
-		return _##pfx##sfx(arg1, sizeof(struct ceb_node));	\
+		return _##pfx##sfx(arg1, dofs);				\
 	}								\
 	type pfx##_ofs##sfx(type1 arg1, type2 arg2) {			\
 		return _##pfx##sfx(arg1, arg2);				\
@@ -120,11 +126,11 @@
 	type _##pfx##sfx(type1 arg1, type2 arg2)
 	/* function body follows */
 
-#define CEB_FDECL3(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
+#define _CEB_FDECL3(dofs, type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
 	static inline __attribute__((always_inline))			\
 	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3);		\
 	type pfx##sfx(type1 arg1, type3 arg3) {				\
-		return _##pfx##sfx(arg1, sizeof(struct ceb_node), arg3); \
+		return _##pfx##sfx(arg1, dofs, arg3);			\
 	}								\
 	type pfx##_ofs##sfx(type1 arg1, type2 arg2, type3 arg3) {	\
 		return _##pfx##sfx(arg1, arg2, arg3);			\
@@ -133,11 +139,11 @@
 	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3)
 	/* function body follows */
 
-#define CEB_FDECL4(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
+#define _CEB_FDECL4(dofs, type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
 	static inline __attribute__((always_inline))			\
 	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4); \
 	type pfx##sfx(type1 arg1, type3 arg3, type4 arg4) {		\
-		return _##pfx##sfx(arg1, sizeof(struct ceb_node), arg3, arg4); \
+		return _##pfx##sfx(arg1, dofs, arg3, arg4);		\
 	}								\
 	type pfx##_ofs##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4) { \
 		return _##pfx##sfx(arg1, arg2, arg3, arg4);		\
@@ -146,6 +152,154 @@
 	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4)
 	/* function body follows */
 
+#define _CEB_FDECL5(dofs, type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5); \
+	type pfx##sfx(type1 arg1, type3 arg3, type4 arg4, type5 arg5) {	\
+		return _##pfx##sfx(arg1, dofs, arg3, arg4, arg5);	\
+	}								\
+	type pfx##_ofs##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5) { \
+		return _##pfx##sfx(arg1, arg2, arg3, arg4, arg5);	\
+	}								\
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5)
+	/* function body follows */
+
+#define _CEB_FDECL6(dofs, type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6) \
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6); \
+	type pfx##sfx(type1 arg1, type3 arg3, type4 arg4, type5 arg5, type6 arg6) { \
+		return _##pfx##sfx(arg1, dofs, arg3, arg4, arg5, arg6);	\
+	}								\
+	type pfx##_ofs##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6) { \
+		return _##pfx##sfx(arg1, arg2, arg3, arg4, arg5, arg6);	\
+	}								\
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6)
+	/* function body follows */
+
+#define _CEB_FDECL7(dofs, type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7) \
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7); \
+	type pfx##sfx(type1 arg1, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7) { \
+		return _##pfx##sfx(arg1, dofs, arg3, arg4, arg5, arg6, arg7); \
+	}								\
+	type pfx##_ofs##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7) { \
+		return _##pfx##sfx(arg1, arg2, arg3, arg4, arg5, arg6, arg7); \
+	}								\
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7)
+	/* function body follows */
+
+#define _CEB_FDECL8(dofs, type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7, type8, arg8) \
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, type8 arg8); \
+	type pfx##sfx(type1 arg1, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, type8 arg8) { \
+		return _##pfx##sfx(arg1, dofs, arg3, arg4, arg5, arg6, arg7, arg8); \
+	}								\
+	type pfx##_ofs##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, type8 arg8) { \
+		return _##pfx##sfx(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8); \
+	}								\
+	static inline __attribute__((always_inline))			\
+	type _##pfx##sfx(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, type8 arg8)
+	/* function body follows */
+
+#define CEB_FDECL2(type, pfx, sfx, type1, arg1, type2, arg2)		\
+	_CEB_FDECL2(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2)
+
+#define CEB_FDECL3(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
+	_CEB_FDECL3(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3)
+
+#define CEB_FDECL4(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
+	_CEB_FDECL4(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4)
+
+#define CEB_FDECL5(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
+	_CEB_FDECL5(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5)
+
+#define CEB_FDECL6(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6) \
+	_CEB_FDECL6(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6)
+
+#define CEB_FDECL7(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7) \
+	_CEB_FDECL7(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7)
+
+#define CEB_FDECL8(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7, type8, arg8) \
+	_CEB_FDECL8(sizeof(struct ceb_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7, type8, arg8)
+
+#define CEBQ_FDECL2(type, pfx, sfx, type1, arg1, type2, arg2)		\
+	_CEB_FDECL2(sizeof(struct cebq_node), type, pfx, sfx, type1, arg1, type2, arg2)
+
+#define CEBQ_FDECL3(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
+	_CEB_FDECL3(sizeof(struct cebq_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3)
+
+#define CEBQ_FDECL4(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
+	_CEB_FDECL4(sizeof(struct cebq_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4)
+
+#define CEBQ_FDECL5(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
+	_CEB_FDECL5(sizeof(struct cebq_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5)
+
+#define CEBQ_FDECL6(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6) \
+	_CEB_FDECL6(sizeof(struct cebq_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6)
+
+#define CEBQ_FDECL7(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7) \
+	_CEB_FDECL7(sizeof(struct cebq_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7)
+
+#define CEBM_FDECL2(type, pfx, sfx, type1, arg1, type2, arg2)		\
+	_CEB_FDECL2(sizeof(struct cebm_node), type, pfx, sfx, type1, arg1, type2, arg2)
+
+#define CEBM_FDECL3(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
+	_CEB_FDECL3(sizeof(struct cebm_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3)
+
+#define CEBM_FDECL4(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
+	_CEB_FDECL4(sizeof(struct cebm_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4)
+
+#define CEBM_FDECL5(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
+	_CEB_FDECL5(sizeof(struct cebm_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5)
+
+#define CEBM_FDECL6(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6) \
+	_CEB_FDECL6(sizeof(struct cebm_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6)
+
+#define CEBM_FDECL7(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7) \
+	_CEB_FDECL7(sizeof(struct cebm_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7)
+
+#define CEBH_FDECL2(type, pfx, sfx, type1, arg1, type2, arg2)		\
+	_CEB_FDECL2(sizeof(struct cebh_node), type, pfx, sfx, type1, arg1, type2, arg2)
+
+#define CEBH_FDECL3(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
+	_CEB_FDECL3(sizeof(struct cebh_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3)
+
+#define CEBH_FDECL4(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
+	_CEB_FDECL4(sizeof(struct cebh_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4)
+
+#define CEBH_FDECL5(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
+	_CEB_FDECL5(sizeof(struct cebh_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5)
+
+#define CEBH_FDECL6(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6) \
+	_CEB_FDECL6(sizeof(struct cebh_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6)
+
+#define CEBH_FDECL7(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7) \
+	_CEB_FDECL7(sizeof(struct cebh_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7)
+
+#define CEBX_FDECL2(type, pfx, sfx, type1, arg1, type2, arg2)		\
+	_CEB_FDECL2(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2)
+
+#define CEBX_FDECL3(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3) \
+	_CEB_FDECL3(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3)
+
+#define CEBX_FDECL4(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4) \
+	_CEB_FDECL4(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4)
+
+#define CEBX_FDECL5(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
+	_CEB_FDECL5(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5)
+
+#define CEBX_FDECL6(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6) \
+	_CEB_FDECL6(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6)
+
+#define CEBX_FDECL7(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7) \
+	_CEB_FDECL7(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7)
+
+#define CEBX_FDECL8(type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7, type8, arg8) \
+	_CEB_FDECL8(sizeof(struct cebx_node), type, pfx, sfx, type1, arg1, type2, arg2, type3, arg3, type4, arg4, type5, arg5, type6, arg6, type7, arg7, type8, arg8)
+
 /* tree walk method: key, left, right */
 enum ceb_walk_meth {
 	CEB_WM_FST,     /* look up "first" (walk left only) */
@@ -160,30 +314,382 @@ enum ceb_walk_meth {
 	CEB_WM_KLT,     /* look up the node lower than the key */
 	CEB_WM_KNX,     /* look up the node's key first, then find the next */
 	CEB_WM_KPR,     /* look up the node's key first, then find the prev */
+	CEB_WM_KBR,     /* look up the node equal to the key, or its neighbours */
 };
 
 enum ceb_key_type {
 	CEB_KT_ADDR,    /* the key is the node's address */
 	CEB_KT_U32,     /* 32-bit unsigned word in key_u32 */
 	CEB_KT_U64,     /* 64-bit unsigned word in key_u64 */
+	CEB_KT_I32,     /* 32-bit signed word in key_u32 */
+	CEB_KT_I64,     /* 64-bit signed word in key_u64 */
+	CEB_KT_U16,     /* 16-bit unsigned word in key_u32 */
+	CEB_KT_U8,      /* 8-bit unsigned word in key_u32 */
+	CEB_KT_U128,    /* 128-bit unsigned word as 2 uint64_t (MSW first) in key_ptr */
+	CEB_KT_IU32,    /* 32-bit unsigned word in key_u32, indirect storage */
+	CEB_KT_IU64,    /* 64-bit unsigned word in key_u64, indirect storage */
 	CEB_KT_MB,      /* fixed size memory block in (key_u64,key_ptr), direct storage */
 	CEB_KT_IM,      /* fixed size memory block in (key_u64,key_ptr), indirect storage */
 	CEB_KT_ST,      /* NUL-terminated string in key_ptr, direct storage */
 	CEB_KT_IS,      /* NUL-terminated string in key_ptr, indirect storage */
+	CEB_KT_SI,      /* NUL-terminated case-insensitive string in key_ptr, direct storage */
+	CEB_KT_ISI,     /* NUL-terminated case-insensitive string in key_ptr, indirect storage */
+	CEB_KT_VB,      /* variable size memory block in (key_u64,key_ptr), direct storage after its length */
+	CEB_KT_PB,      /* prefix of key_u64 bits in key_ptr, direct storage after its length */
+	CEB_KT_P32,     /* 32-bit network and prefix length, encoded in key_u64 (see _ceb_p32_enc()) */
 };
 
+/* Note: string keys (ST, IS, SI, ISI) passed in key_ptr are NUL-terminated
+ * when key_u64 is zero. Otherwise they are slices of key_u64 - 1 bytes which
+ * are not necessarily NUL-terminated, and which end either at their first
+ * zero byte or after their last byte.
+ */
+
 union ceb_key_storage {
+	uint8_t  u8;
+	uint16_t u16;
 	uint32_t u32;
 	uint64_t u64;
+	uint64_t u128[2]; /* for CEB_KT_U128, most significant word first */
 	unsigned long ul;
+	size_t sz;        /* for cebuaz, the size of the object starting at the node */
 	unsigned char mb[0];
 	unsigned char str[0];
-	unsigned char *ptr; /* for CEB_KT_IS */
+	unsigned char *ptr; /* for CEB_KT_IS/ISI */
+	struct {
+		uint32_t len;
+		unsigned char data[0];
+	} vb; /* for CEB_KT_VB, the length in bytes followed by the block */
+	struct {
+		uint32_t plen;
+		unsigned char data[0];
+	} pfx; /* for CEB_KT_PB, the prefix length in bits followed by the block */
+	struct {
+		uint32_t net;
+		uint32_t plen;
+	} p32; /* for CEB_KT_P32, the network followed by its prefix length */
 };
 
 /* returns the ceb_key_storage pointer for node <n> and offset <o> */
 #define NODEK(n, o) ((union ceb_key_storage*)(((char *)(n)) + (o)))
 
+/* returns a pointer to the key of type <t> for node <n> and offset <o>. The
+ * union above requires the alignment of its largest members, which the keys of
+ * 32 bits or less don't have once placed right after the 8-byte nodes of the
+ * medium and index models or the 4-byte ones of the small model. These keys
+ * are thus always read through their own type using this macro instead.
+ */
+#define NODEKT(n, o, t) ((t *)(((char *)(n)) + (o)))
+
+/* returns non-zero if keys of type <key_type> are processed as 32-bit words */
+static inline __attribute__((always_inline))
+int _ceb_kt_is32(enum ceb_key_type key_type)
+{
+	return key_type == CEB_KT_U32 || key_type == CEB_KT_I32 ||
+	       key_type == CEB_KT_U16 || key_type == CEB_KT_U8 ||
+	       key_type == CEB_KT_IU32;
+}
+
+/* returns non-zero if keys of type <key_type> are processed as 64-bit words */
+static inline __attribute__((always_inline))
+int _ceb_kt_is64(enum ceb_key_type key_type)
+{
+	return key_type == CEB_KT_U64 || key_type == CEB_KT_I64 ||
+	       key_type == CEB_KT_IU64 || key_type == CEB_KT_P32;
+}
+
+/* returns the 33-bit encoding of the <plen> first bits of 32-bit network
+ * <net>, made of these bits followed by a one and zeroes. This way prefixes
+ * remain distinct from their extensions and are processed as 64-bit words.
+ * <plen> must not be larger than 32.
+ */
+static inline __attribute__((always_inline))
+uint64_t _ceb_p32_enc(uint32_t net, uint32_t plen)
+{
+	return ((((uint64_t)net >> (32 - plen)) << 1) | 1) << (32 - plen);
+}
+
+/* returns the key stored at <k> for key types that are processed as 32-bit
+ * words. Keys are only read on their own size and type so that they may be
+ * packed right after the node (see NODEKT()). Indirect keys are read through
+ * the pointer stored at <k>.
+ */
+static inline __attribute__((always_inline))
+uint32_t _ceb_k32(enum ceb_key_type key_type, const union ceb_key_storage *k)
+{
+	if (key_type == CEB_KT_U16)
+		return *(const uint16_t *)k;
+	else if (key_type == CEB_KT_U8)
+		return *(const uint8_t *)k;
+	else if (key_type == CEB_KT_IU32)
+		return *(const uint32_t *)k->ptr;
+	else
+		return *(const uint32_t *)k;
+}
+
+/* returns the key stored at <k> for key types that are processed as 64-bit
+ * words. Indirect keys are read through the pointer stored at <k>, and 32-bit
+ * prefixes are returned encoded.
+ */
+static inline __attribute__((always_inline))
+uint64_t _ceb_k64(enum ceb_key_type key_type, const union ceb_key_storage *k)
+{
+	if (key_type == CEB_KT_IU64)
+		return *(const uint64_t *)k->ptr;
+	else if (key_type == CEB_KT_P32)
+		return _ceb_p32_enc(k->p32.net, k->p32.plen);
+	else
+		return k->u64;
+}
+
+/* returns the key stored at <k> as a 64-bit word for scalar key types */
+static inline __attribute__((always_inline))
+uint64_t _ceb_kscalar(enum ceb_key_type key_type, const union ceb_key_storage *k)
+{
+	if (_ceb_kt_is32(key_type))
+		return _ceb_k32(key_type, k);
+	return _ceb_k64(key_type, k);
+}
+
+/* compares the 128-bit words <ahi:alo> and <bhi:blo>, and returns <0, 0 or >0
+ * depending on whether <a> is lower than, equal to or greater than <b>.
+ */
+static inline __attribute__((always_inline))
+int _ceb_cmp128(uint64_t ahi, uint64_t alo, uint64_t bhi, uint64_t blo)
+{
+	if (ahi != bhi)
+		return ahi > bhi ? 1 : -1;
+	return (alo > blo) - (alo < blo);
+}
+
+/* returns the position plus one of the highest bit set in 128-bit word
+ * <hi:lo>, or zero if it is null. It is used to report the xor between 128-bit
+ * keys as a 64-bit value which preserves the order between xors.
+ */
+static inline __attribute__((always_inline))
+uint64_t _ceb_fls128(uint64_t hi, uint64_t lo)
+{
+	return hi ? 64 + flsnz64(hi) : lo ? flsnz64(lo) : 0;
+}
+
+/* returns the number of equal bits between strings <a> and <b> after <ignore>
+ * bits, ignoring ASCII case for case-insensitive key types. String <a> may be
+ * a slice, in which case <alen> holds its length plus one (see key_u64 for
+ * string keys), otherwise <alen> is zero.
+ */
+static inline __attribute__((always_inline))
+size_t _ceb_str_equal_bits(enum ceb_key_type key_type, const unsigned char *a, uint64_t alen, const unsigned char *b, size_t ignore)
+{
+	if (key_type == CEB_KT_SI || key_type == CEB_KT_ISI) {
+		if (alen)
+			return slice_equal_bits_ci(a, alen - 1, b, ignore);
+		return string_equal_bits_ci(a, b, ignore);
+	}
+	if (alen)
+		return slice_equal_bits(a, alen - 1, b, ignore);
+	return string_equal_bits(a, b, ignore);
+}
+
+/* compares strings <a> and <b> like strcmp(), starting at offset <ofs>, and
+ * ignoring ASCII case for case-insensitive key types. String <a> may be a
+ * slice, in which case <alen> holds its length plus one, otherwise zero.
+ */
+static inline __attribute__((always_inline))
+int _ceb_strcmp(enum ceb_key_type key_type, const void *a, uint64_t alen, const void *b, size_t ofs)
+{
+	int ci = (key_type == CEB_KT_SI || key_type == CEB_KT_ISI);
+
+	if (alen)
+		return slice_cmp(a + ofs, alen - 1 - ofs, b + ofs, ci);
+	if (ci)
+		return string_cmp_ci(a + ofs, b + ofs);
+	return strcmp(a + ofs, b + ofs);
+}
+
+/* Node addressing models. The generic code always manipulates nodes as
+ * struct ceb_node pointers and locations of branches as struct ceb_node **,
+ * but only the absolute model really stores pointers there. The other models
+ * store the distance between the branch's own location and the node it
+ * designates, expressed in units of the branch's size for models whose
+ * branches are smaller than a pointer, plus one so that a zero value still
+ * designates NULL (e.g. an empty root or a deleted node). The index model
+ * instead stores the position of the node relative to a base address passed by
+ * the caller along with the root (e.g. an array that may be reallocated), in
+ * units of the branch's size, plus one. Branches must only be accessed using
+ * the functions below, which the compiler reduces to plain pointer accesses for
+ * the absolute model.
+ *
+ * Note that a zero is not always NULL: in the medium and small models, a
+ * node's right branch is located exactly one unit after the node, so that it
+ * also stores zero when it points to its own node, i.e. when the node is its
+ * own right leaf. Thus only roots and left branches (b[0]) may be tested for
+ * NULL using _ceb_ld(), and the branches of nodes that are part of a tree must
+ * always be read using _ceb_ldb() or _ceb_getb().
+ */
+enum ceb_addr_mode {
+	CEB_AM_ABS,     /* absolute pointers (struct ceb_node) */
+	CEB_AM_Q,       /* large: 64-bit self-relative branches (struct cebq_node) */
+	CEB_AM_M,       /* medium: 32-bit self-relative branches (struct cebm_node) */
+	CEB_AM_H,       /* small: 16-bit self-relative branches (struct cebh_node) */
+	CEB_AM_X,       /* index: 32-bit base-relative branches (struct cebx_node) */
+};
+
+/* returns the location of branch <side> of node <node> in model <am> */
+static inline __attribute__((always_inline))
+struct ceb_node **_ceb_br(enum ceb_addr_mode am, const struct ceb_node *node, int side)
+{
+	if (am == CEB_AM_Q)
+		return (struct ceb_node **)&((struct cebq_node *)node)->b[side];
+	if (am == CEB_AM_M)
+		return (struct ceb_node **)&((struct cebm_node *)node)->b[side];
+	if (am == CEB_AM_H)
+		return (struct ceb_node **)&((struct cebh_node *)node)->b[side];
+	if (am == CEB_AM_X)
+		return (struct ceb_node **)&((struct cebx_node *)node)->b[side];
+	return (struct ceb_node **)&node->b[side];
+}
+
+/* returns the number of bytes a relative distance unit covers in model <am> */
+static inline __attribute__((always_inline))
+ptrdiff_t _ceb_unit(enum ceb_addr_mode am)
+{
+	if (am == CEB_AM_M || am == CEB_AM_X)
+		return sizeof(int32_t);
+	if (am == CEB_AM_H)
+		return sizeof(int16_t);
+	return 1;
+}
+
+/* returns the raw value of the relative branch located at <slot> */
+static inline __attribute__((always_inline))
+int64_t _ceb_rdrel(enum ceb_addr_mode am, struct ceb_node *const *slot)
+{
+	if (am == CEB_AM_M)
+		return *(const int32_t *)slot;
+	if (am == CEB_AM_H)
+		return *(const int16_t *)slot;
+	if (am == CEB_AM_X)
+		return *(const uint32_t *)slot;
+	return *(const int64_t *)slot;
+}
+
+/* sets the raw value of the relative branch located at <slot> to <v> */
+static inline __attribute__((always_inline))
+void _ceb_wrrel(enum ceb_addr_mode am, struct ceb_node **slot, int64_t v)
+{
+	if (am == CEB_AM_M)
+		*(int32_t *)slot = v;
+	else if (am == CEB_AM_H)
+		*(int16_t *)slot = v;
+	else if (am == CEB_AM_X)
+		*(uint32_t *)slot = v;
+	else
+		*(int64_t *)slot = v;
+}
+
+/* returns the address relative branch values located at <slot> are counted
+ * from, which is the branch itself except for the index model.
+ */
+static inline __attribute__((always_inline))
+char *_ceb_org(enum ceb_addr_mode am, const void *base, struct ceb_node *const *slot)
+{
+	if (am == CEB_AM_X)
+		return (char *)base;
+	return (char *)slot;
+}
+
+/* returns the relative branch value designating <node> from <slot> */
+static inline __attribute__((always_inline))
+int64_t _ceb_rel(enum ceb_addr_mode am, const void *base, struct ceb_node *const *slot, const struct ceb_node *node)
+{
+	return ((const char *)node - _ceb_org(am, base, slot)) / _ceb_unit(am) + 1;
+}
+
+/* returns the node designated by the branch located at <slot> in model <am>,
+ * or NULL if the branch is empty (root of an empty tree or deleted node). It
+ * must only be used on roots and left branches, see above.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_ld(enum ceb_addr_mode am, const void *base, struct ceb_node *const *slot)
+{
+	if (am != CEB_AM_ABS) {
+		int64_t v = _ceb_rdrel(am, slot);
+
+		return v ? (struct ceb_node *)(_ceb_org(am, base, slot) + (v - 1) * _ceb_unit(am)) : NULL;
+	}
+	return *slot;
+}
+
+/* same as _ceb_ld() but for branches known not to be empty, which is always
+ * the case for the branches of nodes that are part of a non-empty tree.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_ldb(enum ceb_addr_mode am, const void *base, struct ceb_node *const *slot)
+{
+	if (am != CEB_AM_ABS)
+		return (struct ceb_node *)(_ceb_org(am, base, slot) + (_ceb_rdrel(am, slot) - 1) * _ceb_unit(am));
+	return *slot;
+}
+
+/* makes the branch located at <slot> designate node <node>, which may be NULL */
+static inline __attribute__((always_inline))
+void _ceb_st(enum ceb_addr_mode am, const void *base, struct ceb_node **slot, const struct ceb_node *node)
+{
+	if (am != CEB_AM_ABS)
+		_ceb_wrrel(am, slot, node ? _ceb_rel(am, base, slot, node) : 0);
+	else
+		*slot = (struct ceb_node *)node;
+}
+
+/* returns the node designated by branch <side> of node <node> */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_getb(enum ceb_addr_mode am, const void *base, const struct ceb_node *node, int side)
+{
+	return _ceb_ldb(am, base, _ceb_br(am, node, side));
+}
+
+/* makes branch <side> of node <node> designate node <target> */
+static inline __attribute__((always_inline))
+void _ceb_setb(enum ceb_addr_mode am, const void *base, struct ceb_node *node, int side, const struct ceb_node *target)
+{
+	struct ceb_node **slot = _ceb_br(am, node, side);
+
+	if (am != CEB_AM_ABS)
+		_ceb_wrrel(am, slot, _ceb_rel(am, base, slot, target));
+	else
+		*slot = (struct ceb_node *)target;
+}
+
+/* Returns non-zero if node <node> may be attached to the tree whose root is
+ * at <root> in model <am>. Models with short branches can only reach a
+ * limited window around the root: for the medium model, nodes must be located
+ * less than 2 GB away from the root in either direction, which guarantees that
+ * any two nodes are less than 4 GB apart and remain reachable from each other
+ * using 4-byte units. For the small model, nodes must entirely fit in the 64 kB
+ * following the root, so that they remain reachable using 2-byte units. For the
+ * index model, nodes must be located after the base, at less than 16 GB.
+ */
+static inline __attribute__((always_inline))
+int _ceb_inwin(enum ceb_addr_mode am, const void *base, struct ceb_node *const *root, const struct ceb_node *node)
+{
+	if (am == CEB_AM_M) {
+		int64_t d = (const char *)node - (const char *)root;
+
+		return d > -(int64_t)0x80000000 && d < (int64_t)0x80000000;
+	}
+	if (am == CEB_AM_H) {
+		ptrdiff_t d = (const char *)node - (const char *)root;
+
+		return d >= 0 && d <= 65536 - (ptrdiff_t)sizeof(struct cebh_node);
+	}
+	if (am == CEB_AM_X) {
+		int64_t d = (const char *)node - (const char *)base;
+
+		return d >= 0 && d / (int64_t)sizeof(uint32_t) < (int64_t)0xffffffff;
+	}
+	return 1;
+}
+
 /* Returns the xor (or common length) between the two sides <l> and <r> if both
  * are non-null, otherwise between the first non-null one and the value in the
  * associate key. As a reminder, memory blocks place their length in key_u64.
@@ -198,19 +704,32 @@ static inline uint64_t _xor_branches(ptrdiff_t kofs, enum ceb_key_type key_type,
                                      const struct ceb_node *l,
                                      const struct ceb_node *r)
 {
+	/* pointers to lists of duplicates may be tagged */
+	l = __ceb_clrtag(l);
+	r = __ceb_clrtag(r);
+
 	if (l && r) {
 		if (key_type == CEB_KT_MB)
 			return equal_bits(NODEK(l, kofs)->mb, NODEK(r, kofs)->mb, 0, key_u64 << 3);
 		else if (key_type == CEB_KT_IM)
 			return equal_bits(NODEK(l, kofs)->mb, NODEK(r, kofs)->ptr, 0, key_u64 << 3);
-		else if (key_type == CEB_KT_ST)
-			return string_equal_bits(NODEK(l, kofs)->str, NODEK(r, kofs)->str, 0);
-		else if (key_type == CEB_KT_IS)
-			return string_equal_bits(NODEK(l, kofs)->ptr, NODEK(r, kofs)->ptr, 0);
-		else if (key_type == CEB_KT_U64)
-			return NODEK(l, kofs)->u64 ^ NODEK(r, kofs)->u64;
-		else if (key_type == CEB_KT_U32)
-			return NODEK(l, kofs)->u32 ^ NODEK(r, kofs)->u32;
+		else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI)
+			return _ceb_str_equal_bits(key_type, NODEK(l, kofs)->str, 0, NODEK(r, kofs)->str, 0);
+		else if (key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+			return _ceb_str_equal_bits(key_type, NODEK(l, kofs)->ptr, 0, NODEK(r, kofs)->ptr, 0);
+		else if (key_type == CEB_KT_VB)
+			return vblock_equal_bits(NODEK(l, kofs)->vb.data, NODEK(l, kofs)->vb.len,
+						 NODEK(r, kofs)->vb.data, NODEK(r, kofs)->vb.len, 0);
+		else if (key_type == CEB_KT_PB)
+			return prefix_equal_bits(NODEK(l, kofs)->pfx.data, NODEK(l, kofs)->pfx.plen,
+						 NODEK(r, kofs)->pfx.data, NODEK(r, kofs)->pfx.plen);
+		else if (_ceb_kt_is64(key_type))
+			return _ceb_k64(key_type, NODEK(l, kofs)) ^ _ceb_k64(key_type, NODEK(r, kofs));
+		else if (_ceb_kt_is32(key_type))
+			return _ceb_k32(key_type, NODEK(l, kofs)) ^ _ceb_k32(key_type, NODEK(r, kofs));
+		else if (key_type == CEB_KT_U128)
+			return _ceb_fls128(NODEK(l, kofs)->u128[0] ^ NODEK(r, kofs)->u128[0],
+					   NODEK(l, kofs)->u128[1] ^ NODEK(r, kofs)->u128[1]);
 		else if (key_type == CEB_KT_ADDR)
 			return ((uintptr_t)l ^ (uintptr_t)r);
 		else
@@ -224,16 +743,23 @@ static inline uint64_t _xor_branches(ptrdiff_t kofs, enum ceb_key_type key_type,
 		return equal_bits(key_ptr, NODEK(l, kofs)->mb, 0, key_u64 << 3);
 	else if (key_type == CEB_KT_IM)
 		return equal_bits(key_ptr, NODEK(l, kofs)->ptr, 0, key_u64 << 3);
-	else if (key_type == CEB_KT_ST)
-		return string_equal_bits(key_ptr, NODEK(l, kofs)->str, 0);
-	else if (key_type == CEB_KT_IS)
-		return string_equal_bits(key_ptr, NODEK(l, kofs)->ptr, 0);
-	else if (key_type == CEB_KT_U64)
-		return key_u64 ^ NODEK(l, kofs)->u64;
-	else if (key_type == CEB_KT_U32)
-		return key_u32 ^ NODEK(l, kofs)->u32;
+	else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI)
+		return _ceb_str_equal_bits(key_type, key_ptr, key_u64, NODEK(l, kofs)->str, 0);
+	else if (key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+		return _ceb_str_equal_bits(key_type, key_ptr, key_u64, NODEK(l, kofs)->ptr, 0);
+	else if (key_type == CEB_KT_VB)
+		return vblock_equal_bits(key_ptr, key_u64, NODEK(l, kofs)->vb.data, NODEK(l, kofs)->vb.len, 0);
+	else if (key_type == CEB_KT_PB)
+		return prefix_equal_bits(key_ptr, key_u64, NODEK(l, kofs)->pfx.data, NODEK(l, kofs)->pfx.plen);
+	else if (_ceb_kt_is64(key_type))
+		return key_u64 ^ _ceb_k64(key_type, NODEK(l, kofs));
+	else if (_ceb_kt_is32(key_type))
+		return key_u32 ^ _ceb_k32(key_type, NODEK(l, kofs));
+	else if (key_type == CEB_KT_U128)
+		return key_ptr ? _ceb_fls128(((const uint64_t *)key_ptr)[0] ^ NODEK(l, kofs)->u128[0],
+					     ((const uint64_t *)key_ptr)[1] ^ NODEK(l, kofs)->u128[1]) : 0;
 	else if (key_type == CEB_KT_ADDR)
-		return ((uintptr_t)key_ptr ^ (uintptr_t)r);
+		return ((uintptr_t)key_ptr ^ (uintptr_t)l);
 	else
 		return 0;
 }
@@ -244,6 +770,8 @@ static void dbg(int line,
                 const char *pfx,
                 enum ceb_walk_meth meth,
                 ptrdiff_t kofs,
+                enum ceb_addr_mode am,
+                const void *base,
                 enum ceb_key_type key_type,
                 struct ceb_node * const *root,
                 const struct ceb_node *p,
@@ -266,15 +794,28 @@ static void dbg(int line,
 		[CEB_WM_KLT] = "KLT",
 		[CEB_WM_KNX] = "KNX",
 		[CEB_WM_KPR] = "KPR",
+		[CEB_WM_KBR] = "KBR",
 	};
 	const char *ktypes[] = {
 		[CEB_KT_ADDR] = "ADDR",
 		[CEB_KT_U32]  = "U32",
 		[CEB_KT_U64]  = "U64",
+		[CEB_KT_I32]  = "I32",
+		[CEB_KT_I64]  = "I64",
+		[CEB_KT_U16]  = "U16",
+		[CEB_KT_U8]   = "U8",
+		[CEB_KT_U128] = "U128",
+		[CEB_KT_IU32] = "IU32",
+		[CEB_KT_IU64] = "IU64",
 		[CEB_KT_MB]   = "MB",
 		[CEB_KT_IM]   = "IM",
 		[CEB_KT_ST]   = "ST",
 		[CEB_KT_IS]   = "IS",
+		[CEB_KT_SI]   = "SI",
+		[CEB_KT_ISI]  = "ISI",
+		[CEB_KT_VB]   = "VB",
+		[CEB_KT_PB]   = "PB",
+		[CEB_KT_P32]  = "P32",
 	};
 	const char *kstr __attribute__((unused)) = ktypes[key_type];
 	const char *mstr __attribute__((unused)) = meths[meth];
@@ -286,62 +827,102 @@ static void dbg(int line,
 	if (p)
 		nlen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, p, NULL);
 
-	if (p && p->b[0])
-		llen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, p->b[0], NULL);
+	if (p && _ceb_getb(am, base, p, 0))
+		llen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, _ceb_getb(am, base, p, 0), NULL);
 
-	if (p && p->b[1])
-		rlen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, NULL, p->b[1]);
+	if (p && _ceb_getb(am, base, p, 1))
+		rlen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, NULL, _ceb_getb(am, base, p, 1));
 
-	if (p && p->b[0] && p->b[1])
-		xlen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, p->b[0], p->b[1]);
+	if (p && _ceb_getb(am, base, p, 0) && _ceb_getb(am, base, p, 1))
+		xlen = _xor_branches(kofs, key_type, key_u32, key_u64, key_ptr, _ceb_getb(am, base, p, 0), _ceb_getb(am, base, p, 1));
 
 	switch (key_type) {
 	case CEB_KT_U32:
+	case CEB_KT_I32:
+	case CEB_KT_U16:
+	case CEB_KT_U8:
+	case CEB_KT_IU32:
 		CEBDBG("%04d (%8s) m=%s.%s key=%#x root=%p pxor=%#x p=%p,%#x(^%#llx) l=%p,%#x(^%#llx) r=%p,%#x(^%#llx) l^r=%#llx\n",
 		      line, pfx, kstr, mstr, key_u32, root, px32,
-		      p, p ? NODEK(p, kofs)->u32 : 0, nlen,
-		      p ? p->b[0] : NULL, p ? NODEK(p->b[0], kofs)->u32 : 0, llen,
-		      p ? p->b[1] : NULL, p ? NODEK(p->b[1], kofs)->u32 : 0, rlen,
+		      p, p ? _ceb_k32(key_type, NODEK(p, kofs)) : 0, nlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? _ceb_k32(key_type, NODEK(_ceb_getb(am, base, p, 0), kofs)) : 0, llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? _ceb_k32(key_type, NODEK(_ceb_getb(am, base, p, 1), kofs)) : 0, rlen,
 		      xlen);
 		break;
 	case CEB_KT_U64:
+	case CEB_KT_I64:
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
 		CEBDBG("%04d (%8s) m=%s.%s key=%#llx root=%p pxor=%#llx p=%p,%#llx(^%#llx) l=%p,%#llx(^%#llx) r=%p,%#llx(^%#llx) l^r=%#llx\n",
 		      line, pfx, kstr, mstr, (long long)key_u64, root, (long long)px64,
-		      p, (long long)(p ? NODEK(p, kofs)->u64 : 0), nlen,
-		      p ? p->b[0] : NULL, (long long)(p ? NODEK(p->b[0], kofs)->u64 : 0), llen,
-		      p ? p->b[1] : NULL, (long long)(p ? NODEK(p->b[1], kofs)->u64 : 0), rlen,
+		      p, (long long)(p ? _ceb_k64(key_type, NODEK(p, kofs)) : 0), nlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, (long long)(p ? _ceb_k64(key_type, NODEK(_ceb_getb(am, base, p, 0), kofs)) : 0), llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, (long long)(p ? _ceb_k64(key_type, NODEK(_ceb_getb(am, base, p, 1), kofs)) : 0), rlen,
+		      xlen);
+		break;
+	case CEB_KT_U128:
+		/* xors are reported as the highest differing bit plus one */
+		CEBDBG("%04d (%8s) m=%s.%s key=%#llx:%016llx root=%p pxor=%#llx p=%p,%#llx:%016llx(^%lld) l=%p,%#llx:%016llx(^%lld) r=%p,%#llx:%016llx(^%lld) l^r=%lld\n",
+		      line, pfx, kstr, mstr,
+		      (long long)(key_ptr ? ((const uint64_t *)key_ptr)[0] : 0), (long long)(key_ptr ? ((const uint64_t *)key_ptr)[1] : 0),
+		      root, (long long)px64,
+		      p, (long long)(p ? NODEK(p, kofs)->u128[0] : 0), (long long)(p ? NODEK(p, kofs)->u128[1] : 0), nlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL,
+		      (long long)(p ? NODEK(_ceb_getb(am, base, p, 0), kofs)->u128[0] : 0),
+		      (long long)(p ? NODEK(_ceb_getb(am, base, p, 0), kofs)->u128[1] : 0), llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL,
+		      (long long)(p ? NODEK(_ceb_getb(am, base, p, 1), kofs)->u128[0] : 0),
+		      (long long)(p ? NODEK(_ceb_getb(am, base, p, 1), kofs)->u128[1] : 0), rlen,
 		      xlen);
 		break;
 	case CEB_KT_MB:
 		CEBDBG("%04d (%8s) m=%s.%s key=%p root=%p plen=%ld p=%p,%p(^%llu) l=%p,%p(^%llu) r=%p,%p(^%llu) l^r=%llu\n",
 		      line, pfx, kstr, mstr, key_ptr, root, (long)plen,
 		      p, p ? NODEK(p, kofs)->mb : 0, nlen,
-		      p ? p->b[0] : NULL, p ? NODEK(p->b[0], kofs)->mb : 0, llen,
-		      p ? p->b[1] : NULL, p ? NODEK(p->b[1], kofs)->mb : 0, rlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? NODEK(_ceb_getb(am, base, p, 0), kofs)->mb : 0, llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? NODEK(_ceb_getb(am, base, p, 1), kofs)->mb : 0, rlen,
 		      xlen);
 		break;
 	case CEB_KT_IM:
 		CEBDBG("%04d (%8s) m=%s.%s key=%p root=%p plen=%ld p=%p,%p(^%llu) l=%p,%p(^%llu) r=%p,%p(^%llu) l^r=%llu\n",
 		      line, pfx, kstr, mstr, key_ptr, root, (long)plen,
 		      p, p ? NODEK(p, kofs)->ptr : 0, nlen,
-		      p ? p->b[0] : NULL, p ? NODEK(p->b[0], kofs)->ptr : 0, llen,
-		      p ? p->b[1] : NULL, p ? NODEK(p->b[1], kofs)->ptr : 0, rlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? NODEK(_ceb_getb(am, base, p, 0), kofs)->ptr : 0, llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? NODEK(_ceb_getb(am, base, p, 1), kofs)->ptr : 0, rlen,
 		      xlen);
 		break;
 	case CEB_KT_ST:
-		CEBDBG("%04d (%8s) m=%s.%s key='%s' root=%p plen=%ld p=%p,%s(^%llu) l=%p,%s(^%llu) r=%p,%s(^%llu) l^r=%llu\n",
-		      line, pfx, kstr, mstr, key_ptr ? (const char *)key_ptr : "", root, (long)plen,
+	case CEB_KT_SI:
+		CEBDBG("%04d (%8s) m=%s.%s key='%.*s' root=%p plen=%ld p=%p,%s(^%llu) l=%p,%s(^%llu) r=%p,%s(^%llu) l^r=%llu\n",
+		      line, pfx, kstr, mstr, key_u64 ? (int)key_u64 - 1 : (int)(~0U >> 1), key_ptr ? (const char *)key_ptr : "", root, (long)plen,
 		      p, p ? (const char *)NODEK(p, kofs)->str : "-", nlen,
-		      p ? p->b[0] : NULL, p ? (const char *)NODEK(p->b[0], kofs)->str : "-", llen,
-		      p ? p->b[1] : NULL, p ? (const char *)NODEK(p->b[1], kofs)->str : "-", rlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? (const char *)NODEK(_ceb_getb(am, base, p, 0), kofs)->str : "-", llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? (const char *)NODEK(_ceb_getb(am, base, p, 1), kofs)->str : "-", rlen,
 		      xlen);
 		break;
 	case CEB_KT_IS:
-		CEBDBG("%04d (%8s) m=%s.%s key='%s' root=%p plen=%ld p=%p,%s(^%llu) l=%p,%s(^%llu) r=%p,%s(^%llu) l^r=%llu\n",
-		      line, pfx, kstr, mstr, key_ptr ? (const char *)key_ptr : "", root, (long)plen,
+	case CEB_KT_ISI:
+		CEBDBG("%04d (%8s) m=%s.%s key='%.*s' root=%p plen=%ld p=%p,%s(^%llu) l=%p,%s(^%llu) r=%p,%s(^%llu) l^r=%llu\n",
+		      line, pfx, kstr, mstr, key_u64 ? (int)key_u64 - 1 : (int)(~0U >> 1), key_ptr ? (const char *)key_ptr : "", root, (long)plen,
 		      p, p ? (const char *)NODEK(p, kofs)->ptr : "-", nlen,
-		      p ? p->b[0] : NULL, p ? (const char *)NODEK(p->b[0], kofs)->ptr : "-", llen,
-		      p ? p->b[1] : NULL, p ? (const char *)NODEK(p->b[1], kofs)->ptr : "-", rlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? (const char *)NODEK(_ceb_getb(am, base, p, 0), kofs)->ptr : "-", llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? (const char *)NODEK(_ceb_getb(am, base, p, 1), kofs)->ptr : "-", rlen,
+		      xlen);
+		break;
+	case CEB_KT_VB:
+		CEBDBG("%04d (%8s) m=%s.%s key=%p len=%llu root=%p plen=%ld p=%p,%p(^%llu) l=%p,%p(^%llu) r=%p,%p(^%llu) l^r=%llu\n",
+		      line, pfx, kstr, mstr, key_ptr, (unsigned long long)key_u64, root, (long)plen,
+		      p, p ? NODEK(p, kofs)->vb.data : 0, nlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? NODEK(_ceb_getb(am, base, p, 0), kofs)->vb.data : 0, llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? NODEK(_ceb_getb(am, base, p, 1), kofs)->vb.data : 0, rlen,
+		      xlen);
+		break;
+	case CEB_KT_PB:
+		CEBDBG("%04d (%8s) m=%s.%s key=%p plen=%llu root=%p plen=%ld p=%p,%p(^%llu) l=%p,%p(^%llu) r=%p,%p(^%llu) l^r=%llu\n",
+		      line, pfx, kstr, mstr, key_ptr, (unsigned long long)key_u64, root, (long)plen,
+		      p, p ? NODEK(p, kofs)->pfx.data : 0, nlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? NODEK(_ceb_getb(am, base, p, 0), kofs)->pfx.data : 0, llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? NODEK(_ceb_getb(am, base, p, 1), kofs)->pfx.data : 0, rlen,
 		      xlen);
 		break;
 	case CEB_KT_ADDR:
@@ -349,8 +930,8 @@ static void dbg(int line,
 		CEBDBG("%04d (%8s) m=%s.%s key=%#llx root=%p pxor=%#llx p=%p,%#llx(^%#llx) l=%p,%#llx(^%#llx) r=%p,%#llx(^%#llx) l^r=%#llx\n",
 		      line, pfx, kstr, mstr, (long long)(uintptr_t)key_ptr, root, (long long)px64,
 		      p, (long long)(uintptr_t)p, nlen,
-		      p ? p->b[0] : NULL, p ? (long long)(uintptr_t)p->b[0] : 0, llen,
-		      p ? p->b[1] : NULL, p ? (long long)(uintptr_t)p->b[1] : 0, rlen,
+		      p ? _ceb_getb(am, base, p, 0) : NULL, p ? (long long)(uintptr_t)_ceb_getb(am, base, p, 0) : 0, llen,
+		      p ? _ceb_getb(am, base, p, 1) : NULL, p ? (long long)(uintptr_t)_ceb_getb(am, base, p, 1) : 0, rlen,
 		      xlen);
 	}
 }
@@ -368,12 +949,31 @@ static void dbg(int line,
  * its own node, with the sibling being *ret_root. Note that keys for fixed-
  * size arrays are passed in key_ptr with their length in key_u64. For keyless
  * nodes whose address serves as the key, the pointer needs to be passed in
- * key_ptr, and pxor64 will be used internally.
+ * key_ptr, and pxor64 will be used internally. Trees supporting duplicates
+ * must pass a non-null <ret_is_dup>, in which case tagged leaf pointers are
+ * recognized as lists of duplicates (see _ceb_insert()), and the integer will
+ * be set to non-zero when the returned leaf is such a list. In this case, the
+ * returned node is the first of the list for forward walks and key lookups
+ * (FST, NXT, KEQ, KGE, KGT, KNX), and the last one for backwards walks (LST,
+ * PRV, KLE, KLT, KPR), while *ret_root points to the tagged pointer. For
+ * walks which may need to continue on a neighbour branch (KNX, KPR and range
+ * lookups), ret_back returns the location of the branch designating the last
+ * node where the other side could have been taken, so that the caller may
+ * restart a NXT/PRV descent from there. Bracket lookups (KBR) need both
+ * neighbours, so ret_back must then point to two locations receiving the
+ * restart points for a PRV and a NXT descent respectively. For them, *ret_root
+ * is NULL when the key is found (and returned). Otherwise it designates where
+ * the key would be, which is either a leaf that is returned, or a subtree
+ * entirely located on the side of the key indicated by *ret_nside, in which
+ * case NULL is returned. <am> indicates how nodes reference each other (see
+ * enum ceb_addr_mode).
  */
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_descend(struct ceb_node **root,
                                enum ceb_walk_meth meth,
                                ptrdiff_t kofs,
+                               enum ceb_addr_mode am,
+                               const void *base,
                                enum ceb_key_type key_type,
                                uint32_t key_u32,
                                uint64_t key_u64,
@@ -386,16 +986,20 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
                                int *ret_npside,
                                struct ceb_node **ret_gparent,
                                int *ret_gpside,
-                               struct ceb_node **ret_back)
+                               struct ceb_node ***ret_back,
+                               int *ret_is_dup)
 {
 	struct ceb_node *p;
+	struct ceb_node *lb, *rb;
 	union ceb_key_storage *l, *r, *k;
 	struct ceb_node *gparent = NULL;
 	struct ceb_node *nparent = NULL;
-	struct ceb_node *bnode = NULL;
+	struct ceb_node **bnode = NULL;
+	struct ceb_node **pnode = NULL; // PRV restart point for KBR
 	struct ceb_node *lparent;
 	uint32_t pxor32 = ~0U;   // previous xor between branches
 	uint64_t pxor64 = ~0ULL; // previous xor between branches
+	uint64_t pxorlo = ~0ULL; // previous xor's lower word for 128-bit keys
 	int gpside = 0;   // side on the grand parent
 	int npside = 0;   // side on the node's parent
 	long lpside = 0;  // side on the leaf's parent
@@ -404,8 +1008,23 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 	size_t rlen = 0;  // right vs key matching length
 	size_t plen = 0;  // previous common len between branches
 	int found = 0;    // key was found (saves an extra strcmp for arrays)
+	int is_dup = 0;   // reached a list of duplicates
+	int miss = 0;     // stopped above a subtree not containing the key
+	int nside = 0;    // side of the key relative to the last visited one
+	/* signed keys have their sign bit flipped on both sides of comparisons,
+	 * which doesn't affect xors but turns the signed order into the unsigned
+	 * one. These are constants so there's no cost for unsigned keys.
+	 */
+	const uint32_t sgn32 = (key_type == CEB_KT_I32) ? 0x80000000U : 0;
+	const uint64_t sgn64 = (key_type == CEB_KT_I64) ? 0x8000000000000000ULL : 0;
+	/* 128-bit keys are passed by pointer and only exist for key lookups */
+	const uint64_t key_hi = (key_type == CEB_KT_U128 && meth >= CEB_WM_KEQ) ? ((const uint64_t *)key_ptr)[0] : 0;
+	const uint64_t key_lo = (key_type == CEB_KT_U128 && meth >= CEB_WM_KEQ) ? ((const uint64_t *)key_ptr)[1] : 0;
+
+	key_u32 ^= sgn32;
+	key_u64 ^= sgn64;
 
-	dbg(__LINE__, "_enter__", meth, kofs, key_type, root, NULL, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+	dbg(__LINE__, "_enter__", meth, kofs, am, base, key_type, root, NULL, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 
 	/* the parent will be the (possibly virtual) node so that
 	 * &lparent->l == root.
@@ -432,7 +1051,29 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 	 * and pxorXX==~0 for scalars.
 	 */
 	while (1) {
-		p = *root;
+		p = _ceb_ldb(am, base, root);
+
+		/* only leaf pointers may be tagged, and they then designate
+		 * the last element of a list of duplicates, all sharing the
+		 * same key. This is always a leaf, we can stop here.
+		 */
+		if (ret_is_dup && __ceb_tagged(p)) {
+			p = __ceb_clrtag(p);
+			is_dup = 1;
+			if (meth != CEB_WM_LST && meth != CEB_WM_PRV &&
+			    meth != CEB_WM_KLE && meth != CEB_WM_KLT && meth != CEB_WM_KPR)
+				p = _ceb_getb(am, base, __ceb_clrtag(_ceb_getb(am, base, p, 1)), 0);
+			k = NODEK(p, kofs);
+			dbg(__LINE__, "dups", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+			break;
+		}
+
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+		if (ret_is_dup) {
+			lb = __ceb_clrtag(lb);
+			rb = __ceb_clrtag(rb);
+		}
 
 		/* let's prefetch the lower nodes's next nodes so that the keys
 		 * are present in the next round. We'll instantly have the
@@ -441,21 +1082,21 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 		 * the nature of such trees: values are compared to the ones of
 		 * the sub-trees and not having them stalls the descent.
 		 */
-		__builtin_prefetch(p->b[0]->b[0], 0);
-		__builtin_prefetch(p->b[0]->b[1], 0);
-		__builtin_prefetch(p->b[1]->b[0], 0);
-		__builtin_prefetch(p->b[1]->b[1], 0);
+		__builtin_prefetch(_ceb_getb(am, base, lb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, lb, 1), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 1), 0);
 
-		/* neither pointer is tagged */
+		/* pointers to duplicates were untagged above */
 		k = NODEK(p, kofs);
-		l = NODEK(p->b[0], kofs);
-		r = NODEK(p->b[1], kofs);
+		l = NODEK(lb, kofs);
+		r = NODEK(rb, kofs);
 
-		dbg(__LINE__, "newp", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+		dbg(__LINE__, "newp", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 
 		/* two equal pointers identifies the nodeless leaf. */
 		if (l == r) {
-			dbg(__LINE__, "l==r", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+			dbg(__LINE__, "l==r", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 			break;
 		}
 
@@ -504,15 +1145,15 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 		 *        types.
 		 */
 
-		if (key_type == CEB_KT_U32) {
+		if (_ceb_kt_is32(key_type)) {
 			uint32_t xor32;   // left vs right branch xor
 			uint32_t kl, kr;
 
-			kl = l->u32; kr = r->u32;
+			kl = _ceb_k32(key_type, l) ^ sgn32; kr = _ceb_k32(key_type, r) ^ sgn32;
 			xor32 = kl ^ kr;
 
 			if (xor32 > pxor32) { // test using 2 4 6 4
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
@@ -524,13 +1165,14 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				/* let's stop if our key is not there */
 
 				if (kl > xor32 && kr > xor32) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
 				if (ret_npside || ret_nparent) {
-					if (key_u32 == k->u32) {
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					if (key_u32 == (_ceb_k32(key_type, k) ^ sgn32)) {
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
 					}
@@ -538,15 +1180,15 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			}
 			pxor32 = xor32;
 		}
-		else if (key_type == CEB_KT_U64) {
+		else if (_ceb_kt_is64(key_type)) {
 			uint64_t xor64;   // left vs right branch xor
 			uint64_t kl, kr;
 
-			kl = l->u64; kr = r->u64;
+			kl = _ceb_k64(key_type, l) ^ sgn64; kr = _ceb_k64(key_type, r) ^ sgn64;
 			xor64 = kl ^ kr;
 
 			if (xor64 > pxor64) { // test using 2 4 6 4
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
@@ -558,13 +1200,14 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				/* let's stop if our key is not there */
 
 				if (kl > xor64 && kr > xor64) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
 				if (ret_npside || ret_nparent) {
-					if (key_u64 == k->u64) {
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					if (key_u64 == (_ceb_k64(key_type, k) ^ sgn64)) {
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
 					}
@@ -572,6 +1215,44 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			}
 			pxor64 = xor64;
 		}
+		else if (key_type == CEB_KT_U128) {
+			uint64_t xorhi, xorlo;  // left vs right branch xor
+			uint64_t klhi, kllo, krhi, krlo;
+
+			xorhi = l->u128[0] ^ r->u128[0];
+			xorlo = l->u128[1] ^ r->u128[1];
+
+			if (_ceb_cmp128(xorhi, xorlo, pxor64, pxorlo) > 0) {
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				break;
+			}
+
+			if (meth >= CEB_WM_KEQ) {
+				/* "found" is not used here */
+				klhi = l->u128[0] ^ key_hi; kllo = l->u128[1] ^ key_lo;
+				krhi = r->u128[0] ^ key_hi; krlo = r->u128[1] ^ key_lo;
+				brside = _ceb_cmp128(klhi, kllo, krhi, krlo) >= 0;
+
+				/* let's stop if our key is not there */
+
+				if (_ceb_cmp128(klhi, kllo, xorhi, xorlo) > 0 &&
+				    _ceb_cmp128(krhi, krlo, xorhi, xorlo) > 0) {
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
+					break;
+				}
+
+				if (ret_npside || ret_nparent) {
+					if (k->u128[0] == key_hi && k->u128[1] == key_lo) {
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						nparent = lparent;
+						npside  = lpside;
+					}
+				}
+			}
+			pxor64 = xorhi;
+			pxorlo = xorlo;
+		}
 		else if (key_type == CEB_KT_MB) {
 			size_t xlen = 0; // left vs right matching length
 
@@ -587,7 +1268,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			xlen = equal_bits(l->mb, r->mb, 0, key_u64 << 3);
 			if (xlen < plen) {
 				/* this is a leaf. E.g. triggered using 2 4 6 4 */
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
@@ -595,7 +1276,8 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				/* let's stop if our key is not there */
 
 				if (llen < xlen && rlen < xlen) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
@@ -606,7 +1288,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 						mlen = xlen;
 
 					if ((uint64_t)xlen / 8 == key_u64 || memcmp(key_ptr + mlen / 8, k->mb + mlen / 8, key_u64 - mlen / 8) == 0) {
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
 						found = 1;
@@ -630,7 +1312,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			xlen = equal_bits(l->ptr, r->ptr, 0, key_u64 << 3);
 			if (xlen < plen) {
 				/* this is a leaf. E.g. triggered using 2 4 6 4 */
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
@@ -638,7 +1320,8 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				/* let's stop if our key is not there */
 
 				if (llen < xlen && rlen < xlen) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
@@ -649,7 +1332,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 						mlen = xlen;
 
 					if ((uint64_t)xlen / 8 == key_u64 || memcmp(key_ptr + mlen / 8, k->ptr + mlen / 8, key_u64 - mlen / 8) == 0) {
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
 						found = 1;
@@ -658,7 +1341,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			}
 			plen = xlen;
 		}
-		else if (key_type == CEB_KT_ST) {
+		else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI) {
 			size_t xlen = 0; // left vs right matching length
 
 			if (meth >= CEB_WM_KEQ) {
@@ -668,17 +1351,17 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				 * leaf. We take that negative length for an
 				 * infinite one, hence the uint cast.
 				 */
-				llen = string_equal_bits(key_ptr, l->str, 0);
-				rlen = string_equal_bits(key_ptr, r->str, 0);
+				llen = _ceb_str_equal_bits(key_type, key_ptr, key_u64, l->str, 0);
+				rlen = _ceb_str_equal_bits(key_type, key_ptr, key_u64, r->str, 0);
 				brside = (size_t)llen <= (size_t)rlen;
 				if ((ssize_t)llen < 0 || (ssize_t)rlen < 0)
 					found = 1;
 			}
 
-			xlen = string_equal_bits(l->str, r->str, 0);
+			xlen = _ceb_str_equal_bits(key_type, l->str, 0, r->str, 0);
 			if (xlen < plen) {
 				/* this is a leaf. E.g. triggered using 2 4 6 4 */
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
@@ -686,7 +1369,8 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				/* let's stop if our key is not there */
 
 				if ((unsigned)llen < (unsigned)xlen && (unsigned)rlen < (unsigned)xlen) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
@@ -696,9 +1380,9 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 					if (mlen > xlen)
 						mlen = xlen;
 
-					if (strcmp(key_ptr + mlen / 8, (const void *)k->str + mlen / 8) == 0) {
+					if (_ceb_strcmp(key_type, key_ptr, key_u64, k->str, mlen / 8) == 0) {
 						/* strcmp() still needed. E.g. 1 2 3 4 10 11 4 3 2 1 10 11 fails otherwise */
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
 						found = 1;
@@ -707,7 +1391,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			}
 			plen = xlen;
 		}
-		else if (key_type == CEB_KT_IS) {
+		else if (key_type == CEB_KT_IS || key_type == CEB_KT_ISI) {
 			size_t xlen = 0; // left vs right matching length
 
 			if (meth >= CEB_WM_KEQ) {
@@ -717,17 +1401,17 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				 * leaf. We take that negative length for an
 				 * infinite one, hence the uint cast.
 				 */
-				llen = string_equal_bits(key_ptr, l->ptr, 0);
-				rlen = string_equal_bits(key_ptr, r->ptr, 0);
+				llen = _ceb_str_equal_bits(key_type, key_ptr, key_u64, l->ptr, 0);
+				rlen = _ceb_str_equal_bits(key_type, key_ptr, key_u64, r->ptr, 0);
 				brside = (size_t)llen <= (size_t)rlen;
 				if ((ssize_t)llen < 0 || (ssize_t)rlen < 0)
 					found = 1;
 			}
 
-			xlen = string_equal_bits(l->ptr, r->ptr, 0);
+			xlen = _ceb_str_equal_bits(key_type, l->ptr, 0, r->ptr, 0);
 			if (xlen < plen) {
 				/* this is a leaf. E.g. triggered using 2 4 6 4 */
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
@@ -735,7 +1419,8 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				/* let's stop if our key is not there */
 
 				if ((unsigned)llen < (unsigned)xlen && (unsigned)rlen < (unsigned)xlen) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
@@ -745,9 +1430,9 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 					if (mlen > xlen)
 						mlen = xlen;
 
-					if (strcmp(key_ptr + mlen / 8, (const void *)k->ptr + mlen / 8) == 0) {
+					if (_ceb_strcmp(key_type, key_ptr, key_u64, k->ptr, mlen / 8) == 0) {
 						/* strcmp() still needed. E.g. 1 2 3 4 10 11 4 3 2 1 10 11 fails otherwise */
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
 						found = 1;
@@ -756,72 +1441,169 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			}
 			plen = xlen;
 		}
-		else if (key_type == CEB_KT_ADDR) {
-			uintptr_t xoraddr;   // left vs right branch xor
-			uintptr_t kl, kr;
+		else if (key_type == CEB_KT_VB) {
+			size_t xlen = 0; // left vs right matching length
 
-			kl = (uintptr_t)l; kr = (uintptr_t)r;
-			xoraddr = kl ^ kr;
+			if (meth >= CEB_WM_KEQ) {
+				/* Just like for strings, a negative length
+				 * indicates an equal value, which we take for
+				 * an infinite one.
+				 */
+				llen = vblock_equal_bits(key_ptr, key_u64, l->vb.data, l->vb.len, 0);
+				rlen = vblock_equal_bits(key_ptr, key_u64, r->vb.data, r->vb.len, 0);
+				brside = llen <= rlen;
+				if ((ssize_t)llen < 0 || (ssize_t)rlen < 0)
+					found = 1;
+			}
 
-			if (xoraddr > (uintptr_t)pxor64) { // test using 2 4 6 4
-				dbg(__LINE__, "xor>", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+			xlen = vblock_equal_bits(l->vb.data, l->vb.len, r->vb.data, r->vb.len, 0);
+			if (xlen < plen) {
+				/* this is a leaf. E.g. triggered using 2 4 6 4 */
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 				break;
 			}
 
 			if (meth >= CEB_WM_KEQ) {
-				/* "found" is not used here */
-				kl ^= (uintptr_t)key_ptr; kr ^= (uintptr_t)key_ptr;
-				brside = kl >= kr;
-
 				/* let's stop if our key is not there */
 
-				if (kl > xoraddr && kr > xoraddr) {
-					dbg(__LINE__, "mismatch", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				if (llen < xlen && rlen < xlen) {
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
 					break;
 				}
 
-				if (ret_npside || ret_nparent) {
-					if ((uintptr_t)key_ptr == (uintptr_t)p) {
-						dbg(__LINE__, "equal", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				if (ret_npside || ret_nparent) { // delete ?
+					size_t mlen = llen > rlen ? llen : rlen;
+
+					if (mlen > xlen)
+						mlen = xlen;
+
+					if (vblock_cmp(key_ptr, key_u64, k->vb.data, k->vb.len, mlen) == 0) {
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 						nparent = lparent;
 						npside  = lpside;
+						found = 1;
 					}
 				}
 			}
-			pxor64 = xoraddr;
+			plen = xlen;
 		}
+		else if (key_type == CEB_KT_PB) {
+			size_t xlen = 0; // left vs right matching length
 
-		/* shift all copies by one */
-		gparent = lparent;
-		gpside = lpside;
-		lparent = p;
+			if (meth >= CEB_WM_KEQ) {
+				/* Just like for blocks, a negative length
+				 * indicates an equal value.
+				 */
+				llen = prefix_equal_bits(key_ptr, key_u64, l->pfx.data, l->pfx.plen);
+				rlen = prefix_equal_bits(key_ptr, key_u64, r->pfx.data, r->pfx.plen);
+				brside = llen <= rlen;
+				if ((ssize_t)llen < 0 || (ssize_t)rlen < 0)
+					found = 1;
+			}
+
+			xlen = prefix_equal_bits(l->pfx.data, l->pfx.plen, r->pfx.data, r->pfx.plen);
+			if (xlen < plen) {
+				/* this is a leaf. E.g. triggered using 2 4 6 4 */
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				break;
+			}
+
+			if (meth >= CEB_WM_KEQ) {
+				/* let's stop if our key is not there */
+
+				if (llen < xlen && rlen < xlen) {
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
+					break;
+				}
+
+				if (ret_npside || ret_nparent) { // delete ?
+					size_t mlen = llen > rlen ? llen : rlen;
+
+					if (mlen > xlen)
+						mlen = xlen;
+
+					if (prefix_cmp(key_ptr, key_u64, k->pfx.data, k->pfx.plen) == 0) {
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						nparent = lparent;
+						npside  = lpside;
+						found = 1;
+					}
+				}
+			}
+			plen = xlen;
+		}
+		else if (key_type == CEB_KT_ADDR) {
+			uintptr_t xoraddr;   // left vs right branch xor
+			uintptr_t kl, kr;
+
+			/* the key is the node itself, not what follows it */
+			kl = (uintptr_t)lb; kr = (uintptr_t)rb;
+			xoraddr = kl ^ kr;
+
+			if (xoraddr > (uintptr_t)pxor64) { // test using 2 4 6 4
+				dbg(__LINE__, "xor>", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+				break;
+			}
+
+			if (meth >= CEB_WM_KEQ) {
+				/* "found" is not used here */
+				kl ^= (uintptr_t)key_ptr; kr ^= (uintptr_t)key_ptr;
+				brside = kl >= kr;
+
+				/* let's stop if our key is not there */
+
+				if (kl > xoraddr && kr > xoraddr) {
+					dbg(__LINE__, "mismatch", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+					miss = 1;
+					break;
+				}
+
+				if (ret_npside || ret_nparent) {
+					if ((uintptr_t)key_ptr == (uintptr_t)p) {
+						dbg(__LINE__, "equal", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+						nparent = lparent;
+						npside  = lpside;
+					}
+				}
+			}
+			pxor64 = xoraddr;
+		}
+
+		/* shift all copies by one */
+		gparent = lparent;
+		gpside = lpside;
+		lparent = p;
 		lpside = brside;
 		if (brside) {
 			if (meth == CEB_WM_KPR || meth == CEB_WM_KLE || meth == CEB_WM_KLT)
-				bnode = p;
-			root = &p->b[1];
+				bnode = root;
+			else if (meth == CEB_WM_KBR)
+				pnode = root;
+			root = _ceb_br(am, p, 1);
 
 			/* change branch for key-less walks */
 			if (meth == CEB_WM_NXT)
 				brside = 0;
 
-			dbg(__LINE__, "side1", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+			dbg(__LINE__, "side1", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 		}
 		else {
-			if (meth == CEB_WM_KNX || meth == CEB_WM_KGE || meth == CEB_WM_KGT)
-				bnode = p;
-			root = &p->b[0];
+			if (meth == CEB_WM_KNX || meth == CEB_WM_KGE || meth == CEB_WM_KGT || meth == CEB_WM_KBR)
+				bnode = root;
+			root = _ceb_br(am, p, 0);
 
 			/* change branch for key-less walks */
 			if (meth == CEB_WM_PRV)
 				brside = 1;
 
-			dbg(__LINE__, "side0", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+			dbg(__LINE__, "side0", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 		}
 
-		if (p == *root) {
+		if (p == _ceb_ldb(am, base, root)) {
 			/* loops over itself, it's a leaf */
-			dbg(__LINE__, "loop", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+			dbg(__LINE__, "loop", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 			break;
 		}
 	}
@@ -840,38 +1622,75 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 	 * guarantees these bits exist. Test with "100", "10", "1" to see where
 	 * this is needed.
 	 */
-	if ((key_type == CEB_KT_ST || key_type == CEB_KT_IS) && meth >= CEB_WM_KEQ && !found)
+	if ((key_type == CEB_KT_ST || key_type == CEB_KT_IS || key_type == CEB_KT_SI || key_type == CEB_KT_ISI) &&
+	    meth >= CEB_WM_KEQ && !found)
 		plen = (llen > rlen) ? llen : rlen;
 
-	/* update the pointers needed for modifications (insert, delete) */
-	if (ret_nside && meth >= CEB_WM_KEQ) {
+	/* update the pointers needed for modifications (insert, delete), and
+	 * for range lookups which stopped above a subtree not containing the
+	 * key.
+	 */
+	if (meth >= CEB_WM_KEQ &&
+	    (ret_nside || (miss && meth >= CEB_WM_KGE && meth <= CEB_WM_KLT))) {
 		switch (key_type) {
 		case CEB_KT_U32:
-			*ret_nside = key_u32 >= k->u32;
+		case CEB_KT_I32:
+		case CEB_KT_U16:
+		case CEB_KT_U8:
+		case CEB_KT_IU32:
+			nside = key_u32 >= (_ceb_k32(key_type, k) ^ sgn32);
 			break;
 		case CEB_KT_U64:
-			*ret_nside = key_u64 >= k->u64;
+		case CEB_KT_I64:
+		case CEB_KT_IU64:
+		case CEB_KT_P32:
+			nside = key_u64 >= (_ceb_k64(key_type, k) ^ sgn64);
+			break;
+		case CEB_KT_U128:
+			nside = _ceb_cmp128(key_hi, key_lo, k->u128[0], k->u128[1]) >= 0;
 			break;
 		case CEB_KT_MB:
-			*ret_nside = (uint64_t)plen / 8 == key_u64 || memcmp(key_ptr + plen / 8, k->mb + plen / 8, key_u64 - plen / 8) >= 0;
+			nside = (uint64_t)plen / 8 == key_u64 || memcmp(key_ptr + plen / 8, k->mb + plen / 8, key_u64 - plen / 8) >= 0;
 			break;
 		case CEB_KT_IM:
-			*ret_nside = (uint64_t)plen / 8 == key_u64 || memcmp(key_ptr + plen / 8, k->ptr + plen / 8, key_u64 - plen / 8) >= 0;
+			nside = (uint64_t)plen / 8 == key_u64 || memcmp(key_ptr + plen / 8, k->ptr + plen / 8, key_u64 - plen / 8) >= 0;
 			break;
 		case CEB_KT_ST:
-			*ret_nside = found || strcmp(key_ptr + plen / 8, (const void *)k->str + plen / 8) >= 0;
+		case CEB_KT_SI:
+			nside = found || _ceb_strcmp(key_type, key_ptr, key_u64, k->str, plen / 8) >= 0;
 			break;
 		case CEB_KT_IS:
-			*ret_nside = found || strcmp(key_ptr + plen / 8, (const void *)k->ptr + plen / 8) >= 0;
+		case CEB_KT_ISI:
+			nside = found || _ceb_strcmp(key_type, key_ptr, key_u64, k->ptr, plen / 8) >= 0;
+			break;
+		case CEB_KT_VB:
+			nside = found || vblock_cmp(key_ptr, key_u64, k->vb.data, k->vb.len, plen) >= 0;
+			break;
+		case CEB_KT_PB:
+			nside = found || prefix_cmp(key_ptr, key_u64, k->pfx.data, k->pfx.plen) >= 0;
 			break;
 		case CEB_KT_ADDR:
-			*ret_nside = (uintptr_t)key_ptr >= (uintptr_t)p;
+			nside = (uintptr_t)key_ptr >= (uintptr_t)p;
 			break;
 		}
+		if (ret_nside)
+			*ret_nside = nside;
 	}
 
-	if (ret_root)
-		*ret_root = root;
+	if (ret_root) {
+		/* range lookups which stopped above a subtree entirely located
+		 * on the matching side of the key report it so that the caller
+		 * picks its first or last entry, otherwise NULL.
+		 */
+		if (meth == CEB_WM_KGE || meth == CEB_WM_KGT)
+			*ret_root = (miss && !nside) ? root : NULL;
+		else if (meth == CEB_WM_KLE || meth == CEB_WM_KLT)
+			*ret_root = (miss && nside) ? root : NULL;
+		else if (meth == CEB_WM_KBR)
+			*ret_root = NULL; // set below if not found
+		else
+			*ret_root = root;
+	}
 
 	/* info needed by delete */
 	if (ret_lpside)
@@ -892,10 +1711,26 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 	if (ret_gparent)
 		*ret_gparent = gparent;
 
-	if (ret_back)
-		*ret_back = bnode;
+	if (ret_back) {
+		if (meth == CEB_WM_KBR) {
+			ret_back[0] = pnode;
+			ret_back[1] = bnode;
+		}
+		else
+			*ret_back = bnode;
+	}
+
+	if (ret_is_dup)
+		*ret_is_dup = is_dup;
+
+	dbg(__LINE__, "_ret____", meth, kofs, am, base, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
 
-	dbg(__LINE__, "_ret____", meth, kofs, key_type, root, p, key_u32, key_u64, key_ptr, pxor32, pxor64, plen);
+	/* a range lookup which stopped above a subtree cannot return the node
+	 * it stopped on, the result is either the first or last entry of this
+	 * subtree (see ret_root), or a neighbour.
+	 */
+	if (miss && meth >= CEB_WM_KGE && meth <= CEB_WM_KLT)
+		return NULL;
 
 	if (meth >= CEB_WM_KEQ) {
 		/* For lookups, an equal value means an instant return. For insertions,
@@ -903,24 +1738,39 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 		 * that the caller can decide what to do. For deletion, we also want to
 		 * return the pointer that's about to be deleted.
 		 */
-		if (key_type == CEB_KT_U32) {
-			if ((meth == CEB_WM_KEQ && k->u32 == key_u32) ||
-			    (meth == CEB_WM_KNX && k->u32 == key_u32) ||
-			    (meth == CEB_WM_KPR && k->u32 == key_u32) ||
-			    (meth == CEB_WM_KGE && k->u32 >= key_u32) ||
-			    (meth == CEB_WM_KGT && k->u32 >  key_u32) ||
-			    (meth == CEB_WM_KLE && k->u32 <= key_u32) ||
-			    (meth == CEB_WM_KLT && k->u32 <  key_u32))
+		if (_ceb_kt_is32(key_type)) {
+			if ((meth == CEB_WM_KEQ && (_ceb_k32(key_type, k) ^ sgn32) == key_u32) ||
+			    (meth == CEB_WM_KBR && (_ceb_k32(key_type, k) ^ sgn32) == key_u32) ||
+			    (meth == CEB_WM_KNX && (_ceb_k32(key_type, k) ^ sgn32) == key_u32) ||
+			    (meth == CEB_WM_KPR && (_ceb_k32(key_type, k) ^ sgn32) == key_u32) ||
+			    (meth == CEB_WM_KGE && (_ceb_k32(key_type, k) ^ sgn32) >= key_u32) ||
+			    (meth == CEB_WM_KGT && (_ceb_k32(key_type, k) ^ sgn32) >  key_u32) ||
+			    (meth == CEB_WM_KLE && (_ceb_k32(key_type, k) ^ sgn32) <= key_u32) ||
+			    (meth == CEB_WM_KLT && (_ceb_k32(key_type, k) ^ sgn32) <  key_u32))
+				return p;
+		}
+		else if (_ceb_kt_is64(key_type)) {
+			if ((meth == CEB_WM_KEQ && (_ceb_k64(key_type, k) ^ sgn64) == key_u64) ||
+			    (meth == CEB_WM_KBR && (_ceb_k64(key_type, k) ^ sgn64) == key_u64) ||
+			    (meth == CEB_WM_KNX && (_ceb_k64(key_type, k) ^ sgn64) == key_u64) ||
+			    (meth == CEB_WM_KPR && (_ceb_k64(key_type, k) ^ sgn64) == key_u64) ||
+			    (meth == CEB_WM_KGE && (_ceb_k64(key_type, k) ^ sgn64) >= key_u64) ||
+			    (meth == CEB_WM_KGT && (_ceb_k64(key_type, k) ^ sgn64) >  key_u64) ||
+			    (meth == CEB_WM_KLE && (_ceb_k64(key_type, k) ^ sgn64) <= key_u64) ||
+			    (meth == CEB_WM_KLT && (_ceb_k64(key_type, k) ^ sgn64) <  key_u64))
 				return p;
 		}
-		else if (key_type == CEB_KT_U64) {
-			if ((meth == CEB_WM_KEQ && k->u64 == key_u64) ||
-			    (meth == CEB_WM_KNX && k->u64 == key_u64) ||
-			    (meth == CEB_WM_KPR && k->u64 == key_u64) ||
-			    (meth == CEB_WM_KGE && k->u64 >= key_u64) ||
-			    (meth == CEB_WM_KGT && k->u64 >  key_u64) ||
-			    (meth == CEB_WM_KLE && k->u64 <= key_u64) ||
-			    (meth == CEB_WM_KLT && k->u64 <  key_u64))
+		else if (key_type == CEB_KT_U128) {
+			int diff = _ceb_cmp128(k->u128[0], k->u128[1], key_hi, key_lo);
+
+			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
+			    (meth == CEB_WM_KNX && diff == 0) ||
+			    (meth == CEB_WM_KPR && diff == 0) ||
+			    (meth == CEB_WM_KGE && diff >= 0) ||
+			    (meth == CEB_WM_KGT && diff >  0) ||
+			    (meth == CEB_WM_KLE && diff <= 0) ||
+			    (meth == CEB_WM_KLT && diff <  0))
 				return p;
 		}
 		else if (key_type == CEB_KT_MB) {
@@ -932,6 +1782,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				diff = memcmp(k->mb + plen / 8, key_ptr + plen / 8, key_u64 - plen / 8);
 
 			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
 			    (meth == CEB_WM_KNX && diff == 0) ||
 			    (meth == CEB_WM_KPR && diff == 0) ||
 			    (meth == CEB_WM_KGE && diff >= 0) ||
@@ -949,6 +1800,43 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 				diff = memcmp(k->ptr + plen / 8, key_ptr + plen / 8, key_u64 - plen / 8);
 
 			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
+			    (meth == CEB_WM_KNX && diff == 0) ||
+			    (meth == CEB_WM_KPR && diff == 0) ||
+			    (meth == CEB_WM_KGE && diff >= 0) ||
+			    (meth == CEB_WM_KGT && diff >  0) ||
+			    (meth == CEB_WM_KLE && diff <= 0) ||
+			    (meth == CEB_WM_KLT && diff <  0))
+				return p;
+		}
+		else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI) {
+			int diff;
+
+			if (found)
+				diff = 0;
+			else
+				diff = -_ceb_strcmp(key_type, key_ptr, key_u64, k->str, plen / 8);
+
+			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
+			    (meth == CEB_WM_KNX && diff == 0) ||
+			    (meth == CEB_WM_KPR && diff == 0) ||
+			    (meth == CEB_WM_KGE && diff >= 0) ||
+			    (meth == CEB_WM_KGT && diff >  0) ||
+			    (meth == CEB_WM_KLE && diff <= 0) ||
+			    (meth == CEB_WM_KLT && diff <  0))
+				return p;
+		}
+		else if (key_type == CEB_KT_IS || key_type == CEB_KT_ISI) {
+			int diff;
+
+			if (found)
+				diff = 0;
+			else
+				diff = -_ceb_strcmp(key_type, key_ptr, key_u64, k->ptr, plen / 8);
+
+			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
 			    (meth == CEB_WM_KNX && diff == 0) ||
 			    (meth == CEB_WM_KPR && diff == 0) ||
 			    (meth == CEB_WM_KGE && diff >= 0) ||
@@ -957,15 +1845,16 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			    (meth == CEB_WM_KLT && diff <  0))
 				return p;
 		}
-		else if (key_type == CEB_KT_ST) {
+		else if (key_type == CEB_KT_VB) {
 			int diff;
 
 			if (found)
 				diff = 0;
 			else
-				diff = strcmp((const void *)k->str + plen / 8, key_ptr + plen / 8);
+				diff = vblock_cmp(k->vb.data, k->vb.len, key_ptr, key_u64, plen);
 
 			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
 			    (meth == CEB_WM_KNX && diff == 0) ||
 			    (meth == CEB_WM_KPR && diff == 0) ||
 			    (meth == CEB_WM_KGE && diff >= 0) ||
@@ -974,15 +1863,16 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			    (meth == CEB_WM_KLT && diff <  0))
 				return p;
 		}
-		else if (key_type == CEB_KT_IS) {
+		else if (key_type == CEB_KT_PB) {
 			int diff;
 
 			if (found)
 				diff = 0;
 			else
-				diff = strcmp((const void *)k->ptr + plen / 8, key_ptr + plen / 8);
+				diff = prefix_cmp(k->pfx.data, k->pfx.plen, key_ptr, key_u64);
 
 			if ((meth == CEB_WM_KEQ && diff == 0) ||
+			    (meth == CEB_WM_KBR && diff == 0) ||
 			    (meth == CEB_WM_KNX && diff == 0) ||
 			    (meth == CEB_WM_KPR && diff == 0) ||
 			    (meth == CEB_WM_KGE && diff >= 0) ||
@@ -993,6 +1883,7 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 		}
 		else if (key_type == CEB_KT_ADDR) {
 			if ((meth == CEB_WM_KEQ && (uintptr_t)p == (uintptr_t)key_ptr) ||
+			    (meth == CEB_WM_KBR && (uintptr_t)p == (uintptr_t)key_ptr) ||
 			    (meth == CEB_WM_KNX && (uintptr_t)p == (uintptr_t)key_ptr) ||
 			    (meth == CEB_WM_KPR && (uintptr_t)p == (uintptr_t)key_ptr) ||
 			    (meth == CEB_WM_KGE && (uintptr_t)p >= (uintptr_t)key_ptr) ||
@@ -1001,6 +1892,15 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 			    (meth == CEB_WM_KLT && (uintptr_t)p <  (uintptr_t)key_ptr))
 				return p;
 		}
+
+		/* bracket lookups report the leaf or the subtree where the key
+		 * would be.
+		 */
+		if (meth == CEB_WM_KBR) {
+			if (ret_root)
+				*ret_root = root;
+			return miss ? NULL : p;
+		}
 	} else if (meth == CEB_WM_FST || meth == CEB_WM_LST) {
 		return p;
 	} else if (meth == CEB_WM_PRV || meth == CEB_WM_NXT) {
@@ -1019,12 +1919,15 @@ struct ceb_node *_cebu_descend(struct ceb_node **root,
 
 /* Generic tree insertion function for trees with unique keys. Inserts node
  * <node> into tree <tree>, with key type <key_type> and key <key_*>.
- * Returns the inserted node or the one that already contains the same key.
+ * Returns the inserted node or the one that already contains the same key,
+ * or NULL if the node cannot be addressed from the root in model <am>.
  */
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_insert(struct ceb_node **root,
                               struct ceb_node *node,
                               ptrdiff_t kofs,
+                              enum ceb_addr_mode am,
+                              const void *base,
                               enum ceb_key_type key_type,
                               uint32_t key_u32,
                               uint64_t key_u64,
@@ -1034,14 +1937,18 @@ struct ceb_node *_cebu_insert(struct ceb_node **root,
 	struct ceb_node *ret;
 	int nside;
 
-	if (!*root) {
+	if (!_ceb_inwin(am, base, root, node))
+		return NULL;
+
+	if (!_ceb_ld(am, base, root)) {
 		/* empty tree, insert a leaf only */
-		node->b[0] = node->b[1] = node;
-		*root = node;
+		_ceb_setb(am, base, node, 0, node);
+		_ceb_setb(am, base, node, 1, node);
+		_ceb_st(am, base, root, node);
 		return node;
 	}
 
-	ret = _cebu_descend(root, CEB_WM_KEQ, kofs, key_type, key_u32, key_u64, key_ptr, &nside, &parent, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	ret = _cebu_descend(root, CEB_WM_KEQ, kofs, am, base, key_type, key_u32, key_u64, key_ptr, &nside, &parent, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 
 	if (!ret) {
 		/* The key was not in the tree, we can insert it. Better use an
@@ -1050,13 +1957,13 @@ struct ceb_node *_cebu_insert(struct ceb_node **root,
 		 * optimizes it a bit.
 		 */
 		if (nside) {
-			node->b[1] = node;
-			node->b[0] = *parent;
+			_ceb_setb(am, base, node, 1, node);
+			_ceb_setb(am, base, node, 0, _ceb_ldb(am, base, parent));
 		} else {
-			node->b[0] = node;
-			node->b[1] = *parent;
+			_ceb_setb(am, base, node, 0, node);
+			_ceb_setb(am, base, node, 1, _ceb_ldb(am, base, parent));
 		}
-		*parent = node;
+		_ceb_st(am, base, parent, node);
 		ret = node;
 	}
 	return ret;
@@ -1068,12 +1975,14 @@ struct ceb_node *_cebu_insert(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_first(struct ceb_node **root,
                              ptrdiff_t kofs,
+                             enum ceb_addr_mode am,
+                             const void *base,
                              enum ceb_key_type key_type)
 {
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	return _cebu_descend(root, CEB_WM_FST, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(root, CEB_WM_FST, kofs, am, base, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Returns the last node or NULL if not found, assuming a tree made of keys of
@@ -1082,12 +1991,14 @@ struct ceb_node *_cebu_first(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_last(struct ceb_node **root,
                             ptrdiff_t kofs,
+                            enum ceb_addr_mode am,
+                            const void *base,
                             enum ceb_key_type key_type)
 {
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	return _cebu_descend(root, CEB_WM_LST, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(root, CEB_WM_LST, kofs, am, base, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the next
@@ -1100,23 +2011,25 @@ struct ceb_node *_cebu_last(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_next(struct ceb_node **root,
                             ptrdiff_t kofs,
+                            enum ceb_addr_mode am,
+                            const void *base,
                             enum ceb_key_type key_type,
                             uint32_t key_u32,
                             uint64_t key_u64,
                             const void *key_ptr)
 {
-	struct ceb_node *restart;
+	struct ceb_node **restart;
 
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	if (!_cebu_descend(root, CEB_WM_KNX, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart))
+	if (!_cebu_descend(root, CEB_WM_KNX, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart, NULL))
 		return NULL;
 
 	if (!restart)
 		return NULL;
 
-	return _cebu_descend(&restart, CEB_WM_NXT, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(restart, CEB_WM_NXT, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the prev
@@ -1129,23 +2042,25 @@ struct ceb_node *_cebu_next(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_prev(struct ceb_node **root,
                             ptrdiff_t kofs,
+                            enum ceb_addr_mode am,
+                            const void *base,
                             enum ceb_key_type key_type,
                             uint32_t key_u32,
                             uint64_t key_u64,
                             const void *key_ptr)
 {
-	struct ceb_node *restart;
+	struct ceb_node **restart;
 
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	if (!_cebu_descend(root, CEB_WM_KPR, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart))
+	if (!_cebu_descend(root, CEB_WM_KPR, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart, NULL))
 		return NULL;
 
 	if (!restart)
 		return NULL;
 
-	return _cebu_descend(&restart, CEB_WM_PRV, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(restart, CEB_WM_PRV, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the node
@@ -1154,15 +2069,17 @@ struct ceb_node *_cebu_prev(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_lookup(struct ceb_node **root,
                               ptrdiff_t kofs,
+                              enum ceb_addr_mode am,
+                              const void *base,
                               enum ceb_key_type key_type,
                               uint32_t key_u32,
                               uint64_t key_u64,
                               const void *key_ptr)
 {
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	return _cebu_descend(root, CEB_WM_KEQ, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(root, CEB_WM_KEQ, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the node
@@ -1172,25 +2089,30 @@ struct ceb_node *_cebu_lookup(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_lookup_le(struct ceb_node **root,
                                  ptrdiff_t kofs,
+                                 enum ceb_addr_mode am,
+                                 const void *base,
                                  enum ceb_key_type key_type,
                                  uint32_t key_u32,
                                  uint64_t key_u64,
                                  const void *key_ptr)
 {
 	struct ceb_node *ret = NULL;
-	struct ceb_node *restart;
+	struct ceb_node **restart, **subroot;
 
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	ret = _cebu_descend(root, CEB_WM_KLE, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart);
+	ret = _cebu_descend(root, CEB_WM_KLE, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, NULL);
 	if (ret)
 		return ret;
 
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_LST, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
 	if (!restart)
 		return NULL;
 
-	return _cebu_descend(&restart, CEB_WM_PRV, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(restart, CEB_WM_PRV, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the node
@@ -1201,25 +2123,30 @@ struct ceb_node *_cebu_lookup_le(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_lookup_lt(struct ceb_node **root,
                                  ptrdiff_t kofs,
+                                 enum ceb_addr_mode am,
+                                 const void *base,
                                  enum ceb_key_type key_type,
                                  uint32_t key_u32,
                                  uint64_t key_u64,
                                  const void *key_ptr)
 {
 	struct ceb_node *ret = NULL;
-	struct ceb_node *restart;
+	struct ceb_node **restart, **subroot;
 
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	ret = _cebu_descend(root, CEB_WM_KLT, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart);
+	ret = _cebu_descend(root, CEB_WM_KLT, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, NULL);
 	if (ret)
 		return ret;
 
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_LST, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
 	if (!restart)
 		return NULL;
 
-	return _cebu_descend(&restart, CEB_WM_PRV, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(restart, CEB_WM_PRV, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the node
@@ -1229,25 +2156,30 @@ struct ceb_node *_cebu_lookup_lt(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_lookup_ge(struct ceb_node **root,
                                  ptrdiff_t kofs,
+                                 enum ceb_addr_mode am,
+                                 const void *base,
                                  enum ceb_key_type key_type,
                                  uint32_t key_u32,
                                  uint64_t key_u64,
                                  const void *key_ptr)
 {
 	struct ceb_node *ret = NULL;
-	struct ceb_node *restart;
+	struct ceb_node **restart, **subroot;
 
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	ret = _cebu_descend(root, CEB_WM_KGE, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart);
+	ret = _cebu_descend(root, CEB_WM_KGE, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, NULL);
 	if (ret)
 		return ret;
 
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_FST, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
 	if (!restart)
 		return NULL;
 
-	return _cebu_descend(&restart, CEB_WM_NXT, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(restart, CEB_WM_NXT, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the node
@@ -1258,223 +2190,2619 @@ struct ceb_node *_cebu_lookup_ge(struct ceb_node **root,
 static inline __attribute__((always_inline))
 struct ceb_node *_cebu_lookup_gt(struct ceb_node **root,
                                  ptrdiff_t kofs,
+                                 enum ceb_addr_mode am,
+                                 const void *base,
                                  enum ceb_key_type key_type,
                                  uint32_t key_u32,
                                  uint64_t key_u64,
                                  const void *key_ptr)
 {
 	struct ceb_node *ret = NULL;
-	struct ceb_node *restart;
+	struct ceb_node **restart, **subroot;
 
-	if (!*root)
+	if (!_ceb_ld(am, base, root))
 		return NULL;
 
-	ret = _cebu_descend(root, CEB_WM_KGT, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &restart);
+	ret = _cebu_descend(root, CEB_WM_KGT, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, NULL);
 	if (ret)
 		return ret;
 
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_FST, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
 	if (!restart)
 		return NULL;
 
-	return _cebu_descend(&restart, CEB_WM_NXT, kofs, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	return _cebu_descend(restart, CEB_WM_NXT, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
 
 /* Searches in the tree <root> made of keys of type <key_type>, for the node
- * that contains the key <key_*>, and deletes it. If <node> is non-NULL, a
- * check is performed and the node found is deleted only if it matches. The
- * found node is returned in any case, otherwise NULL if not found. A deleted
- * node is detected since it has b[0]==NULL, which this functions also clears
- * after operation. The function is idempotent, so it's safe to attempt to
- * delete an already deleted node (NULL is returned in this case since the node
- * was not in the tree).
+ * containing the key <key_*>, and for the nodes immediately below and above
+ * it, which are returned in <ret_prev> and <ret_next> (possibly NULL). Both
+ * neighbours are obtained from the same descent, which notes the last turns
+ * in each direction, and only continues from these points or from the leaf or
+ * subtree where the key would be. Returns the node matching the key, or NULL
+ * if not found.
  */
 static inline __attribute__((always_inline))
-struct ceb_node *_cebu_delete(struct ceb_node **root,
-                              struct ceb_node *node,
-                              ptrdiff_t kofs,
-                              enum ceb_key_type key_type,
-                              uint32_t key_u32,
-                              uint64_t key_u64,
-                              const void *key_ptr)
+struct ceb_node *_cebu_lookup_bracket(struct ceb_node **root,
+                                      ptrdiff_t kofs,
+                                      enum ceb_addr_mode am,
+                                      const void *base,
+                                      enum ceb_key_type key_type,
+                                      uint32_t key_u32,
+                                      uint64_t key_u64,
+                                      const void *key_ptr,
+                                      struct ceb_node **ret_prev,
+                                      struct ceb_node **ret_next)
 {
-	struct ceb_node *lparent, *nparent, *gparent;
-	int lpside, npside, gpside;
-	struct ceb_node *ret = NULL;
+	struct ceb_node *ret, *prev = NULL, *next = NULL;
+	struct ceb_node **back[2], **where;
+	int nside;
 
-	if (node && !node->b[0]) {
-		/* NULL on a branch means the node is not in the tree */
+	*ret_prev = *ret_next = NULL;
+	if (!_ceb_ld(am, base, root))
 		return NULL;
-	}
-
-	if (!*root) {
-		/* empty tree, the node cannot be there */
-		goto done;
-	}
 
-	ret = _cebu_descend(root, CEB_WM_KEQ, kofs, key_type, key_u32, key_u64, key_ptr, NULL, NULL,
-			    &lparent, &lpside, &nparent, &npside, &gparent, &gpside, NULL);
+	ret = _cebu_descend(root, CEB_WM_KBR, kofs, am, base, key_type, key_u32, key_u64, key_ptr, &nside, &where, NULL, NULL, NULL, NULL, NULL, NULL, back, NULL);
 
-	if (!ret) {
-		/* key not found */
-		goto done;
+	if (where) {
+		/* not found: the leaf or subtree is on one side of the key */
+		if (nside)
+			prev = ret ? ret : _cebu_descend(where, CEB_WM_LST, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+		else
+			next = ret ? ret : _cebu_descend(where, CEB_WM_FST, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+		ret = NULL;
 	}
 
-	if (ret == node || !node) {
-		if (&lparent->b[0] == root) {
-			/* there was a single entry, this one, so we're just
-			 * deleting the nodeless leaf.
-			 */
-			*root = NULL;
-			goto mark_and_leave;
-		}
-
-		/* then we necessarily have a gparent */
-		gparent->b[gpside] = lparent->b[!lpside];
-
-		if (lparent == ret) {
-			/* we're removing the leaf and node together, nothing
-			 * more to do.
-			 */
-			goto mark_and_leave;
-		}
-
-		if (ret->b[0] == ret->b[1]) {
-			/* we're removing the node-less item, the parent will
-			 * take this role.
-			 */
-			lparent->b[0] = lparent->b[1] = lparent;
-			goto mark_and_leave;
-		}
+	if (!prev && back[0])
+		prev = _cebu_descend(back[0], CEB_WM_PRV, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 
-		/* more complicated, the node was split from the leaf, we have
-		 * to find a spare one to switch it. The parent node is not
-		 * needed anymore so we can reuse it.
-		 */
-		lparent->b[0] = ret->b[0];
-		lparent->b[1] = ret->b[1];
-		nparent->b[npside] = lparent;
+	if (!next && back[1])
+		next = _cebu_descend(back[1], CEB_WM_NXT, kofs, am, base, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 
-	mark_and_leave:
-		/* now mark the node as deleted */
-		ret->b[0] = NULL;
-	}
-done:
+	*ret_prev = prev;
+	*ret_next = next;
 	return ret;
 }
 
-/*
- * Functions used to dump trees in Dot format.
+/* Searches in the tree <root> made of node addresses (CEB_KT_ADDR), each
+ * followed at <kofs> by the size of the object starting at the node, for the
+ * one whose object contains the address <key_ptr>. Since objects don't
+ * overlap, only the node closest below or at the address may contain it, so a
+ * single lookup_le descent followed by a bounds check is enough. Returns the
+ * node or NULL if no object contains the address.
  */
-
-/* dump the root and its link to the first node or leaf */
-__attribute__((unused))
-static void cebu_default_dump_root(ptrdiff_t kofs, enum ceb_key_type key_type, struct ceb_node *const *root, const void *ctx)
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_lookup_contains(struct ceb_node **root,
+                                       ptrdiff_t kofs,
+                                       enum ceb_addr_mode am,
+                                       const void *base,
+                                       const void *key_ptr)
 {
-	const struct ceb_node *node;
+	struct ceb_node *node;
 
-	printf("  \"%lx_n\" [label=\"root\\n%lx\"]\n", (long)root, (long)root);
+	node = _cebu_lookup_le(root, kofs, am, base, CEB_KT_ADDR, 0, 0, key_ptr);
+	if (!node || (uintptr_t)key_ptr - (uintptr_t)node >= NODEK(node, kofs)->sz)
+		return NULL;
+	return node;
+}
 
-	node = *root;
-	if (node) {
-		/* under the root we've either a node or the first leaf */
-		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"B\" arrowsize=0.66];\n",
-		       (long)root, (long)node,
-		       (node->b[0] == node->b[1]) ? 'l' : 'n');
-	}
+/* returns the string stored at <k> for string key types, read through the
+ * pointer for indirect ones.
+ */
+static inline __attribute__((always_inline))
+const unsigned char *_ceb_skey(enum ceb_key_type key_type, const union ceb_key_storage *k)
+{
+	if (key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+		return k->ptr;
+	return k->str;
 }
 
-/* dump a node */
-__attribute__((unused))
-static void cebu_default_dump_node(ptrdiff_t kofs, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx)
+/* Searches in the tree <root> made of strings (CEB_KT_ST, IS, SI or ISI) for
+ * the smallest subtree holding all the keys starting with the NUL-terminated
+ * prefix <key_ptr>. The descent stops at the first node whose branches have at
+ * least as many bits in common as the prefix, since they are then common to
+ * all keys below. It returns the location of the pointer to this subtree, or
+ * NULL if no key starts with the prefix. When the subtree is made of a single
+ * leaf, this one is also returned in <ret_leaf> since its branches belong to
+ * its node located above and do not describe the subtree, otherwise NULL is
+ * returned there. Walking from a subtree location that isn't a leaf works the
+ * same as from the root, thus without having to re-descend the whole tree.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node **_cebu_lookup_prefix(struct ceb_node **root,
+                                      ptrdiff_t kofs,
+                                      enum ceb_addr_mode am,
+                                      const void *base,
+                                      enum ceb_key_type key_type,
+                                      const void *key_ptr,
+                                      struct ceb_node **ret_leaf)
 {
-	unsigned long long int_key = 0;
-	uint64_t pxor, lxor, rxor;
+	struct ceb_node *p, *lb, *rb;
+	union ceb_key_storage *l, *r;
+	size_t pbits = strlen(key_ptr) * 8;
+	size_t plen = 0;  // previous common len between branches
+	size_t xlen;      // left vs right matching length
+	size_t llen, rlen;
 
-	switch (key_type) {
-	case CEB_KT_ADDR:
-		int_key = (uintptr_t)node;
-		break;
-	case CEB_KT_U32:
-		int_key = NODEK(node, kofs)->u32;
-		break;
-	case CEB_KT_U64:
-		int_key = NODEK(node, kofs)->u64;
-		break;
-	default:
-		break;
-	}
+	*ret_leaf = NULL;
+	if (!_ceb_ld(am, base, root))
+		return NULL;
 
-	/* xor of the keys of the two lower branches */
-	pxor = _xor_branches(kofs, key_type, 0, 0, NULL,
-			     node->b[0], node->b[1]);
+	while (1) {
+		p = _ceb_ldb(am, base, root);
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+		l = NODEK(lb, kofs);
+		r = NODEK(rb, kofs);
 
-	/* xor of the keys of the left branch's lower branches */
+		/* two equal pointers identifies the nodeless leaf. */
+		if (l == r)
+			break;
+
+		xlen = _ceb_str_equal_bits(key_type, _ceb_skey(key_type, l), 0, _ceb_skey(key_type, r), 0);
+		if (xlen < plen)
+			break;
+
+		/* a negative length is an equal string, hence an infinite one */
+		llen = _ceb_str_equal_bits(key_type, key_ptr, 0, _ceb_skey(key_type, l), 0);
+		if (xlen >= pbits)
+			return (llen >= pbits) ? root : NULL;
+
+		rlen = _ceb_str_equal_bits(key_type, key_ptr, 0, _ceb_skey(key_type, r), 0);
+		if (llen < xlen && rlen < xlen)
+			return NULL;
+
+		root = _ceb_br(am, p, llen <= rlen);
+		plen = xlen;
+
+		if (p == _ceb_ldb(am, base, root)) {
+			/* loops over itself, it's a leaf */
+			break;
+		}
+	}
+
+	if (_ceb_str_equal_bits(key_type, key_ptr, 0, _ceb_skey(key_type, NODEK(p, kofs)), 0) < pbits)
+		return NULL;
+
+	*ret_leaf = p;
+	return root;
+}
+
+/* Returns a node randomly picked in the tree <root> made of 32/64-bit scalars
+ * or strings (CEB_KT_ST, IS, SI or ISI), or NULL if the tree is empty. The
+ * descent takes at each node the branch designated by the next bit returned
+ * by <rnd> called with <arg>, which consumes one call per 32 nodes. Each node
+ * is then picked with probability 2^-depth, which favors those located close
+ * to the root. When <depth> is not zero, the descent virtually continues below
+ * the leaf down to this depth, and starts over if any of these extra bits is a
+ * one. All nodes not deeper than <depth> then have the same probability, at
+ * the expense of about 2^depth/nodes descents on average. A value slightly
+ * larger than log2 of the number of nodes is a good compromise. Deeper nodes
+ * remain less likely to be picked.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_lookup_random(struct ceb_node **root,
+                                     ptrdiff_t kofs,
+                                     enum ceb_addr_mode am,
+                                     const void *base,
+                                     enum ceb_key_type key_type,
+                                     uint32_t (*rnd)(void *arg),
+                                     void *arg,
+                                     unsigned int depth)
+{
+	struct ceb_node **pos;
+	struct ceb_node *p, *lb, *rb;
+	union ceb_key_storage *l, *r;
+	uint64_t pxor, xor;  // previous and current xor between scalar branches
+	size_t plen, xlen;   // previous and current common len between strings
+	uint32_t bits = 0;   // random bits not consumed yet
+	unsigned int nbits = 0;
+	unsigned int d;
+	int side;
+
+	if (!_ceb_ld(am, base, root))
+		return NULL;
+
+	while (1) {
+		pos = root;
+		pxor = ~0ULL;
+		plen = 0;
+		d = 0;
+
+		while (1) {
+			p = _ceb_ldb(am, base, pos);
+			lb = _ceb_getb(am, base, p, 0);
+			rb = _ceb_getb(am, base, p, 1);
+			l = NODEK(lb, kofs);
+			r = NODEK(rb, kofs);
+
+			/* two equal pointers identifies the nodeless leaf. */
+			if (l == r)
+				break;
+
+			if (key_type == CEB_KT_ST || key_type == CEB_KT_IS ||
+			    key_type == CEB_KT_SI || key_type == CEB_KT_ISI) {
+				xlen = _ceb_str_equal_bits(key_type, _ceb_skey(key_type, l), 0, _ceb_skey(key_type, r), 0);
+				if (xlen < plen)
+					break;
+				plen = xlen;
+			}
+			else {
+				xor = _ceb_kscalar(key_type, l) ^ _ceb_kscalar(key_type, r);
+				if (xor > pxor)
+					break;
+				pxor = xor;
+			}
+
+			if (!nbits) {
+				bits = rnd(arg);
+				nbits = 32;
+			}
+
+			side = bits & 1;
+			bits >>= 1;
+			nbits--;
+			d++;
+
+			pos = _ceb_br(am, p, side);
+
+			if (p == _ceb_ldb(am, base, pos)) {
+				/* loops over itself, it's a leaf */
+				break;
+			}
+		}
+
+		/* bias correction: go on with virtual left branches */
+		for (; d < depth; d++) {
+			if (!nbits) {
+				bits = rnd(arg);
+				nbits = 32;
+			}
+			side = bits & 1;
+			bits >>= 1;
+			nbits--;
+			if (side)
+				break;
+		}
+
+		if (d >= depth)
+			return p;
+	}
+}
+
+/* Estimates the number of nodes whose key lies between <lo> and <hi>
+ * inclusive in the tree <root> made of 32/64-bit unsigned scalars. The key
+ * range covered by a node is given by its split bit, so only the subtrees
+ * crossing a boundary of the range are explored, as well as the <depth> first
+ * levels of those entirely within the range. Below this depth, the size of
+ * each remaining subtree is estimated with Knuth's method: one random descent
+ * ending at depth d stands for 2^d nodes, which is exact on average. Large
+ * depths thus make the result exact at the expense of visiting more nodes.
+ * Since the split bits are strictly decreasing along a descent, the stack
+ * never holds more than one pending branch per level.
+ */
+static inline __attribute__((always_inline))
+size_t _cebu_count_estimate(struct ceb_node **root,
+                            ptrdiff_t kofs,
+                            enum ceb_addr_mode am,
+                            const void *base,
+                            enum ceb_key_type key_type,
+                            uint64_t lo,
+                            uint64_t hi,
+                            unsigned int depth)
+{
+	struct {
+		struct ceb_node **pos;
+		uint64_t pxor;    // xor between the parent's branches
+		unsigned int lvl; // exact levels left, or ~0 for boundaries
+	} stk[66];
+	struct ceb_node **pos;
+	struct ceb_node *p, *lb, *rb;
+	union ceb_key_storage *l, *r;
+	uint64_t pxor, xor, kl, kr, mask;
+	uint32_t seed = 2463534242U; // random bits for the descents
+	uint64_t count = 0;
+	unsigned int lvl, d;
+	int side, sp = 0;
+
+	if (!_ceb_ld(am, base, root) || lo > hi)
+		return 0;
+
+	stk[sp].pos = root;
+	stk[sp].pxor = ~0ULL;
+	stk[sp].lvl = ~0U;
+	sp++;
+
+	while (sp) {
+		sp--;
+		pos = stk[sp].pos;
+		pxor = stk[sp].pxor;
+		lvl = stk[sp].lvl;
+
+		p = _ceb_ldb(am, base, pos);
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+		l = NODEK(lb, kofs);
+		r = NODEK(rb, kofs);
+		kl = _ceb_kscalar(key_type, l);
+		kr = _ceb_kscalar(key_type, r);
+		xor = kl ^ kr;
+
+		/* two equal pointers identifies the nodeless leaf, and a larger
+		 * xor than the parent's one a leaf designating a node above.
+		 */
+		if (l == r || xor > pxor) {
+			kl = _ceb_kscalar(key_type, NODEK(p, kofs));
+			count += kl >= lo && kl <= hi;
+			continue;
+		}
+
+		if (lvl == ~0U) {
+			/* all keys below share the bits above the split one */
+			mask = ~0ULL >> (64 - flsnz64(xor));
+			if ((kl | mask) < lo || (kl & ~mask) > hi)
+				continue;
+			if ((kl & ~mask) >= lo && (kl | mask) <= hi)
+				lvl = depth;
+		}
+
+		if (!lvl) {
+			/* random descent from there to a leaf */
+			for (d = 0; ; d++) {
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				pos = _ceb_br(am, p, seed & 1);
+				if (p == _ceb_ldb(am, base, pos)) {
+					/* loops over itself, it's a leaf */
+					break;
+				}
+
+				pxor = xor;
+				p = _ceb_ldb(am, base, pos);
+				lb = _ceb_getb(am, base, p, 0);
+				rb = _ceb_getb(am, base, p, 1);
+				l = NODEK(lb, kofs);
+				r = NODEK(rb, kofs);
+				if (l == r)
+					break;
+
+				xor = _ceb_kscalar(key_type, l) ^ _ceb_kscalar(key_type, r);
+				if (xor > pxor)
+					break;
+			}
+			count += (d < 63) ? 2ULL << d : ~0ULL >> 1;
+			continue;
+		}
+
+		for (side = 1; side >= 0; side--) {
+			pos = _ceb_br(am, p, side);
+			if (p == _ceb_ldb(am, base, pos)) {
+				/* loops over itself, it's a leaf */
+				kl = _ceb_kscalar(key_type, NODEK(p, kofs));
+				count += kl >= lo && kl <= hi;
+				continue;
+			}
+			stk[sp].pos = pos;
+			stk[sp].pxor = xor;
+			stk[sp].lvl = (lvl == ~0U) ? lvl : lvl - 1;
+			sp++;
+		}
+	}
+
+	return count;
+}
+
+/* Returns the number of equal leading bits between the prefixes stored at <a>
+ * and <b> for prefix key types (CEB_KT_PB, CEB_KT_P32), or a negative number
+ * if they are equal.
+ */
+static inline __attribute__((always_inline))
+size_t _ceb_pfx_equal_bits(enum ceb_key_type key_type, const union ceb_key_storage *a, const union ceb_key_storage *b)
+{
+	uint64_t x;
+
+	if (key_type == CEB_KT_PB)
+		return prefix_equal_bits(a->pfx.data, a->pfx.plen, b->pfx.data, b->pfx.plen);
+
+	x = _ceb_k64(key_type, a) ^ _ceb_k64(key_type, b);
+	return x ? 33 - flsnz64(x) : (size_t)-1;
+}
+
+/* Same as above between the address <key_*> taken as a prefix of <key_len>
+ * bits and the prefix stored at <b>. For CEB_KT_P32, the address is passed
+ * encoded in key_u64.
+ */
+static inline __attribute__((always_inline))
+size_t _ceb_pfx_key_equal_bits(enum ceb_key_type key_type, uint64_t key_u64, const void *key_ptr, size_t key_len,
+                               const union ceb_key_storage *b)
+{
+	uint64_t x;
+
+	if (key_type == CEB_KT_PB)
+		return prefix_equal_bits(key_ptr, key_len, b->pfx.data, b->pfx.plen);
+
+	x = key_u64 ^ _ceb_k64(key_type, b);
+	return x ? 33 - flsnz64(x) : (size_t)-1;
+}
+
+/* Returns the bit at position <pos> of the address <key_*> of <key_len> bits
+ * taken as a prefix, as well as in <ret_last> the position of the last one
+ * strictly before it, or -1 if there is none.
+ */
+static inline __attribute__((always_inline))
+int _ceb_pfx_key_bit(enum ceb_key_type key_type, uint64_t key_u64, const void *key_ptr, size_t key_len,
+                     size_t pos, long *ret_last)
+{
+	uint64_t v;
+
+	if (key_type == CEB_KT_PB) {
+		*ret_last = prefix_last_one(key_ptr, key_len, pos);
+		return prefix_get_bit(key_ptr, key_len, pos);
+	}
+
+	/* the 33-bit encoding has prefix bit 0 on bit 32, and splits between
+	 * different encodings never happen past prefix bit 32.
+	 */
+	v = key_u64 >> (33 - pos);
+	*ret_last = v ? (long)pos - (long)flsnz64(v & -v) : -1;
+	return (key_u64 >> (32 - pos)) & 1;
+}
+
+/* Descends the tree <root> of prefixes (CEB_KT_PB or CEB_KT_P32) towards the
+ * address <key_*> of <key_len> bits, which is seen as a prefix of this length.
+ * At each node, all prefixes of the address are located on the branch the
+ * address takes, except at most one on the other branch, whose length is
+ * deduced from the split bit: if the address has a zero there, it's the prefix
+ * ending just before it, otherwise it's the one ending before the last one of
+ * the address preceding the split bit. The same applies at the bit where the
+ * address leaves the tree. The longest of these prefix lengths that's lower
+ * than <bound> is returned in <ret_cand>, or -1 if none. The function returns
+ * the leaf the address leads to, or NULL if it leaves the tree earlier. It
+ * must not be called on an empty tree.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_longest_descend(struct ceb_node **root,
+                                       ptrdiff_t kofs,
+                                       enum ceb_addr_mode am,
+                                       const void *base,
+                                       enum ceb_key_type key_type,
+                                       uint64_t key_u64,
+                                       const void *key_ptr,
+                                       size_t key_len,
+                                       long bound,
+                                       long *ret_cand)
+{
+	struct ceb_node *p, *lb, *rb;
+	union ceb_key_storage *l, *r;
+	size_t plen = 0;  // previous common len between branches
+	size_t xlen;      // left vs right matching length
+	size_t llen, rlen;
+	long cand = -1;
+	long last, m;
+	int side;
+
+	while (1) {
+		p = _ceb_ldb(am, base, root);
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+
+		__builtin_prefetch(_ceb_getb(am, base, lb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, lb, 1), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 1), 0);
+
+		l = NODEK(lb, kofs);
+		r = NODEK(rb, kofs);
+
+		/* two equal pointers identifies the nodeless leaf. */
+		if (l == r)
+			break;
+
+		xlen = _ceb_pfx_equal_bits(key_type, l, r);
+		if (xlen < plen)
+			break;
+
+		llen = _ceb_pfx_key_equal_bits(key_type, key_u64, key_ptr, key_len, l);
+		rlen = _ceb_pfx_key_equal_bits(key_type, key_u64, key_ptr, key_len, r);
+		if (llen < xlen && rlen < xlen) {
+			/* the address leaves the tree there */
+			xlen = (llen > rlen) ? llen : rlen;
+			p = NULL;
+		}
+
+		side = _ceb_pfx_key_bit(key_type, key_u64, key_ptr, key_len, xlen, &last);
+		m = side ? last : (long)xlen;
+		if (m > cand && m < bound && (size_t)m <= key_len)
+			cand = m;
+
+		if (!p)
+			break;
+
+		root = _ceb_br(am, p, side);
+		plen = xlen;
+
+		if (p == _ceb_ldb(am, base, root)) {
+			/* loops over itself, it's a leaf */
+			break;
+		}
+	}
+
+	*ret_cand = cand;
+	return p;
+}
+
+/* Searches in the tree <root> of prefixes (CEB_KT_PB or CEB_KT_P32) for the
+ * longest one matching the address <key_*>. For CEB_KT_PB, the address is in
+ * key_ptr and its length in bits in key_u64. For CEB_KT_P32, it's the 32-bit
+ * word in key_u32. The leaf the address leads to is the only prefix the
+ * descent can confirm by itself, and the other candidates reported by
+ * _cebu_longest_descend() are checked with exact lookups in descending length
+ * order, as long as they are longer than the leaf. Returns NULL if no prefix
+ * matches.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_lookup_longest(struct ceb_node **root,
+                                      ptrdiff_t kofs,
+                                      enum ceb_addr_mode am,
+                                      const void *base,
+                                      enum ceb_key_type key_type,
+                                      uint32_t key_u32,
+                                      uint64_t key_u64,
+                                      const void *key_ptr)
+{
+	struct ceb_node *leaf, *ret;
+	union ceb_key_storage *k;
+	size_t key_len = key_u64;
+	long cand, lp = -1;
+
+	if (!_ceb_ld(am, base, root))
+		return NULL;
+
+	if (key_type == CEB_KT_P32) {
+		key_len = 32;
+		key_u64 = _ceb_p32_enc(key_u32, 32);
+	}
+
+	leaf = _cebu_longest_descend(root, kofs, am, base, key_type, key_u64, key_ptr, key_len, (long)key_len + 1, &cand);
+	if (leaf) {
+		k = NODEK(leaf, kofs);
+		if (key_type == CEB_KT_PB) {
+			if (k->pfx.plen <= key_len && equal_bits(key_ptr, k->pfx.data, 0, k->pfx.plen) >= k->pfx.plen)
+				lp = k->pfx.plen;
+		}
+		else if (_ceb_p32_enc(key_u32, k->p32.plen) == _ceb_k64(key_type, k))
+			lp = k->p32.plen;
+	}
+
+	while (cand > lp) {
+		if (key_type == CEB_KT_PB)
+			ret = _cebu_descend(root, CEB_WM_KEQ, kofs, am, base, key_type, 0, cand, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+		else
+			ret = _cebu_descend(root, CEB_WM_KEQ, kofs, am, base, key_type, 0, _ceb_p32_enc(key_u32, cand), NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+		if (ret)
+			return ret;
+		_cebu_longest_descend(root, kofs, am, base, key_type, key_u64, key_ptr, key_len, cand, &cand);
+	}
+
+	return (lp >= 0) ? leaf : NULL;
+}
+
+/* Searches in the tree <root> made of keys of type <key_type> (32/64-bit
+ * scalars or CEB_KT_MB) for nodes by ascending XOR distance to the key
+ * <key_*>. Since all keys on one side of a node share the split bit, all
+ * those on the side matching the key's bit are closer to the key than those
+ * on the other side, whatever the upper bits. Thus taking the key's side at
+ * each node leads to the closest key in a single descent, without having to
+ * check for mismatches. If <ref> is NULL, this closest node is returned.
+ * Otherwise, <ref> must be a node of the tree, and the node following it by
+ * distance to the key is returned, or NULL if there is none: it's the closest
+ * one below the other side of the last node where <ref> is on the key's side.
+ * Distances are all different since keys are unique.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_xor_nearest(struct ceb_node **root,
+                                   ptrdiff_t kofs,
+                                   enum ceb_addr_mode am,
+                                   const void *base,
+                                   enum ceb_key_type key_type,
+                                   uint32_t key_u32,
+                                   uint64_t key_u64,
+                                   const void *key_ptr,
+                                   const struct ceb_node *ref)
+{
+	const union ceb_key_storage *rk = ref ? NODEK(ref, kofs) : NULL;
+	const uint64_t key = _ceb_kt_is32(key_type) ? key_u32 : key_u64;
+	uint64_t rkey = 0;
+	struct ceb_node *p, *lb, *rb;
+	struct ceb_node *bp = NULL; // last node where <ref> is on the key's side
+	union ceb_key_storage *l, *r;
+	uint64_t pxor = ~0ULL;      // previous xor between branches
+	uint64_t bxor = 0;          // pxor at <bp>
+	uint64_t kl, kr, xor;
+	size_t plen = 0;            // previous common len between branches
+	size_t blen = 0;            // plen at <bp>
+	size_t xlen;
+	int side, rside, bside = 0;
+
+	if (!_ceb_ld(am, base, root))
+		return NULL;
+
+	if (rk && key_type != CEB_KT_MB)
+		rkey = _ceb_kscalar(key_type, rk);
+
+	while (1) {
+		while (1) {
+			p = _ceb_ldb(am, base, root);
+			lb = _ceb_getb(am, base, p, 0);
+			rb = _ceb_getb(am, base, p, 1);
+
+			__builtin_prefetch(_ceb_getb(am, base, lb, 0), 0);
+			__builtin_prefetch(_ceb_getb(am, base, lb, 1), 0);
+			__builtin_prefetch(_ceb_getb(am, base, rb, 0), 0);
+			__builtin_prefetch(_ceb_getb(am, base, rb, 1), 0);
+
+			l = NODEK(lb, kofs);
+			r = NODEK(rb, kofs);
+
+			/* two equal pointers identifies the nodeless leaf. */
+			if (l == r)
+				break;
+
+			if (key_type == CEB_KT_MB) {
+				xlen = equal_bits(l->mb, r->mb, 0, key_u64 << 3);
+				if (xlen < plen)
+					break;
+				side = get_bit(key_ptr, xlen);
+				rside = rk ? get_bit(rk->mb, xlen) : side;
+				plen = xlen;
+			}
+			else {
+				kl = _ceb_kscalar(key_type, l);
+				kr = _ceb_kscalar(key_type, r);
+				xor = kl ^ kr;
+				if (xor > pxor)
+					break;
+				side = (key ^ kl) > (key ^ kr);
+				rside = rk ? (rkey ^ kl) > (rkey ^ kr) : side;
+				pxor = xor;
+			}
+
+			if (rk && rside == side) {
+				bp = p;
+				bside = side;
+				bxor = pxor;
+				blen = plen;
+			}
+
+			root = _ceb_br(am, p, rside);
+			if (p == _ceb_ldb(am, base, root)) {
+				/* loops over itself, it's a leaf */
+				break;
+			}
+		}
+
+		if (!rk)
+			return p;
+
+		if (!bp)
+			return NULL;
+
+		/* now look for the closest node on the other side of <bp> */
+		rk = NULL;
+		pxor = bxor;
+		plen = blen;
+		root = _ceb_br(am, bp, !bside);
+		if (bp == _ceb_ldb(am, base, root))
+			return bp;
+	}
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the node
+ * that contains the key <key_*>, and deletes it. If <node> is non-NULL, a
+ * check is performed and the node found is deleted only if it matches. The
+ * found node is returned in any case, otherwise NULL if not found. A deleted
+ * node is detected since it has b[0]==NULL, which this functions also clears
+ * after operation. The function is idempotent, so it's safe to attempt to
+ * delete an already deleted node (NULL is returned in this case since the node
+ * was not in the tree).
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_delete(struct ceb_node **root,
+                              struct ceb_node *node,
+                              ptrdiff_t kofs,
+                              enum ceb_addr_mode am,
+                              const void *base,
+                              enum ceb_key_type key_type,
+                              uint32_t key_u32,
+                              uint64_t key_u64,
+                              const void *key_ptr)
+{
+	struct ceb_node *lparent, *nparent, *gparent;
+	int lpside, npside, gpside;
+	struct ceb_node *ret = NULL;
+
+	if (node && !_ceb_ld(am, base, _ceb_br(am, node, 0))) {
+		/* NULL on a branch means the node is not in the tree */
+		return NULL;
+	}
+
+	if (!_ceb_ld(am, base, root)) {
+		/* empty tree, the node cannot be there */
+		goto done;
+	}
+
+	ret = _cebu_descend(root, CEB_WM_KEQ, kofs, am, base, key_type, key_u32, key_u64, key_ptr, NULL, NULL,
+			    &lparent, &lpside, &nparent, &npside, &gparent, &gpside, NULL, NULL);
+
+	if (!ret) {
+		/* key not found */
+		goto done;
+	}
+
+	if (ret == node || !node) {
+		if (_ceb_br(am, lparent, 0) == root) {
+			/* there was a single entry, this one, so we're just
+			 * deleting the nodeless leaf.
+			 */
+			_ceb_st(am, base, root, NULL);
+			goto mark_and_leave;
+		}
+
+		/* then we necessarily have a gparent */
+		_ceb_setb(am, base, gparent, gpside, _ceb_getb(am, base, lparent, !lpside));
+
+		if (lparent == ret) {
+			/* we're removing the leaf and node together, nothing
+			 * more to do.
+			 */
+			goto mark_and_leave;
+		}
+
+		if (_ceb_getb(am, base, ret, 0) == _ceb_getb(am, base, ret, 1)) {
+			/* we're removing the node-less item, the parent will
+			 * take this role.
+			 */
+			_ceb_setb(am, base, lparent, 0, lparent);
+			_ceb_setb(am, base, lparent, 1, lparent);
+			goto mark_and_leave;
+		}
+
+		/* more complicated, the node was split from the leaf, we have
+		 * to find a spare one to switch it. The parent node is not
+		 * needed anymore so we can reuse it.
+		 */
+		_ceb_setb(am, base, lparent, 0, _ceb_getb(am, base, ret, 0));
+		_ceb_setb(am, base, lparent, 1, _ceb_getb(am, base, ret, 1));
+		_ceb_setb(am, base, nparent, npside, lparent);
+
+	mark_and_leave:
+		/* now mark the node as deleted */
+		_ceb_st(am, base, _ceb_br(am, ret, 0), NULL);
+	}
+done:
+	return ret;
+}
+
+/*
+ * Functions below are used by trees supporting duplicate keys. Duplicates are
+ * stored in a list attached to the leaf of the first inserted node holding
+ * the key (N). This leaf is then referenced by a tagged pointer to the last
+ * duplicate (Dn), whose branches are not used as a node since duplicates
+ * never have a node role:
+ *   - each duplicate's b[0] points to the previous element in insertion
+ *     order, i.e. to the previous duplicate with a tagged pointer, or to N
+ *     with an untagged pointer for the first duplicate (D1) ;
+ *   - each duplicate's b[1] points to the next duplicate with a tagged
+ *     pointer, except for the last one which points to D1.
+ * Thus D1 is always untag(Dn->b[1]) and N is always untag(Dn->b[1])->b[0].
+ * Only the node N may hold a node role, and only leaf pointers may be tagged.
+ * Elements of a list are visited in insertion order by next(), starting with
+ * N. Deleting N promotes D1 to replace it in both its node and leaf roles.
+ */
+
+/* Generic tree insertion function for trees with duplicate keys. Inserts node
+ * <node> into tree <tree>, with key type <key_type> and key <key_*>. If a node
+ * with the same key already exists, the new node is appended at the end of
+ * its list of duplicates. Returns the inserted node.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_insert(struct ceb_node **root,
+                             struct ceb_node *node,
+                             ptrdiff_t kofs,
+                             enum ceb_key_type key_type,
+                             uint32_t key_u32,
+                             uint64_t key_u64,
+                             const void *key_ptr)
+{
+	struct ceb_node **parent;
+	struct ceb_node *ret;
+	int nside;
+	int is_dup;
+
+	if (!*root) {
+		/* empty tree, insert a leaf only */
+		node->b[0] = node->b[1] = node;
+		*root = node;
+		return node;
+	}
+
+	ret = _cebu_descend(root, CEB_WM_KEQ, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, &nside, &parent, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+
+	if (!ret) {
+		/* The key was not in the tree, we can insert it like in a
+		 * unique tree.
+		 */
+		if (nside) {
+			node->b[1] = node;
+			node->b[0] = *parent;
+		} else {
+			node->b[0] = node;
+			node->b[1] = *parent;
+		}
+		*parent = node;
+	}
+	else if (is_dup) {
+		/* <parent> designates the tagged pointer to the last dup,
+		 * we're appending after it.
+		 */
+		struct ceb_node *last = __ceb_clrtag(*parent);
+
+		node->b[0] = *parent;
+		node->b[1] = last->b[1];
+		last->b[1] = __ceb_dotag(node);
+		*parent = __ceb_dotag(node);
+	}
+	else {
+		/* first duplicate, <parent> points to the leaf */
+		node->b[0] = *parent;
+		node->b[1] = __ceb_dotag(node);
+		*parent = __ceb_dotag(node);
+	}
+	return node;
+}
+
+/* Returns the first node or NULL if not found, assuming a tree made of keys of
+ * type <key_type>, possibly with duplicates.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_first(struct ceb_node **root,
+                            ptrdiff_t kofs,
+                            enum ceb_key_type key_type)
+{
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	return _cebu_descend(root, CEB_WM_FST, kofs, CEB_AM_ABS, NULL, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Returns the last node or NULL if not found, assuming a tree made of keys of
+ * type <key_type>, possibly with duplicates.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_last(struct ceb_node **root,
+                           ptrdiff_t kofs,
+                           enum ceb_key_type key_type)
+{
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	return _cebu_descend(root, CEB_WM_LST, kofs, CEB_AM_ABS, NULL, key_type, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the next
+ * node after <node> which contains the key <key_*>. Returns NULL if not found.
+ * It's up to the caller to pass the current node's key in <key_*>. If the node
+ * is not the last of its list of duplicates, the next one in the list is
+ * returned, otherwise the first node of the next key is looked up like in
+ * unique trees.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_next(struct ceb_node **root,
+                           ptrdiff_t kofs,
+                           enum ceb_key_type key_type,
+                           uint32_t key_u32,
+                           uint64_t key_u64,
+                           const void *key_ptr,
+                           const struct ceb_node *node)
+{
+	struct ceb_node **restart;
+	struct ceb_node **parent;
+	struct ceb_node *first;
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	first = _cebu_descend(root, CEB_WM_KNX, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &parent, NULL, NULL, NULL, NULL, NULL, NULL, &restart, &is_dup);
+	if (!first)
+		return NULL;
+
+	if (is_dup) {
+		struct ceb_node *last = __ceb_clrtag(*parent);
+
+		if (node == first)
+			return __ceb_clrtag(last->b[1]);
+		if (node != last)
+			return __ceb_clrtag(node->b[1]);
+	}
+
+	if (!restart)
+		return NULL;
+
+	return _cebu_descend(restart, CEB_WM_NXT, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the prev
+ * node before <node> which contains the key <key_*>. Returns NULL if not
+ * found. It's up to the caller to pass the current node's key in <key_*>. If
+ * the node is a duplicate, the previous one in the list is returned, otherwise
+ * the last node of the previous key is looked up like in unique trees.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_prev(struct ceb_node **root,
+                           ptrdiff_t kofs,
+                           enum ceb_key_type key_type,
+                           uint32_t key_u32,
+                           uint64_t key_u64,
+                           const void *key_ptr,
+                           const struct ceb_node *node)
+{
+	struct ceb_node **restart;
+	struct ceb_node **parent;
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	if (!_cebu_descend(root, CEB_WM_KPR, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &parent, NULL, NULL, NULL, NULL, NULL, NULL, &restart, &is_dup))
+		return NULL;
+
+	if (is_dup) {
+		struct ceb_node *last = __ceb_clrtag(*parent);
+
+		if (node != __ceb_clrtag(last->b[1])->b[0])
+			return __ceb_clrtag(node->b[0]);
+	}
+
+	if (!restart)
+		return NULL;
+
+	return _cebu_descend(restart, CEB_WM_PRV, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the first
+ * node containing the key <key_*>. Returns NULL if not found.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_lookup(struct ceb_node **root,
+                             ptrdiff_t kofs,
+                             enum ceb_key_type key_type,
+                             uint32_t key_u32,
+                             uint64_t key_u64,
+                             const void *key_ptr)
+{
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	return _cebu_descend(root, CEB_WM_KEQ, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the last
+ * node containing the key <key_*> or the highest one that's lower than it.
+ * Returns NULL if not found.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_lookup_le(struct ceb_node **root,
+                                ptrdiff_t kofs,
+                                enum ceb_key_type key_type,
+                                uint32_t key_u32,
+                                uint64_t key_u64,
+                                const void *key_ptr)
+{
+	struct ceb_node *ret = NULL;
+	struct ceb_node **restart, **subroot;
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	ret = _cebu_descend(root, CEB_WM_KLE, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, &is_dup);
+	if (ret)
+		return ret;
+
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_LST, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+
+	if (!restart)
+		return NULL;
+
+	return _cebu_descend(restart, CEB_WM_PRV, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the last
+ * node containing the greatest key that is strictly lower than <key_*>.
+ * Returns NULL if not found.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_lookup_lt(struct ceb_node **root,
+                                ptrdiff_t kofs,
+                                enum ceb_key_type key_type,
+                                uint32_t key_u32,
+                                uint64_t key_u64,
+                                const void *key_ptr)
+{
+	struct ceb_node *ret = NULL;
+	struct ceb_node **restart, **subroot;
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	ret = _cebu_descend(root, CEB_WM_KLT, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, &is_dup);
+	if (ret)
+		return ret;
+
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_LST, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+
+	if (!restart)
+		return NULL;
+
+	return _cebu_descend(restart, CEB_WM_PRV, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the first
+ * node containing the key <key_*> or the smallest one that's greater than it.
+ * Returns NULL if not found.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_lookup_ge(struct ceb_node **root,
+                                ptrdiff_t kofs,
+                                enum ceb_key_type key_type,
+                                uint32_t key_u32,
+                                uint64_t key_u64,
+                                const void *key_ptr)
+{
+	struct ceb_node *ret = NULL;
+	struct ceb_node **restart, **subroot;
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	ret = _cebu_descend(root, CEB_WM_KGE, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, &is_dup);
+	if (ret)
+		return ret;
+
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_FST, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+
+	if (!restart)
+		return NULL;
+
+	return _cebu_descend(restart, CEB_WM_NXT, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the first
+ * node containing the lowest key that is strictly greater than <key_*>.
+ * Returns NULL if not found.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_lookup_gt(struct ceb_node **root,
+                                ptrdiff_t kofs,
+                                enum ceb_key_type key_type,
+                                uint32_t key_u32,
+                                uint64_t key_u64,
+                                const void *key_ptr)
+{
+	struct ceb_node *ret = NULL;
+	struct ceb_node **restart, **subroot;
+	int is_dup;
+
+	if (!*root)
+		return NULL;
+
+	ret = _cebu_descend(root, CEB_WM_KGT, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &subroot, NULL, NULL, NULL, NULL, NULL, NULL, &restart, &is_dup);
+	if (ret)
+		return ret;
+
+	if (subroot)
+		return _cebu_descend(subroot, CEB_WM_FST, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+
+	if (!restart)
+		return NULL;
+
+	return _cebu_descend(restart, CEB_WM_NXT, kofs, CEB_AM_ABS, NULL, key_type, 0, key_u64, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, &is_dup);
+}
+
+/* Searches in the tree <root> made of keys of type <key_type>, for the node
+ * that contains the key <key_*>, and deletes it. If <node> is non-NULL, this
+ * exact node is deleted from the list of nodes sharing this key, otherwise the
+ * first one is deleted. The deleted node is returned, otherwise NULL if not
+ * found. A deleted node is detected since it has b[0]==NULL, which this
+ * functions also clears after operation. The function is idempotent, so it's
+ * safe to attempt to delete an already deleted node (NULL is returned in this
+ * case since the node was not in the tree).
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_delete(struct ceb_node **root,
+                             struct ceb_node *node,
+                             ptrdiff_t kofs,
+                             enum ceb_key_type key_type,
+                             uint32_t key_u32,
+                             uint64_t key_u64,
+                             const void *key_ptr)
+{
+	struct ceb_node *lparent, *nparent, *gparent;
+	int lpside, npside, gpside;
+	struct ceb_node **parent;
+	struct ceb_node *ret = NULL;
+	struct ceb_node *last, *first;
+	int is_dup;
+
+	if (node && !node->b[0]) {
+		/* NULL on a branch means the node is not in the tree */
+		return NULL;
+	}
+
+	if (!*root) {
+		/* empty tree, the node cannot be there */
+		goto done;
+	}
+
+	ret = _cebu_descend(root, CEB_WM_KEQ, kofs, CEB_AM_ABS, NULL, key_type, key_u32, key_u64, key_ptr, NULL, &parent,
+			    &lparent, &lpside, &nparent, &npside, &gparent, &gpside, NULL, &is_dup);
+
+	if (!ret) {
+		/* key not found */
+		goto done;
+	}
+
+	if (is_dup) {
+		/* <ret> is the first node of the list and <parent> contains
+		 * the tagged pointer to the last one.
+		 */
+		last = __ceb_clrtag(*parent);
+
+		if (node && node != ret) {
+			/* we're deleting a duplicate, so this node has no
+			 * node role. Let's check it's really in this list
+			 * by verifying its neighbours point to it.
+			 */
+			if (node == last ? __ceb_clrtag(last->b[1])->b[0] != ret :
+			    __ceb_clrtag(node->b[1])->b[0] != __ceb_dotag(node)) {
+				ret = NULL;
+				goto done;
+			}
+
+			if (node == last) {
+				/* the previous element becomes the last one
+				 * (or the leaf again if it was the first).
+				 */
+				if (__ceb_tagged(node->b[0]))
+					__ceb_clrtag(node->b[0])->b[1] = node->b[1];
+				*parent = node->b[0];
+			} else {
+				__ceb_clrtag(node->b[1])->b[0] = node->b[0];
+				if (__ceb_tagged(node->b[0]))
+					__ceb_clrtag(node->b[0])->b[1] = node->b[1];
+				else
+					last->b[1] = node->b[1]; // new first dup
+			}
+			ret = node;
+			goto mark_and_leave;
+		}
+
+		/* We're deleting the first node, which holds the node part
+		 * and the leaf. The first dup will replace it in both roles.
+		 */
+		first = __ceb_clrtag(last->b[1]);
+		if (first != last) {
+			__ceb_clrtag(first->b[1])->b[0] = first;
+			last->b[1] = first->b[1];
+		}
+
+		if (ret->b[0] == ret->b[1]) {
+			/* node-less leaf */
+			first->b[0] = first->b[1] = first;
+		} else {
+			first->b[0] = ret->b[0];
+			first->b[1] = ret->b[1];
+			if (parent == &ret->b[0])
+				parent = &first->b[0];
+			else if (parent == &ret->b[1])
+				parent = &first->b[1];
+			nparent->b[npside] = first;
+		}
+
+		if (first == last)
+			*parent = first;
+		goto mark_and_leave;
+	}
+
+	if (ret == node || !node) {
+		if (&lparent->b[0] == root) {
+			/* there was a single entry, this one, so we're just
+			 * deleting the nodeless leaf.
+			 */
+			*root = NULL;
+			goto mark_and_leave;
+		}
+
+		/* then we necessarily have a gparent */
+		gparent->b[gpside] = lparent->b[!lpside];
+
+		if (lparent == ret) {
+			/* we're removing the leaf and node together, nothing
+			 * more to do.
+			 */
+			goto mark_and_leave;
+		}
+
+		if (ret->b[0] == ret->b[1]) {
+			/* we're removing the node-less item, the parent will
+			 * take this role.
+			 */
+			lparent->b[0] = lparent->b[1] = lparent;
+			goto mark_and_leave;
+		}
+
+		/* more complicated, the node was split from the leaf, we have
+		 * to find a spare one to switch it. The parent node is not
+		 * needed anymore so we can reuse it.
+		 */
+		lparent->b[0] = ret->b[0];
+		lparent->b[1] = ret->b[1];
+		nparent->b[npside] = lparent;
+	}
+	else {
+		/* not the node we were looking for */
+		ret = NULL;
+		goto done;
+	}
+
+ mark_and_leave:
+	/* now mark the node as deleted */
+	ret->b[0] = NULL;
+ done:
+	return ret;
+}
+
+/*
+ * Functions used to walk over whole trees.
+ */
+
+/* Returns a value which grows with the position of the split bit between the
+ * keys of nodes <lb> and <rb> of type <key_type>, for use by the walks to tell
+ * leaves from nodes. For scalars it's their xor, for 128-bit keys the position
+ * of the highest different bit, and for other types the complement of their
+ * number of equal bits, since these are compared from the first one. Fixed
+ * size memory blocks have their length in <key_u64>.
+ */
+static inline __attribute__((always_inline))
+uint64_t _ceb_walk_split(ptrdiff_t kofs, enum ceb_key_type key_type, uint64_t key_u64,
+                         const struct ceb_node *lb, const struct ceb_node *rb)
+{
+	const union ceb_key_storage *l = NODEK(lb, kofs);
+	const union ceb_key_storage *r = NODEK(rb, kofs);
+
+	if (key_type == CEB_KT_ADDR)
+		return (uintptr_t)lb ^ (uintptr_t)rb;
+	else if (_ceb_kt_is32(key_type))
+		return _ceb_k32(key_type, l) ^ _ceb_k32(key_type, r);
+	else if (_ceb_kt_is64(key_type))
+		return _ceb_k64(key_type, l) ^ _ceb_k64(key_type, r);
+	else if (key_type == CEB_KT_U128)
+		return _ceb_fls128(l->u128[0] ^ r->u128[0], l->u128[1] ^ r->u128[1]);
+	else if (key_type == CEB_KT_MB)
+		return ~(uint64_t)equal_bits(l->mb, r->mb, 0, key_u64 << 3);
+	else if (key_type == CEB_KT_IM)
+		return ~(uint64_t)equal_bits(l->ptr, r->ptr, 0, key_u64 << 3);
+	else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI ||
+		 key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+		return ~(uint64_t)_ceb_str_equal_bits(key_type, _ceb_skey(key_type, l), 0, _ceb_skey(key_type, r), 0);
+	else if (key_type == CEB_KT_VB)
+		return ~(uint64_t)vblock_equal_bits(l->vb.data, l->vb.len, r->vb.data, r->vb.len, 0);
+	else if (key_type == CEB_KT_PB)
+		return ~(uint64_t)prefix_equal_bits(l->pfx.data, l->pfx.plen, r->pfx.data, r->pfx.plen);
+	return 0;
+}
+
+/* Sets <key_*> to the key of node <node> of type <key_type>, as passed to
+ * lookups. Fixed size memory blocks must already have their length in
+ * <key_u64>.
+ */
+static inline __attribute__((always_inline))
+void _ceb_walk_node_key(ptrdiff_t kofs, enum ceb_key_type key_type, const struct ceb_node *node,
+                        uint32_t *key_u32, uint64_t *key_u64, const void **key_ptr)
+{
+	const union ceb_key_storage *k = NODEK(node, kofs);
+
+	if (key_type == CEB_KT_ADDR)
+		*key_ptr = node;
+	else if (_ceb_kt_is32(key_type))
+		*key_u32 = _ceb_k32(key_type, k);
+	else if (_ceb_kt_is64(key_type))
+		*key_u64 = _ceb_k64(key_type, k);
+	else if (key_type == CEB_KT_U128)
+		*key_ptr = k->u128;
+	else if (key_type == CEB_KT_MB)
+		*key_ptr = k->mb;
+	else if (key_type == CEB_KT_IM)
+		*key_ptr = k->ptr;
+	else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI ||
+		 key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+		*key_ptr = _ceb_skey(key_type, k);
+	else if (key_type == CEB_KT_VB) {
+		*key_ptr = k->vb.data;
+		*key_u64 = k->vb.len;
+	}
+	else if (key_type == CEB_KT_PB) {
+		*key_ptr = k->pfx.data;
+		*key_u64 = k->pfx.plen;
+	}
+}
+
+/* Returns the node following <node> in the tree <root> made of keys of type
+ * <key_type>, or the one preceding it if <back> is set, looked up using the
+ * node's key, or NULL if there is none. Fixed size memory blocks have their
+ * length in <key_u64>. This is the slow path of the walks and iterators, for
+ * trees too deep for their stack.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_walk_step(struct ceb_node **root,
+                                ptrdiff_t kofs,
+                                enum ceb_addr_mode am,
+                                const void *base,
+                                enum ceb_key_type key_type,
+                                uint64_t key_u64,
+                                const struct ceb_node *node,
+                                int dups,
+                                int back)
+{
+	const void *key_ptr = NULL;
+	uint32_t key_u32 = 0;
+
+	_ceb_walk_node_key(kofs, key_type, node, &key_u32, &key_u64, &key_ptr);
+
+	if (dups && back)
+		return _ceb_prev(root, kofs, key_type, key_u32, key_u64, key_ptr, node);
+	else if (dups)
+		return _ceb_next(root, kofs, key_type, key_u32, key_u64, key_ptr, node);
+	else if (back)
+		return _cebu_prev(root, kofs, am, base, key_type, key_u32, key_u64, key_ptr);
+	return _cebu_next(root, kofs, am, base, key_type, key_u32, key_u64, key_ptr);
+}
+
+/* Returns the same value as _ceb_walk_split() between the key <key_*> of type
+ * <key_type> and the key of node <node>. Fixed size memory blocks have their
+ * length in <key_u64>, and strings are NUL-terminated.
+ */
+static inline __attribute__((always_inline))
+uint64_t _ceb_walk_key_split(ptrdiff_t kofs, enum ceb_key_type key_type, uint32_t key_u32, uint64_t key_u64,
+                             const void *key_ptr, const struct ceb_node *node)
+{
+	const union ceb_key_storage *k = NODEK(node, kofs);
+
+	if (key_type == CEB_KT_ADDR)
+		return (uintptr_t)key_ptr ^ (uintptr_t)node;
+	else if (_ceb_kt_is32(key_type))
+		return key_u32 ^ _ceb_k32(key_type, k);
+	else if (_ceb_kt_is64(key_type))
+		return key_u64 ^ _ceb_k64(key_type, k);
+	else if (key_type == CEB_KT_U128)
+		return _ceb_fls128(((const uint64_t *)key_ptr)[0] ^ k->u128[0], ((const uint64_t *)key_ptr)[1] ^ k->u128[1]);
+	else if (key_type == CEB_KT_MB)
+		return ~(uint64_t)equal_bits(key_ptr, k->mb, 0, key_u64 << 3);
+	else if (key_type == CEB_KT_IM)
+		return ~(uint64_t)equal_bits(key_ptr, k->ptr, 0, key_u64 << 3);
+	else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI ||
+		 key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+		return ~(uint64_t)_ceb_str_equal_bits(key_type, key_ptr, 0, _ceb_skey(key_type, k), 0);
+	else if (key_type == CEB_KT_VB)
+		return ~(uint64_t)vblock_equal_bits(key_ptr, key_u64, k->vb.data, k->vb.len, 0);
+	else if (key_type == CEB_KT_PB)
+		return ~(uint64_t)prefix_equal_bits(key_ptr, key_u64, k->pfx.data, k->pfx.plen);
+	return 0;
+}
+
+/* Compares the key <key_*> of type <key_type> with the key of node <node>,
+ * and returns <0, 0 or >0 if the key is respectively lower than, equal to or
+ * greater than the node's, in the tree's order. Fixed size memory blocks have
+ * their length in <key_u64>, and strings are NUL-terminated.
+ */
+static inline __attribute__((always_inline))
+int _ceb_walk_key_cmp(ptrdiff_t kofs, enum ceb_key_type key_type, uint32_t key_u32, uint64_t key_u64,
+                      const void *key_ptr, const struct ceb_node *node)
+{
+	const union ceb_key_storage *k = NODEK(node, kofs);
+	uint64_t a, b;
+
+	if (key_type == CEB_KT_ADDR) {
+		a = (uintptr_t)key_ptr;
+		b = (uintptr_t)node;
+	}
+	else if (_ceb_kt_is32(key_type)) {
+		a = key_u32;
+		b = _ceb_k32(key_type, k);
+		if (key_type == CEB_KT_I32) {
+			a ^= 0x80000000U;
+			b ^= 0x80000000U;
+		}
+	}
+	else if (_ceb_kt_is64(key_type)) {
+		a = key_u64;
+		b = _ceb_k64(key_type, k);
+		if (key_type == CEB_KT_I64) {
+			a ^= 0x8000000000000000ULL;
+			b ^= 0x8000000000000000ULL;
+		}
+	}
+	else if (key_type == CEB_KT_U128)
+		return _ceb_cmp128(((const uint64_t *)key_ptr)[0], ((const uint64_t *)key_ptr)[1], k->u128[0], k->u128[1]);
+	else if (key_type == CEB_KT_MB)
+		return memcmp(key_ptr, k->mb, key_u64);
+	else if (key_type == CEB_KT_IM)
+		return memcmp(key_ptr, k->ptr, key_u64);
+	else if (key_type == CEB_KT_ST || key_type == CEB_KT_SI ||
+		 key_type == CEB_KT_IS || key_type == CEB_KT_ISI)
+		return _ceb_strcmp(key_type, key_ptr, 0, _ceb_skey(key_type, k), 0);
+	else if (key_type == CEB_KT_VB)
+		return vblock_cmp(key_ptr, key_u64, k->vb.data, k->vb.len, 0);
+	else if (key_type == CEB_KT_PB)
+		return prefix_cmp(key_ptr, key_u64, k->pfx.data, k->pfx.plen);
+	else
+		return 0;
+
+	return (a > b) - (a < b);
+}
+
+/* number of branches a walk may keep aside, enough for 128-bit keys */
+#define CEB_WALK_DEPTH 130
+
+/* Calls <cb> with <arg> for each node of the tree <root> made of keys of type
+ * <key_type> in ascending order, possibly with duplicates if <dups> is set.
+ * If <range> is set, only nodes whose key is within <lo_*> and <hi_*>
+ * inclusive are visited, otherwise these only carry the length of fixed size
+ * memory blocks in <lo_u64> (which is also where ranges of such blocks have
+ * it). The walk stops as soon as <cb> returns non-zero, in which case the
+ * current node is returned, otherwise NULL is returned once all nodes were
+ * visited. If <ret_count> is not NULL, <cb> is not called and the visited
+ * nodes are only counted there instead. Each branch is followed only once:
+ * the walk goes left first and keeps the right branches aside, in a stack
+ * whose depth is bounded by the number of split bits between the root and the
+ * deepest leaf, hence by the key width for scalars. Leaves are recognized like
+ * in descents, using the split bit of the parent which is kept along with its
+ * right branch. A range walk first descends towards <lo_*>, only keeping aside
+ * the right branches of the nodes it leaves on the left, so that it then
+ * continues exactly like a full walk from the first node in the range, until
+ * the first one past <hi_*>. If a tree of variable length keys is deeper than
+ * the stack, the walk finishes by looking up each next node from its key, or
+ * starts this way for a range if it happens before reaching <lo_*>. The
+ * callback must not modify the tree.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *__ceb_walk(struct ceb_node **root,
+                            ptrdiff_t kofs,
+                            enum ceb_addr_mode am,
+                            const void *base,
+                            enum ceb_key_type key_type,
+                            int range,
+                            uint32_t lo_u32,
+                            uint64_t lo_u64,
+                            const void *lo_ptr,
+                            uint32_t hi_u32,
+                            uint64_t hi_u64,
+                            const void *hi_ptr,
+                            ceb_walk_cb cb,
+                            void *arg,
+                            size_t *ret_count,
+                            int dups)
+{
+	struct {
+		struct ceb_node **pos;
+		uint64_t psplit;  // the parent's split value
+	} stk[CEB_WALK_DEPTH];
+	struct ceb_node **pos = root;
+	struct ceb_node *p, *lb, *rb;
+	struct ceb_node *first = NULL, *last = NULL; // current list of dups
+	uint64_t psplit = ~0ULL; // previous split between branches
+	uint64_t split, lsplit, rsplit;
+	int seek = range;        // still descending towards <lo_*>
+	int sp = 0;
+	int deep = 0;            // stack overflow, switch to lookups
+	int side;
+
+	if (!_ceb_ld(am, base, root))
+		return NULL;
+
+	while (1) {
+		p = _ceb_ldb(am, base, pos);
+
+		/* only leaf pointers may be tagged, and they then designate
+		 * the last element of a list of duplicates, whose first one
+		 * follows the one after the last.
+		 */
+		if (dups && __ceb_tagged(p)) {
+			p = __ceb_clrtag(p);
+			if (seek) {
+				seek = 0;
+				if (_ceb_walk_key_cmp(kofs, key_type, lo_u32, lo_u64, lo_ptr, p) > 0)
+					goto leaf_done;
+			}
+			last = p;
+			first = p = __ceb_clrtag(last->b[1])->b[0];
+			goto visit;
+		}
+
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+		if (dups) {
+			lb = __ceb_clrtag(lb);
+			rb = __ceb_clrtag(rb);
+		}
+
+		__builtin_prefetch(_ceb_getb(am, base, lb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, lb, 1), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 1), 0);
+
+		/* two equal pointers identifies the nodeless leaf, and a split
+		 * above the previous one the leaf of an upper node.
+		 */
+		if (lb == rb || (split = _ceb_walk_split(kofs, key_type, lo_u64, lb, rb)) > psplit) {
+			if (seek) {
+				seek = 0;
+				if (_ceb_walk_key_cmp(kofs, key_type, lo_u32, lo_u64, lo_ptr, p) > 0)
+					goto leaf_done;
+			}
+			goto visit;
+		}
+
+		side = 0;
+		if (seek) {
+			/* the branch closest to <lo_*> is the one to follow,
+			 * unless it differs from both before the split bit,
+			 * in which case the whole subtree is either in the
+			 * range or below it.
+			 */
+			lsplit = _ceb_walk_key_split(kofs, key_type, lo_u32, lo_u64, lo_ptr, lb);
+			rsplit = _ceb_walk_key_split(kofs, key_type, lo_u32, lo_u64, lo_ptr, rb);
+			if (lsplit > split && rsplit > split) {
+				seek = 0;
+				if (_ceb_walk_key_cmp(kofs, key_type, lo_u32, lo_u64, lo_ptr, lb) > 0)
+					goto leaf_done;
+			}
+			else
+				side = lsplit >= rsplit;
+		}
+
+		/* a branch looping over its node designates the node's leaf,
+		 * which a zero previous split will reveal.
+		 */
+		if (!deep && !side) {
+			if (sp == CEB_WALK_DEPTH) {
+				if (seek)
+					goto too_deep;
+				deep = 1;
+			}
+			else {
+				stk[sp].pos = _ceb_br(am, p, 1);
+				stk[sp].psplit = (p == _ceb_ldb(am, base, stk[sp].pos)) ? 0 : split;
+				sp++;
+			}
+		}
+
+		pos = _ceb_br(am, p, side);
+		psplit = (p == _ceb_ldb(am, base, pos)) ? 0 : split;
+		continue;
+
+	visit:
+		if (range && _ceb_walk_key_cmp(kofs, key_type, hi_u32, hi_u64, hi_ptr, p) < 0)
+			return NULL;
+
+		if (ret_count)
+			(*ret_count)++;
+		else if (cb(p, arg))
+			return p;
+
+		if (last) {
+			if (p != last) {
+				p = (p == first) ? __ceb_clrtag(last->b[1]) : __ceb_clrtag(p->b[1]);
+				goto visit;
+			}
+			last = NULL;
+		}
+
+	leaf_done:
+		/* the stack was too small: the node that was just visited is
+		 * the first one past all those we had to leave aside.
+		 */
+		if (deep) {
+			p = _ceb_walk_step(root, kofs, am, base, key_type, lo_u64, p, dups, 0);
+			if (!p)
+				return NULL;
+			goto visit;
+		}
+
+		if (!sp)
+			return NULL;
+		sp--;
+		pos = stk[sp].pos;
+		psplit = stk[sp].psplit;
+	}
+
+ too_deep:
+	/* the stack was too small to reach <lo_*>, let's look it up */
+	if (dups)
+		p = _ceb_lookup_ge(root, kofs, key_type, lo_u32, lo_u64, lo_ptr);
+	else
+		p = _cebu_lookup_ge(root, kofs, am, base, key_type, lo_u32, lo_u64, lo_ptr);
+	if (!p)
+		return NULL;
+	deep = 1;
+	goto visit;
+}
+
+/* Calls <cb> with <arg> for each node of the tree <root> made of unique keys
+ * of type <key_type> in ascending order. See __ceb_walk() for details.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_walk(struct ceb_node **root,
+                            ptrdiff_t kofs,
+                            enum ceb_addr_mode am,
+                            const void *base,
+                            enum ceb_key_type key_type,
+                            uint64_t key_u64,
+                            ceb_walk_cb cb,
+                            void *arg)
+{
+	return __ceb_walk(root, kofs, am, base, key_type, 0, 0, key_u64, NULL, 0, 0, NULL, cb, arg, NULL, 0);
+}
+
+/* Calls <cb> with <arg> for each node of the tree <root> made of keys of type
+ * <key_type>, possibly with duplicates, in ascending order. Duplicates are
+ * visited in insertion order. See __ceb_walk() for details.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_walk(struct ceb_node **root,
+                           ptrdiff_t kofs,
+                           enum ceb_key_type key_type,
+                           uint64_t key_u64,
+                           ceb_walk_cb cb,
+                           void *arg)
+{
+	return __ceb_walk(root, kofs, CEB_AM_ABS, NULL, key_type, 0, 0, key_u64, NULL, 0, 0, NULL, cb, arg, NULL, 1);
+}
+
+/* Calls <cb> with <arg> for each node of the tree <root> made of unique keys
+ * of type <key_type> whose key is between <lo_*> and <hi_*> inclusive, in
+ * ascending order. Fixed size memory blocks have their length in both
+ * <lo_u64> and <hi_u64>. See __ceb_walk() for details.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_walk_range(struct ceb_node **root,
+                                  ptrdiff_t kofs,
+                                  enum ceb_addr_mode am,
+                                  const void *base,
+                                  enum ceb_key_type key_type,
+                                  uint32_t lo_u32,
+                                  uint64_t lo_u64,
+                                  const void *lo_ptr,
+                                  uint32_t hi_u32,
+                                  uint64_t hi_u64,
+                                  const void *hi_ptr,
+                                  ceb_walk_cb cb,
+                                  void *arg)
+{
+	return __ceb_walk(root, kofs, am, base, key_type, 1, lo_u32, lo_u64, lo_ptr, hi_u32, hi_u64, hi_ptr, cb, arg, NULL, 0);
+}
+
+/* Same as _cebu_walk_range() above for trees possibly containing duplicates,
+ * which are visited in insertion order.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_walk_range(struct ceb_node **root,
+                                 ptrdiff_t kofs,
+                                 enum ceb_key_type key_type,
+                                 uint32_t lo_u32,
+                                 uint64_t lo_u64,
+                                 const void *lo_ptr,
+                                 uint32_t hi_u32,
+                                 uint64_t hi_u64,
+                                 const void *hi_ptr,
+                                 ceb_walk_cb cb,
+                                 void *arg)
+{
+	return __ceb_walk(root, kofs, CEB_AM_ABS, NULL, key_type, 1, lo_u32, lo_u64, lo_ptr, hi_u32, hi_u64, hi_ptr, cb, arg, NULL, 1);
+}
+
+/* Returns the number of nodes of the tree <root> made of unique keys of type
+ * <key_type> whose key is between <lo_*> and <hi_*> inclusive. It's the same
+ * walk as _cebu_walk_range() above, without the callback.
+ */
+static inline __attribute__((always_inline))
+size_t _cebu_count_range(struct ceb_node **root,
+                         ptrdiff_t kofs,
+                         enum ceb_addr_mode am,
+                         const void *base,
+                         enum ceb_key_type key_type,
+                         uint32_t lo_u32,
+                         uint64_t lo_u64,
+                         const void *lo_ptr,
+                         uint32_t hi_u32,
+                         uint64_t hi_u64,
+                         const void *hi_ptr)
+{
+	size_t count = 0;
+
+	__ceb_walk(root, kofs, am, base, key_type, 1, lo_u32, lo_u64, lo_ptr, hi_u32, hi_u64, hi_ptr, NULL, NULL, &count, 0);
+	return count;
+}
+
+/* Same as _cebu_count_range() above for trees possibly containing duplicates,
+ * which are all counted.
+ */
+static inline __attribute__((always_inline))
+size_t _ceb_count_range(struct ceb_node **root,
+                        ptrdiff_t kofs,
+                        enum ceb_key_type key_type,
+                        uint32_t lo_u32,
+                        uint64_t lo_u64,
+                        const void *lo_ptr,
+                        uint32_t hi_u32,
+                        uint64_t hi_u64,
+                        const void *hi_ptr)
+{
+	size_t count = 0;
+
+	__ceb_walk(root, kofs, CEB_AM_ABS, NULL, key_type, 1, lo_u32, lo_u64, lo_ptr, hi_u32, hi_u64, hi_ptr, NULL, NULL, &count, 1);
+	return count;
+}
+
+/* Unlinks and marks as deleted all nodes of the subtree designated by <q>
+ * in the tree made of keys of type <key_type>, whose parent's split is
+ * <psplit>, as part of __ceb_delete_range(). Each node is handed to <free_cb>
+ * with <arg> if not NULL, and counted in <ret_count>, except the single one
+ * whose node role is located above the subtree or which is the nodeless leaf,
+ * which is returned instead since its branches are still needed to fix the
+ * tree up. Role nodes are marked when visited, which is always before their
+ * leaf, so that a leaf is either already marked, or is the one returned.
+ * With <check> set, nothing is modified and the subtree is only walked to
+ * verify that its depth fits in the stack, returning NULL otherwise. This is
+ * only needed for variable length keys.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *__ceb_purge(ptrdiff_t kofs,
+                             enum ceb_addr_mode am,
+                             const void *base,
+                             enum ceb_key_type key_type,
+                             uint64_t key_u64,
+                             struct ceb_node *q,
+                             uint64_t psplit,
+                             ceb_free_cb free_cb,
+                             void *arg,
+                             size_t *ret_count,
+                             int dups,
+                             int check)
+{
+	struct {
+		struct ceb_node *node;
+		uint64_t psplit;  // the parent's split value
+	} stk[CEB_WALK_DEPTH];
+	struct ceb_node *p, *lb, *rb, *ret = NULL;
+	struct ceb_node *last, *next;
+	uint64_t split;
+	int sp = 0;
+
+	while (1) {
+		if (dups && __ceb_tagged(q)) {
+			/* a list of duplicates, of which only the first
+			 * node N may hold a node role. The other ones are
+			 * released from D1 to Dn.
+			 */
+			last = __ceb_clrtag(q);
+			p = __ceb_clrtag(last->b[1])->b[0];
+			if (!check) {
+				for (q = __ceb_clrtag(last->b[1]); ; q = next) {
+					next = __ceb_clrtag(q->b[1]);
+					q->b[0] = NULL;
+					(*ret_count)++;
+					if (free_cb)
+						free_cb(q, arg);
+					if (q == last)
+						break;
+				}
+			}
+			goto leaf;
+		}
+
+		p = q;
+		if (!check && !_ceb_ld(am, base, _ceb_br(am, p, 0)))
+			goto leaf;
+
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+		if (dups) {
+			lb = __ceb_clrtag(lb);
+			rb = __ceb_clrtag(rb);
+		}
+
+		__builtin_prefetch(_ceb_getb(am, base, lb, 0), 0);
+		__builtin_prefetch(_ceb_getb(am, base, rb, 0), 0);
+
+		if (lb == rb || (split = _ceb_walk_split(kofs, key_type, key_u64, lb, rb)) > psplit)
+			goto leaf;
+
+		if (sp == CEB_WALK_DEPTH)
+			return NULL;
+
+		/* a branch looping over its node designates the node's leaf,
+		 * which a zero previous split will reveal.
+		 */
+		stk[sp].node = _ceb_getb(am, base, p, 1);
+		stk[sp].psplit = (rb == p) ? 0 : split;
+		sp++;
+		q = _ceb_getb(am, base, p, 0);
+		psplit = (lb == p) ? 0 : split;
+		if (!check)
+			_ceb_st(am, base, _ceb_br(am, p, 0), NULL);
+		continue;
+
+	leaf:
+		if (check || _ceb_ld(am, base, _ceb_br(am, p, 0)))
+			ret = p;
+		else {
+			(*ret_count)++;
+			if (free_cb)
+				free_cb(p, arg);
+		}
+
+		if (!sp)
+			return ret;
+		sp--;
+		q = stk[sp].node;
+		psplit = stk[sp].psplit;
+	}
+}
+
+/* flags of the pending right branches of __ceb_delete_range() */
+#define CEB_DR_WALK  1   // the branch has to be walked
+#define CEB_DR_LO    2   // the branch is past <lo_*>
+#define CEB_DR_HI    4   // the branch is before <hi_*>
+
+/* Deletes from the tree <root> made of keys of type <key_type>, possibly with
+ * duplicates if <dups> is set, all nodes whose key is between <lo_*> and
+ * <hi_*> inclusive, and returns their number. Fixed size memory blocks have
+ * their length in both <lo_u64> and <hi_u64>. Each deleted node is handed to
+ * <free_cb> with <arg> if <free_cb> is not NULL, once it was unlinked and
+ * marked as deleted, so that the callback may release it. It must not modify
+ * the tree. Nodes are not passed in any particular order.
+ *
+ * Instead of deleting the nodes one at a time, the tree is walked from the
+ * root along the boundaries of the range, like __ceb_walk() does towards
+ * <lo_*>, but towards both <lo_*> and <hi_*> at once. Each subtree found to
+ * be entirely within the range is detached at once from its parent P, which
+ * is replaced by its other branch, and is then walked only once to release
+ * its nodes. All node roles in the subtree belong to its own leaves, and all
+ * of its leaves but one (X) have their role within it. X's leaf is either the
+ * nodeless one, or its role is P or one of P's ancestors. Thus P, which has
+ * lost its role, becomes the nodeless leaf in the first case, takes X's role
+ * in the second one, and is simply removed with X in the last one. Ancestors
+ * are kept in a path so that the walk continues from P's former position,
+ * with the path updated if P replaced X there. The cost is one descent along
+ * each boundary plus one visit of each deleted node. If a tree of variable
+ * length keys is deeper than the path, the remaining nodes are deleted one
+ * at a time, looking them up by the range's lower bound.
+ */
+static inline __attribute__((always_inline))
+size_t __ceb_delete_range(struct ceb_node **root,
+                          ptrdiff_t kofs,
+                          enum ceb_addr_mode am,
+                          const void *base,
+                          enum ceb_key_type key_type,
+                          uint32_t lo_u32,
+                          uint64_t lo_u64,
+                          const void *lo_ptr,
+                          uint32_t hi_u32,
+                          uint64_t hi_u64,
+                          const void *hi_ptr,
+                          ceb_free_cb free_cb,
+                          void *arg,
+                          int dups)
+{
+	struct {
+		struct ceb_node *node;
+		uint64_t split;   // the node's split value
+		uint8_t side;     // the branch taken
+		uint8_t right;    // CEB_DR_* flags for the right branch
+	} path[CEB_WALK_DEPTH];
+	struct ceb_node **pos;
+	struct ceb_node *p, *lb, *rb, *x, *n;
+	uint64_t psplit, split, lsplit, rsplit;
+	size_t count = 0;
+	int lo_free = 0, hi_free = 0; // bound known to be passed
+	int lside = 0, hside = 0;
+	int d = 0, s, i;
+
+	if (!_ceb_ld(am, base, root))
+		return 0;
+
+	while (1) {
+		/* the current subtree hangs from the last node of the path */
+		pos = d ? _ceb_br(am, path[d - 1].node, path[d - 1].side) : root;
+		p = _ceb_ldb(am, base, pos);
+		psplit = !d ? ~0ULL : (p == path[d - 1].node) ? 0 : path[d - 1].split;
+
+		if (dups && __ceb_tagged(p))
+			goto leaf;
+
+		if (lo_free && hi_free)
+			goto detach;
+
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+		if (dups) {
+			lb = __ceb_clrtag(lb);
+			rb = __ceb_clrtag(rb);
+		}
+
+		/* two equal pointers identifies the nodeless leaf, and a split
+		 * above the previous one the leaf of an upper node.
+		 */
+		if (lb == rb || (split = _ceb_walk_split(kofs, key_type, lo_u64, lb, rb)) > psplit)
+			goto leaf;
+
+		/* the branch closest to each bound is the one to follow,
+		 * unless the bound differs from both before the split bit,
+		 * in which case the whole subtree is on the same side of it.
+		 */
+		if (!lo_free) {
+			lsplit = _ceb_walk_key_split(kofs, key_type, lo_u32, lo_u64, lo_ptr, lb);
+			rsplit = _ceb_walk_key_split(kofs, key_type, lo_u32, lo_u64, lo_ptr, rb);
+			if (lsplit > split && rsplit > split) {
+				if (_ceb_walk_key_cmp(kofs, key_type, lo_u32, lo_u64, lo_ptr, lb) > 0)
+					goto done;
+				lo_free = 1;
+			}
+			else
+				lside = lsplit >= rsplit;
+		}
+
+		if (!hi_free) {
+			lsplit = _ceb_walk_key_split(kofs, key_type, hi_u32, hi_u64, hi_ptr, lb);
+			rsplit = _ceb_walk_key_split(kofs, key_type, hi_u32, hi_u64, hi_ptr, rb);
+			if (lsplit > split && rsplit > split) {
+				if (_ceb_walk_key_cmp(kofs, key_type, hi_u32, hi_u64, hi_ptr, lb) < 0)
+					goto done;
+				hi_free = 1;
+			}
+			else
+				hside = lsplit >= rsplit;
+		}
+
+		if (lo_free && hi_free)
+			goto detach;
+
+		if (d == CEB_WALK_DEPTH)
+			goto too_deep;
+
+		path[d].node = p;
+		path[d].split = split;
+		if (lo_free || !lside) {
+			/* the left branch has nodes in the range */
+			path[d].side = 0;
+			path[d].right = 0;
+			if (hi_free || hside)
+				path[d].right = CEB_DR_WALK | CEB_DR_LO | (hi_free ? CEB_DR_HI : 0);
+			hi_free = hi_free || hside;
+		}
+		else if (hi_free || hside) {
+			/* only the right branch has nodes in the range */
+			path[d].side = 1;
+			path[d].right = 0;
+		}
+		else
+			goto done;
+		d++;
+		continue;
+
+	leaf:
+		p = __ceb_clrtag(p);
+		if ((!lo_free && _ceb_walk_key_cmp(kofs, key_type, lo_u32, lo_u64, lo_ptr, p) > 0) ||
+		    (!hi_free && _ceb_walk_key_cmp(kofs, key_type, hi_u32, hi_u64, hi_ptr, p) < 0))
+			goto done;
+
+	detach:
+		/* the whole subtree at <pos> is in the range. Subtrees of
+		 * variable length keys are first checked to fit in the stack.
+		 */
+		if (!(_ceb_kt_is32(key_type) || _ceb_kt_is64(key_type) ||
+		      key_type == CEB_KT_U128 || key_type == CEB_KT_ADDR) &&
+		    !__ceb_purge(kofs, am, base, key_type, lo_u64, _ceb_ldb(am, base, pos), psplit, NULL, NULL, NULL, dups, 1))
+			goto too_deep;
+
+		x = __ceb_purge(kofs, am, base, key_type, lo_u64, _ceb_ldb(am, base, pos), psplit, free_cb, arg, &count, dups, 0);
+
+		if (!d)
+			_ceb_st(am, base, root, NULL);
+		else {
+			/* P is replaced by its other branch */
+			n = path[d - 1].node;
+			s = path[d - 1].side;
+			pos = (d > 1) ? _ceb_br(am, path[d - 2].node, path[d - 2].side) : root;
+			rb = _ceb_getb(am, base, n, !s);
+
+			if (x != n && _ceb_getb(am, base, x, 0) == _ceb_getb(am, base, x, 1)) {
+				/* X was the nodeless leaf, P takes this role */
+				_ceb_st(am, base, pos, rb);
+				_ceb_setb(am, base, n, 0, n);
+				_ceb_setb(am, base, n, 1, n);
+			}
+			else {
+				_ceb_st(am, base, pos, rb);
+				if (x != n) {
+					/* P takes X's role, which is above it */
+					for (i = 0; path[i].node != x; i++)
+						;
+					_ceb_setb(am, base, n, 0, _ceb_getb(am, base, x, 0));
+					_ceb_setb(am, base, n, 1, _ceb_getb(am, base, x, 1));
+					_ceb_st(am, base, i ? _ceb_br(am, path[i - 1].node, path[i - 1].side) : root, n);
+					path[i].node = n;
+				}
+			}
+		}
+
+		_ceb_st(am, base, _ceb_br(am, x, 0), NULL);
+		count++;
+		if (free_cb)
+			free_cb(x, arg);
+
+		if (!d)
+			return count;
+
+		/* P's position now holds its other branch, which remains to
+		 * be walked if it was its pending right branch.
+		 */
+		d--;
+		if (!s && (path[d].right & CEB_DR_WALK)) {
+			lo_free = !!(path[d].right & CEB_DR_LO);
+			hi_free = !!(path[d].right & CEB_DR_HI);
+			continue;
+		}
+
+	done:
+		/* the current subtree was processed, let's continue with the
+		 * closest pending right branch.
+		 */
+		while (d && (path[d - 1].side || !(path[d - 1].right & CEB_DR_WALK)))
+			d--;
+		if (!d)
+			return count;
+		path[d - 1].side = 1;
+		lo_free = !!(path[d - 1].right & CEB_DR_LO);
+		hi_free = !!(path[d - 1].right & CEB_DR_HI);
+		path[d - 1].right = 0;
+	}
+
+ too_deep:
+	/* the path was too small, the tree remains valid and the other nodes
+	 * are deleted one at a time.
+	 */
+	while (1) {
+		uint32_t key_u32 = 0;
+		uint64_t key_u64 = lo_u64;
+		const void *key_ptr = NULL;
+
+		if (dups)
+			p = _ceb_lookup_ge(root, kofs, key_type, lo_u32, lo_u64, lo_ptr);
+		else
+			p = _cebu_lookup_ge(root, kofs, am, base, key_type, lo_u32, lo_u64, lo_ptr);
+		if (!p || _ceb_walk_key_cmp(kofs, key_type, hi_u32, hi_u64, hi_ptr, p) < 0)
+			break;
+
+		_ceb_walk_node_key(kofs, key_type, p, &key_u32, &key_u64, &key_ptr);
+		if (dups)
+			_ceb_delete(root, p, kofs, key_type, key_u32, key_u64, key_ptr);
+		else
+			_cebu_delete(root, p, kofs, am, base, key_type, key_u32, key_u64, key_ptr);
+		count++;
+		if (free_cb)
+			free_cb(p, arg);
+	}
+	return count;
+}
+
+/* Deletes from the tree <root> made of unique keys of type <key_type> all
+ * nodes whose key is between <lo_*> and <hi_*> inclusive, handing each of
+ * them to <free_cb> with <arg> if not NULL, and returns their number. See
+ * __ceb_delete_range() for details.
+ */
+static inline __attribute__((always_inline))
+size_t _cebu_delete_range(struct ceb_node **root,
+                          ptrdiff_t kofs,
+                          enum ceb_addr_mode am,
+                          const void *base,
+                          enum ceb_key_type key_type,
+                          uint32_t lo_u32,
+                          uint64_t lo_u64,
+                          const void *lo_ptr,
+                          uint32_t hi_u32,
+                          uint64_t hi_u64,
+                          const void *hi_ptr,
+                          ceb_free_cb free_cb,
+                          void *arg)
+{
+	return __ceb_delete_range(root, kofs, am, base, key_type, lo_u32, lo_u64, lo_ptr, hi_u32, hi_u64, hi_ptr, free_cb, arg, 0);
+}
+
+/* Same as _cebu_delete_range() above for trees possibly containing
+ * duplicates, which are all deleted.
+ */
+static inline __attribute__((always_inline))
+size_t _ceb_delete_range(struct ceb_node **root,
+                         ptrdiff_t kofs,
+                         enum ceb_key_type key_type,
+                         uint32_t lo_u32,
+                         uint64_t lo_u64,
+                         const void *lo_ptr,
+                         uint32_t hi_u32,
+                         uint64_t hi_u64,
+                         const void *hi_ptr,
+                         ceb_free_cb free_cb,
+                         void *arg)
+{
+	return __ceb_delete_range(root, kofs, CEB_AM_ABS, NULL, key_type, lo_u32, lo_u64, lo_ptr, hi_u32, hi_u64, hi_ptr, free_cb, arg, 1);
+}
+
+/* Calls <cb> with <arg> for each node of the tree <root> made of strings
+ * (CEB_KT_ST, IS, SI or ISI) whose key starts with the NUL-terminated prefix
+ * <key_ptr>, in ascending order. The walk stops as soon as <cb> returns
+ * non-zero, in which case the current node is returned, otherwise NULL is
+ * returned once all matching nodes were visited. The walk only happens within
+ * the subtree covering the prefix, which is walked like a whole tree. The
+ * callback must not modify the tree.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_walk_prefix(struct ceb_node **root,
+                                   ptrdiff_t kofs,
+                                   enum ceb_addr_mode am,
+                                   const void *base,
+                                   enum ceb_key_type key_type,
+                                   const void *key_ptr,
+                                   ceb_walk_cb cb,
+                                   void *arg)
+{
+	struct ceb_node **sub;
+	struct ceb_node *node;
+
+	sub = _cebu_lookup_prefix(root, kofs, am, base, key_type, key_ptr, &node);
+	if (!sub)
+		return NULL;
+
+	if (node)
+		return cb(node, arg) ? node : NULL;
+
+	return _cebu_walk(sub, kofs, am, base, key_type, 0, cb, arg);
+}
+
+/* Returns the node designated by the link leading to entry <d> of the path of
+ * iterator <iter>, or to its current node when <d> is its depth, or NULL if
+ * the link is empty or its node was removed from the tree, which only clears
+ * its left branch. It's used to check that the path still holds. Only the
+ * root and the left branch may be tested for NULL, the followed branch is
+ * read as a non-empty one since it may loop over its own node.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_ceb_iter_link(const struct ceb_iter *iter, enum ceb_addr_mode am, int d)
+{
+	const struct ceb_node *node;
+
+	if (!d)
+		return _ceb_ld(am, iter->base, iter->root);
+
+	node = iter->path[d - 1].node;
+	if (!_ceb_ld(am, iter->base, _ceb_br(am, node, 0)))
+		return NULL;
+	return _ceb_getb(am, iter->base, node, iter->path[d - 1].side);
+}
+
+/* Returns non-zero if split values <a> and <b> for keys of type <key_type>
+ * designate the same split bit. Scalars use their xor, which only needs the
+ * same highest bit, while other types use positions, which must be equal.
+ */
+static inline __attribute__((always_inline))
+int _ceb_walk_same_split(enum ceb_key_type key_type, uint64_t a, uint64_t b)
+{
+	if (key_type == CEB_KT_ADDR || _ceb_kt_is32(key_type) || _ceb_kt_is64(key_type))
+		return (a ^ b) < (a & b);
+	return a == b;
+}
+
+/* Descends from branch <pos> below the path of iterator <iter> over a tree of
+ * unique keys of type <key_type>, the previous split being <psplit>, and
+ * records the ancestors met in the path. If <target> is set, the descent
+ * goes towards this node, otherwise it always takes branch <side>. The side
+ * of the target is the one whose branch has its key closer to the target's,
+ * which works the same for all key types since the split values grow with
+ * the position of the split bit. Fixed size memory blocks have their length
+ * in <key_u64>. The leaf found becomes the current node and is returned, or
+ * NULL if it's not the target. Past CEB_ITER_DEPTH ancestors, the path is
+ * marked as lost and the iterator will step using key lookups.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_iter_descend(struct ceb_iter *iter,
+                                    ptrdiff_t kofs,
+                                    enum ceb_addr_mode am,
+                                    enum ceb_key_type key_type,
+                                    uint64_t key_u64,
+                                    struct ceb_node **pos,
+                                    uint64_t psplit,
+                                    const struct ceb_node *target,
+                                    int side)
+{
+	const void *base = iter->base;
+	struct ceb_node *p, *lb, *rb;
+	uint64_t split;
+	int d = iter->depth;
+
+	while (1) {
+		p = _ceb_ldb(am, base, pos);
+		lb = _ceb_getb(am, base, p, 0);
+		rb = _ceb_getb(am, base, p, 1);
+
+		/* two equal pointers identifies the nodeless leaf, and a split
+		 * above the previous one the leaf of an upper node.
+		 */
+		if (lb == rb || (split = _ceb_walk_split(kofs, key_type, key_u64, lb, rb)) > psplit)
+			break;
+
+		if (target)
+			side = _ceb_walk_split(kofs, key_type, key_u64, lb, target) >
+			       _ceb_walk_split(kofs, key_type, key_u64, rb, target);
+
+		if (d >= 0 && d < CEB_ITER_DEPTH) {
+			iter->path[d].node = p;
+			iter->path[d].split = split;
+			iter->path[d].side = side;
+			d++;
+		}
+		else
+			d = -1;
+
+		/* a branch looping over its node designates the node's leaf,
+		 * which a zero previous split will reveal.
+		 */
+		pos = _ceb_br(am, p, side);
+		psplit = (p == _ceb_ldb(am, base, pos)) ? 0 : split;
+	}
+
+	iter->depth = d;
+	iter->node = p;
+	if (target && p != target) {
+		iter->node = NULL;
+		iter->depth = 0;
+		return NULL;
+	}
+	return p;
+}
+
+/* Binds iterator <iter> to the tree <root> of unique keys, located at <base>
+ * for the cebx model, and places it off the tree.
+ */
+static inline __attribute__((always_inline))
+void _cebu_iter_init(struct ceb_iter *iter, struct ceb_node **root, const void *base)
+{
+	iter->root = root;
+	iter->base = base;
+	iter->node = NULL;
+	iter->depth = 0;
+	iter->stale = 0;
+}
+
+/* Moves iterator <iter> over a tree of unique keys of type <key_type> to the
+ * node following its current one, or preceding it if <back> is set, and
+ * returns it. From off the tree, this is the first or last node. NULL is
+ * returned and the iterator goes off the tree past the end. Fixed size memory
+ * blocks have their length in <key_u64>. The iterator climbs back its path
+ * up to the closest ancestor where it went the other way, checking each link
+ * it crosses back, then descends on the other side of this ancestor, after
+ * checking that it's still a node splitting on the same bit, since a removal
+ * may turn it into a leaf at the same place. Each link being crossed at most
+ * twice during a complete iteration, stepping costs O(1) on average. Without
+ * a path, the neighbour is looked up using the node's key, and the iterator
+ * goes stale if the node was removed. NULL is also returned for a stale
+ * iterator.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_iter_step(struct ceb_iter *iter,
+                                 ptrdiff_t kofs,
+                                 enum ceb_addr_mode am,
+                                 enum ceb_key_type key_type,
+                                 uint64_t key_u64,
+                                 int back)
+{
+	struct ceb_node *cur, *lb, *rb;
+	struct ceb_node **pos;
+	int d;
+
+	if (iter->stale)
+		return NULL;
+
+	if (!iter->node) {
+		if (!_ceb_ld(am, iter->base, iter->root))
+			return NULL;
+		iter->depth = 0;
+		return _cebu_iter_descend(iter, kofs, am, key_type, key_u64, iter->root, ~0ULL, NULL, back);
+	}
+
+	if (iter->depth < 0) {
+		/* path lost in a too deep tree, use the node's key, which
+		 * needs the node to still be in the tree.
+		 */
+		if (!_ceb_ld(am, iter->base, _ceb_br(am, iter->node, 0)))
+			goto stale;
+		iter->node = _ceb_walk_step(iter->root, kofs, am, iter->base, key_type, key_u64, iter->node, 0, back);
+		if (!iter->node)
+			iter->depth = 0;
+		return iter->node;
+	}
+
+	/* climb back while we came from the side we're going to, the
+	 * ancestor where we didn't being the one to turn at. Each link is
+	 * checked, as well as the one leading to the turning ancestor.
+	 */
+	d = iter->depth;
+	cur = iter->node;
+	while (1) {
+		if (_ceb_iter_link(iter, am, d) != cur)
+			goto stale;
+		if (!d) {
+			iter->node = NULL;
+			return NULL;
+		}
+		d--;
+		cur = iter->path[d].node;
+		if (iter->path[d].side == back) {
+			if (_ceb_iter_link(iter, am, d) != cur)
+				goto stale;
+			break;
+		}
+	}
+
+	if (!_ceb_ld(am, iter->base, _ceb_br(am, cur, 0)))
+		goto stale;
+
+	lb = _ceb_getb(am, iter->base, cur, 0);
+	rb = _ceb_getb(am, iter->base, cur, 1);
+	if (lb == rb ||
+	    !_ceb_walk_same_split(key_type, _ceb_walk_split(kofs, key_type, key_u64, lb, rb), iter->path[d].split))
+		goto stale;
+
+	iter->path[d].side = !back;
+	iter->depth = d + 1;
+	pos = _ceb_br(am, cur, !back);
+	return _cebu_iter_descend(iter, kofs, am, key_type, key_u64, pos,
+	                          (cur == _ceb_ldb(am, iter->base, pos)) ? 0 : iter->path[d].split,
+	                          NULL, back);
+ stale:
+	iter->stale = 1;
+	iter->node = NULL;
+	iter->depth = 0;
+	return NULL;
+}
+
+/* Moves iterator <iter> over a tree of unique keys of type <key_type> to the
+ * first node whose key is greater than or equal to <key_*>, and returns it.
+ * If there is none, NULL is returned and the iterator goes off the tree. The
+ * node is looked up first, then the path to it is recorded. This also makes
+ * a stale iterator usable again.
+ */
+static inline __attribute__((always_inline))
+struct ceb_node *_cebu_iter_seek(struct ceb_iter *iter,
+                                 ptrdiff_t kofs,
+                                 enum ceb_addr_mode am,
+                                 enum ceb_key_type key_type,
+                                 uint32_t key_u32,
+                                 uint64_t key_u64,
+                                 const void *key_ptr)
+{
+	struct ceb_node *node;
+
+	iter->stale = 0;
+	iter->node = NULL;
+	iter->depth = 0;
+
+	node = _cebu_lookup_ge(iter->root, kofs, am, iter->base, key_type, key_u32, key_u64, key_ptr);
+	if (!node)
+		return NULL;
+	return _cebu_iter_descend(iter, kofs, am, key_type, key_u64, iter->root, ~0ULL, node, 0);
+}
+
+/*
+ * Functions used to dump trees in Dot format.
+ */
+
+/* dump the root and its link to the first node or leaf */
+__attribute__((unused))
+static void cebu_default_dump_root(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, struct ceb_node *const *root, const void *ctx)
+{
+	const struct ceb_node *node;
+
+	printf("  \"%lx_n\" [label=\"root\\n%lx\"]\n", (long)root, (long)root);
+
+	node = _ceb_ld(am, base, root);
+	if (node) {
+		/* under the root we've either a node or the first leaf */
+		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"B\" arrowsize=0.66];\n",
+		       (long)root, (long)__ceb_clrtag(node),
+		       (__ceb_tagged(node) || _ceb_getb(am, base, node, 0) == _ceb_getb(am, base, node, 1)) ? 'l' : 'n');
+	}
+}
+
+/* dump a node */
+__attribute__((unused))
+static void cebu_default_dump_node(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx)
+{
+	const struct ceb_node *lb, *rb;
+	unsigned long long int_key = 0;
+	const char *sign = "";
+	uint64_t pxor, lxor, rxor;
+	int ltag, rtag;
+
+	/* tagged branches point to lists of duplicates, hence leaves */
+	ltag = __ceb_tagged(_ceb_getb(am, base, node, 0));
+	rtag = __ceb_tagged(_ceb_getb(am, base, node, 1));
+	lb = __ceb_clrtag(_ceb_getb(am, base, node, 0));
+	rb = __ceb_clrtag(_ceb_getb(am, base, node, 1));
+
+	switch (key_type) {
+	case CEB_KT_ADDR:
+		int_key = (uintptr_t)node;
+		break;
+	case CEB_KT_U32:
+		int_key = *NODEKT(node, kofs, uint32_t);
+		break;
+	case CEB_KT_U64:
+		int_key = NODEK(node, kofs)->u64;
+		break;
+	case CEB_KT_I32:
+		int_key = (int32_t)*NODEKT(node, kofs, uint32_t);
+		break;
+	case CEB_KT_I64:
+		int_key = (int64_t)NODEK(node, kofs)->u64;
+		break;
+	case CEB_KT_U16:
+		int_key = *NODEKT(node, kofs, uint16_t);
+		break;
+	case CEB_KT_U8:
+		int_key = *NODEKT(node, kofs, uint8_t);
+		break;
+	case CEB_KT_IU32:
+		int_key = _ceb_k32(key_type, NODEK(node, kofs));
+		break;
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
+		int_key = _ceb_k64(key_type, NODEK(node, kofs));
+		break;
+	default:
+		break;
+	}
+
+	/* signed keys are shown with their sign */
+	if ((key_type == CEB_KT_I32 || key_type == CEB_KT_I64) && (long long)int_key < 0) {
+		sign = "-";
+		int_key = -int_key;
+	}
+
+	/* xor of the keys of the two lower branches */
+	pxor = _xor_branches(kofs, key_type, 0, 0, NULL, lb, rb);
+
+	/* xor of the keys of the left branch's lower branches */
 	lxor = _xor_branches(kofs, key_type, 0, 0, NULL,
-			     (((struct ceb_node*)node->b[0])->b[0]),
-			     (((struct ceb_node*)node->b[0])->b[1]));
+			     _ceb_getb(am, base, lb, 0), _ceb_getb(am, base, lb, 1));
 
 	/* xor of the keys of the right branch's lower branches */
 	rxor = _xor_branches(kofs, key_type, 0, 0, NULL,
-			     (((struct ceb_node*)node->b[1])->b[0]),
-			     (((struct ceb_node*)node->b[1])->b[1]));
+			     _ceb_getb(am, base, rb, 0), _ceb_getb(am, base, rb, 1));
 
 	switch (key_type) {
 	case CEB_KT_ADDR:
 	case CEB_KT_U32:
 	case CEB_KT_U64:
-		printf("  \"%lx_n\" [label=\"%lx\\nlev=%d bit=%d\\nkey=%llu\" fillcolor=\"lightskyblue1\"%s];\n",
-		       (long)node, (long)node, level, flsnz(pxor) - 1, int_key, (ctx == node) ? " color=red" : "");
+	case CEB_KT_I32:
+	case CEB_KT_I64:
+	case CEB_KT_U16:
+	case CEB_KT_U8:
+	case CEB_KT_IU32:
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
+		printf("  \"%lx_n\" [label=\"%lx\\nlev=%d bit=%d\\nkey=%s%llu\" fillcolor=\"lightskyblue1\"%s];\n",
+		       (long)node, (long)node, level, flsnz(pxor) - 1, sign, int_key, (ctx == node) ? " color=red" : "");
 
 		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"L\" arrowsize=0.66 %s];\n",
-		       (long)node, (long)node->b[0],
-		       (lxor < pxor && ((struct ceb_node*)node->b[0])->b[0] != ((struct ceb_node*)node->b[0])->b[1]) ? 'n' : 'l',
-		       (node == node->b[0]) ? " dir=both" : "");
+		       (long)node, (long)lb,
+		       (!ltag && lxor < pxor && _ceb_getb(am, base, lb, 0) != _ceb_getb(am, base, lb, 1)) ? 'n' : 'l',
+		       (node == lb) ? " dir=both" : "");
 
 		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"R\" arrowsize=0.66 %s];\n",
-		       (long)node, (long)node->b[1],
-		       (rxor < pxor && ((struct ceb_node*)node->b[1])->b[0] != ((struct ceb_node*)node->b[1])->b[1]) ? 'n' : 'l',
-		       (node == node->b[1]) ? " dir=both" : "");
+		       (long)node, (long)rb,
+		       (!rtag && rxor < pxor && _ceb_getb(am, base, rb, 0) != _ceb_getb(am, base, rb, 1)) ? 'n' : 'l',
+		       (node == rb) ? " dir=both" : "");
+		break;
+	case CEB_KT_U128:
+		/* the xor is the highest differing bit plus one */
+		printf("  \"%lx_n\" [label=\"%lx\\nlev=%d bit=%d\\nkey=%#llx:%016llx\" fillcolor=\"lightskyblue1\"%s];\n",
+		       (long)node, (long)node, level, (int)pxor - 1,
+		       (unsigned long long)NODEK(node, kofs)->u128[0], (unsigned long long)NODEK(node, kofs)->u128[1],
+		       (ctx == node) ? " color=red" : "");
+
+		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"L\" arrowsize=0.66 %s];\n",
+		       (long)node, (long)lb,
+		       (!ltag && lxor < pxor && _ceb_getb(am, base, lb, 0) != _ceb_getb(am, base, lb, 1)) ? 'n' : 'l',
+		       (node == lb) ? " dir=both" : "");
+
+		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"R\" arrowsize=0.66 %s];\n",
+		       (long)node, (long)rb,
+		       (!rtag && rxor < pxor && _ceb_getb(am, base, rb, 0) != _ceb_getb(am, base, rb, 1)) ? 'n' : 'l',
+		       (node == rb) ? " dir=both" : "");
 		break;
 	case CEB_KT_MB:
 		break;
 	case CEB_KT_IM:
 		break;
+	case CEB_KT_VB:
+		break;
+	case CEB_KT_PB:
+		break;
 	case CEB_KT_ST:
+	case CEB_KT_SI:
 		printf("  \"%lx_n\" [label=\"%lx\\nlev=%d bit=%ld\\nkey=\\\"%s\\\"\" fillcolor=\"lightskyblue1\"%s];\n",
 		       (long)node, (long)node, level, (long)pxor, NODEK(node, kofs)->str, (ctx == node) ? " color=red" : "");
 
 		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"L\" arrowsize=0.66 %s];\n",
-		       (long)node, (long)node->b[0],
-		       (lxor > pxor && ((struct ceb_node*)node->b[0])->b[0] != ((struct ceb_node*)node->b[0])->b[1]) ? 'n' : 'l',
-		       (node == node->b[0]) ? " dir=both" : "");
+		       (long)node, (long)lb,
+		       (!ltag && lxor > pxor && _ceb_getb(am, base, lb, 0) != _ceb_getb(am, base, lb, 1)) ? 'n' : 'l',
+		       (node == lb) ? " dir=both" : "");
 
 		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"R\" arrowsize=0.66 %s];\n",
-		       (long)node, (long)node->b[1],
-		       (rxor > pxor && ((struct ceb_node*)node->b[1])->b[0] != ((struct ceb_node*)node->b[1])->b[1]) ? 'n' : 'l',
-		       (node == node->b[1]) ? " dir=both" : "");
+		       (long)node, (long)rb,
+		       (!rtag && rxor > pxor && _ceb_getb(am, base, rb, 0) != _ceb_getb(am, base, rb, 1)) ? 'n' : 'l',
+		       (node == rb) ? " dir=both" : "");
 		break;
 	case CEB_KT_IS:
+	case CEB_KT_ISI:
 		printf("  \"%lx_n\" [label=\"%lx\\nlev=%d bit=%ld\\nkey=\\\"%s\\\"\" fillcolor=\"lightskyblue1\"%s];\n",
 		       (long)node, (long)node, level, (long)pxor, NODEK(node, kofs)->ptr, (ctx == node) ? " color=red" : "");
 
 		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"L\" arrowsize=0.66 %s];\n",
-		       (long)node, (long)node->b[0],
-		       (lxor > pxor && ((struct ceb_node*)node->b[0])->b[0] != ((struct ceb_node*)node->b[0])->b[1]) ? 'n' : 'l',
-		       (node == node->b[0]) ? " dir=both" : "");
+		       (long)node, (long)lb,
+		       (!ltag && lxor > pxor && _ceb_getb(am, base, lb, 0) != _ceb_getb(am, base, lb, 1)) ? 'n' : 'l',
+		       (node == lb) ? " dir=both" : "");
 
 		printf("  \"%lx_n\" -> \"%lx_%c\" [label=\"R\" arrowsize=0.66 %s];\n",
-		       (long)node, (long)node->b[1],
-		       (rxor > pxor && ((struct ceb_node*)node->b[1])->b[0] != ((struct ceb_node*)node->b[1])->b[1]) ? 'n' : 'l',
-		       (node == node->b[1]) ? " dir=both" : "");
+		       (long)node, (long)rb,
+		       (!rtag && rxor > pxor && _ceb_getb(am, base, rb, 0) != _ceb_getb(am, base, rb, 1)) ? 'n' : 'l',
+		       (node == rb) ? " dir=both" : "");
 		break;
 	}
 }
 
 /* dump a leaf */
 __attribute__((unused))
-static void cebu_default_dump_leaf(ptrdiff_t kofs, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx)
+static void cebu_default_dump_leaf(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx)
 {
 	unsigned long long int_key = 0;
+	const char *sign = "";
 	uint64_t pxor;
 
 	switch (key_type) {
@@ -1482,36 +4810,85 @@ static void cebu_default_dump_leaf(ptrdiff_t kofs, enum ceb_key_type key_type, c
 		int_key = (uintptr_t)node;
 		break;
 	case CEB_KT_U32:
-		int_key = NODEK(node, kofs)->u32;
+		int_key = *NODEKT(node, kofs, uint32_t);
 		break;
 	case CEB_KT_U64:
 		int_key = NODEK(node, kofs)->u64;
 		break;
+	case CEB_KT_I32:
+		int_key = (int32_t)*NODEKT(node, kofs, uint32_t);
+		break;
+	case CEB_KT_I64:
+		int_key = (int64_t)NODEK(node, kofs)->u64;
+		break;
+	case CEB_KT_U16:
+		int_key = *NODEKT(node, kofs, uint16_t);
+		break;
+	case CEB_KT_U8:
+		int_key = *NODEKT(node, kofs, uint8_t);
+		break;
+	case CEB_KT_IU32:
+		int_key = _ceb_k32(key_type, NODEK(node, kofs));
+		break;
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
+		int_key = _ceb_k64(key_type, NODEK(node, kofs));
+		break;
 	default:
 		break;
 	}
 
+	/* signed keys are shown with their sign */
+	if ((key_type == CEB_KT_I32 || key_type == CEB_KT_I64) && (long long)int_key < 0) {
+		sign = "-";
+		int_key = -int_key;
+	}
+
 	/* xor of the keys of the two lower branches */
 	pxor = _xor_branches(kofs, key_type, 0, 0, NULL,
-			     node->b[0], node->b[1]);
+			     _ceb_getb(am, base, node, 0), _ceb_getb(am, base, node, 1));
 
 	switch (key_type) {
 	case CEB_KT_ADDR:
 	case CEB_KT_U32:
 	case CEB_KT_U64:
-		if (node->b[0] == node->b[1])
-			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d\\nkey=%llu\\n\" fillcolor=\"green\"%s];\n",
-			       (long)node, (long)node, level, int_key, (ctx == node) ? " color=red" : "");
+	case CEB_KT_I32:
+	case CEB_KT_I64:
+	case CEB_KT_U16:
+	case CEB_KT_U8:
+	case CEB_KT_IU32:
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
+		if (_ceb_getb(am, base, node, 0) == _ceb_getb(am, base, node, 1))
+			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d\\nkey=%s%llu\\n\" fillcolor=\"green\"%s];\n",
+			       (long)node, (long)node, level, sign, int_key, (ctx == node) ? " color=red" : "");
+		else
+			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d bit=%d\\nkey=%s%llu\\n\" fillcolor=\"yellow\"%s];\n",
+			       (long)node, (long)node, level, flsnz(pxor) - 1, sign, int_key, (ctx == node) ? " color=red" : "");
+		break;
+	case CEB_KT_U128:
+		if (_ceb_getb(am, base, node, 0) == _ceb_getb(am, base, node, 1))
+			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d\\nkey=%#llx:%016llx\\n\" fillcolor=\"green\"%s];\n",
+			       (long)node, (long)node, level,
+			       (unsigned long long)NODEK(node, kofs)->u128[0], (unsigned long long)NODEK(node, kofs)->u128[1],
+			       (ctx == node) ? " color=red" : "");
 		else
-			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d bit=%d\\nkey=%llu\\n\" fillcolor=\"yellow\"%s];\n",
-			       (long)node, (long)node, level, flsnz(pxor) - 1, int_key, (ctx == node) ? " color=red" : "");
+			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d bit=%d\\nkey=%#llx:%016llx\\n\" fillcolor=\"yellow\"%s];\n",
+			       (long)node, (long)node, level, (int)pxor - 1,
+			       (unsigned long long)NODEK(node, kofs)->u128[0], (unsigned long long)NODEK(node, kofs)->u128[1],
+			       (ctx == node) ? " color=red" : "");
 		break;
 	case CEB_KT_MB:
 		break;
 	case CEB_KT_IM:
 		break;
+	case CEB_KT_VB:
+		break;
+	case CEB_KT_PB:
+		break;
 	case CEB_KT_ST:
-		if (node->b[0] == node->b[1])
+	case CEB_KT_SI:
+		if (_ceb_getb(am, base, node, 0) == _ceb_getb(am, base, node, 1))
 			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d\\nkey=\\\"%s\\\"\\n\" fillcolor=\"green\"%s];\n",
 			       (long)node, (long)node, level, NODEK(node, kofs)->str, (ctx == node) ? " color=red" : "");
 		else
@@ -1519,7 +4896,8 @@ static void cebu_default_dump_leaf(ptrdiff_t kofs, enum ceb_key_type key_type, c
 			       (long)node, (long)node, level, (long)pxor, NODEK(node, kofs)->str, (ctx == node) ? " color=red" : "");
 		break;
 	case CEB_KT_IS:
-		if (node->b[0] == node->b[1])
+	case CEB_KT_ISI:
+		if (_ceb_getb(am, base, node, 0) == _ceb_getb(am, base, node, 1))
 			printf("  \"%lx_l\" [label=\"%lx\\nlev=%d\\nkey=\\\"%s\\\"\\n\" fillcolor=\"green\"%s];\n",
 			       (long)node, (long)node, level, NODEK(node, kofs)->ptr, (ctx == node) ? " color=red" : "");
 		else
@@ -1529,17 +4907,54 @@ static void cebu_default_dump_leaf(ptrdiff_t kofs, enum ceb_key_type key_type, c
 	}
 }
 
+/* dump a duplicate, which never has a node part */
+__attribute__((unused))
+static void cebu_default_dump_dup(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx)
+{
+	switch (key_type) {
+	case CEB_KT_U32:
+	case CEB_KT_I32:
+	case CEB_KT_U16:
+	case CEB_KT_U8:
+	case CEB_KT_IU32:
+		printf("  \"%lx_l\" [label=\"%lx\\nlev=%d dup\\nkey=%llu\\n\" fillcolor=\"orange\"%s];\n",
+		       (long)node, (long)node, level, (unsigned long long)_ceb_k32(key_type, NODEK(node, kofs)), (ctx == node) ? " color=red" : "");
+		break;
+	case CEB_KT_U64:
+	case CEB_KT_I64:
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
+		printf("  \"%lx_l\" [label=\"%lx\\nlev=%d dup\\nkey=%llu\\n\" fillcolor=\"orange\"%s];\n",
+		       (long)node, (long)node, level, (unsigned long long)_ceb_k64(key_type, NODEK(node, kofs)), (ctx == node) ? " color=red" : "");
+		break;
+	case CEB_KT_ST:
+	case CEB_KT_SI:
+		printf("  \"%lx_l\" [label=\"%lx\\nlev=%d dup\\nkey=\\\"%s\\\"\\n\" fillcolor=\"orange\"%s];\n",
+		       (long)node, (long)node, level, NODEK(node, kofs)->str, (ctx == node) ? " color=red" : "");
+		break;
+	case CEB_KT_IS:
+	case CEB_KT_ISI:
+		printf("  \"%lx_l\" [label=\"%lx\\nlev=%d dup\\nkey=\\\"%s\\\"\\n\" fillcolor=\"orange\"%s];\n",
+		       (long)node, (long)node, level, (const char *)NODEK(node, kofs)->ptr, (ctx == node) ? " color=red" : "");
+		break;
+	default:
+		printf("  \"%lx_l\" [label=\"%lx\\nlev=%d dup\\n\" fillcolor=\"orange\"%s];\n",
+		       (long)node, (long)node, level, (ctx == node) ? " color=red" : "");
+		break;
+	}
+}
+
 /* Dumps a tree through the specified callbacks, falling back to the default
  * callbacks above if left NULL.
  */
 __attribute__((unused))
-static const struct ceb_node *cebu_default_dump_tree(ptrdiff_t kofs, enum ceb_key_type key_type, struct ceb_node *const *root,
+static const struct ceb_node *cebu_default_dump_tree(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, struct ceb_node *const *root,
                                                      uint64_t pxor, const void *last, int level, const void *ctx,
-                                                     void (*root_dump)(ptrdiff_t kofs, enum ceb_key_type key_type, struct ceb_node *const *root, const void *ctx),
-                                                     void (*node_dump)(ptrdiff_t kofs, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx),
-                                                     void (*leaf_dump)(ptrdiff_t kofs, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx))
+                                                     void (*root_dump)(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, struct ceb_node *const *root, const void *ctx),
+                                                     void (*node_dump)(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx),
+                                                     void (*leaf_dump)(ptrdiff_t kofs, enum ceb_addr_mode am, const void *base, enum ceb_key_type key_type, const struct ceb_node *node, int level, const void *ctx))
 {
-	const struct ceb_node *node = *root;
+	const struct ceb_node *node = _ceb_ld(am, base, root);
 	uint64_t xor;
 
 	if (!node) /* empty tree */
@@ -1556,44 +4971,70 @@ static const struct ceb_node *cebu_default_dump_tree(ptrdiff_t kofs, enum ceb_ke
 
 	if (!level) {
 		/* dump the first arrow */
-		root_dump(kofs, key_type, root, ctx);
+		root_dump(kofs, am, base, key_type, root, ctx);
+	}
+
+	if (__ceb_tagged(node)) {
+		/* list of duplicates, dump them from the last one to the
+		 * first, which is the one holding the key's leaf.
+		 */
+		const struct ceb_node *first;
+
+		node = __ceb_clrtag(node);
+		first = _ceb_getb(am, base, __ceb_clrtag(_ceb_getb(am, base, node, 1)), 0);
+		while (node != first) {
+			cebu_default_dump_dup(kofs, am, base, key_type, node, level, ctx);
+			printf("  \"%lx_l\" -> \"%lx_l\" [label=\"D\" arrowsize=0.66];\n",
+			       (long)node, (long)__ceb_clrtag(_ceb_getb(am, base, node, 0)));
+			node = __ceb_clrtag(_ceb_getb(am, base, node, 0));
+		}
+		leaf_dump(kofs, am, base, key_type, node, level, ctx);
+		return node;
 	}
 
 	/* regular nodes, all branches are canonical */
 
-	if (node->b[0] == node->b[1]) {
+	if (_ceb_getb(am, base, node, 0) == _ceb_getb(am, base, node, 1)) {
 		/* first inserted leaf */
-		leaf_dump(kofs, key_type, node, level, ctx);
+		leaf_dump(kofs, am, base, key_type, node, level, ctx);
 		return node;
 	}
 
 	xor = _xor_branches(kofs, key_type, 0, 0, NULL,
-			    node->b[0], node->b[1]);
+			    _ceb_getb(am, base, node, 0), _ceb_getb(am, base, node, 1));
 
 	switch (key_type) {
 	case CEB_KT_ADDR:
 	case CEB_KT_U32:
 	case CEB_KT_U64:
+	case CEB_KT_I32:
+	case CEB_KT_I64:
+	case CEB_KT_U16:
+	case CEB_KT_U8:
+	case CEB_KT_IU32:
+	case CEB_KT_IU64:
+	case CEB_KT_P32:
+	case CEB_KT_U128:
 		if (pxor && xor >= pxor) {
 			/* that's a leaf for a scalar type */
-			leaf_dump(kofs, key_type, node, level, ctx);
+			leaf_dump(kofs, am, base, key_type, node, level, ctx);
 			return node;
 		}
 		break;
 	default:
 		if (pxor && xor <= pxor) {
 			/* that's a leaf for a non-scalar type */
-			leaf_dump(kofs, key_type, node, level, ctx);
+			leaf_dump(kofs, am, base, key_type, node, level, ctx);
 			return node;
 		}
 		break;
 	}
 
 	/* that's a regular node */
-	node_dump(kofs, key_type, node, level, ctx);
+	node_dump(kofs, am, base, key_type, node, level, ctx);
 
-	last = cebu_default_dump_tree(kofs, key_type, &node->b[0], xor, last, level + 1, ctx, root_dump, node_dump, leaf_dump);
-	return cebu_default_dump_tree(kofs, key_type, &node->b[1], xor, last, level + 1, ctx, root_dump, node_dump, leaf_dump);
+	last = cebu_default_dump_tree(kofs, am, base, key_type, _ceb_br(am, node, 0), xor, last, level + 1, ctx, root_dump, node_dump, leaf_dump);
+	return cebu_default_dump_tree(kofs, am, base, key_type, _ceb_br(am, node, 1), xor, last, level + 1, ctx, root_dump, node_dump, leaf_dump);
 }
 
 
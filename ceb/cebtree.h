@@ -28,6 +28,7 @@
 #define _CEBTREE_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include "../common/tools.h"
 
 /* Standard node when using absolute pointers */
@@ -35,12 +36,118 @@ struct ceb_node {
 	struct ceb_node *b[2]; /* branches: 0=left, 1=right */
 };
 
+/* Node using large relative addressing ("q" model): each branch contains the
+ * signed distance in bytes between its own location and the node it refers
+ * to, plus one, and zero for NULL. Such trees, including their root which is
+ * a single int64_t branch, may be moved or mapped anywhere in memory as long
+ * as the relative positions of the root and nodes are preserved.
+ */
+struct cebq_node {
+	int64_t b[2]; /* branches: 0=left, 1=right */
+};
+
+/* Node using medium relative addressing ("m" model): each branch contains the
+ * signed distance between its own location and the node it refers to in
+ * 4-byte units, plus one, and zero for NULL. Nodes only take 8 bytes, but they
+ * must all be located less than 2 GB away from the root (a single int32_t
+ * branch), otherwise they are rejected upon insertion.
+ */
+struct cebm_node {
+	int32_t b[2]; /* branches: 0=left, 1=right */
+};
+
+/* Node using small relative addressing ("h" model): each branch contains the
+ * signed distance between its own location and the node it refers to in
+ * 2-byte units, plus one, and zero for NULL. Nodes only take 4 bytes, but they
+ * must all be located in the 64 kB following the root (a single int16_t
+ * branch), otherwise they are rejected upon insertion.
+ */
+struct cebh_node {
+	int16_t b[2]; /* branches: 0=left, 1=right */
+};
+
+/* Node using index addressing ("x" model): each branch contains the position
+ * of the node it refers to relative to a base address passed to all functions,
+ * in 4-byte units, plus one, and zero for NULL. The root is a single uint32_t
+ * branch which may be stored anywhere. As long as the positions of the nodes
+ * relative to the base are preserved (e.g. when all nodes are stored in an
+ * array that gets reallocated), the tree remains valid once the new base is
+ * passed. Nodes located before the base or 16 GB or more past it are rejected
+ * upon insertion.
+ */
+struct cebx_node {
+	uint32_t b[2]; /* branches: 0=left, 1=right */
+};
+
+/* By default, keys immediately follow the node, which is only 4 or 8 bytes
+ * long in the small, medium and index models. Integer keys of 32 bits or less
+ * only need to be aligned on their own size there. All other keys (64-bit and
+ * larger integers, blocks, strings and pointers to indirect keys) are accessed
+ * as members of a union which requires the alignment of a 64-bit integer, so
+ * they must be placed at such an address, for example by padding the key and
+ * using the "_ofs" variants of the functions.
+ */
+
+/* Callback used by walk functions, called for each visited node with the
+ * caller's argument. It stops the walk by returning non-zero, and must not
+ * modify the tree. Nodes of relative trees (cebq, cebm, cebh, cebx) are passed
+ * as a struct ceb_node pointer which has to be cast back to their type.
+ */
+typedef int (*ceb_walk_cb)(struct ceb_node *node, void *arg);
+
+/* Callback used by range deletions, called for each deleted node with the
+ * caller's argument once the node was unlinked and marked as deleted, so that
+ * it may release it. It must not modify the tree. Nodes of relative trees are
+ * passed the same way as to walk callbacks.
+ */
+typedef void (*ceb_free_cb)(struct ceb_node *node, void *arg);
+
+/* Random generator used by random lookups, called with the caller's argument.
+ * It must return 32 random bits.
+ */
+typedef uint32_t (*ceb_rnd_cb)(void *arg);
+
+/* number of ancestors an iterator may keep, enough for 128-bit keys */
+#define CEB_ITER_DEPTH 130
+
+/* Iterator over a tree of unique keys, used by the *_iter_*() functions. It
+ * keeps the path from the root to its current node, so that stepping to a
+ * neighbour only climbs up to the closest ancestor where the path turns and
+ * descends from there. It's bound to a tree by *_iter_init(), and is either
+ * on a node or off the tree, in which case stepping forwards or backwards
+ * returns the first or last node. Each link of the path that is crossed back
+ * is checked, as well as the ancestor where the path turns, so that a
+ * modification of the tree affecting the part of the path being used marks
+ * the iterator stale, after which it returns no more nodes until it's
+ * initialized or seeks again. Other modifications are seen as they happen.
+ * Since these checks read the recorded ancestors, nodes removed from the tree
+ * must remain readable until then.
+ */
+struct ceb_iter {
+	void *root;                 /* the tree's root, whatever its type */
+	const void *base;           /* base address for cebx trees */
+	struct ceb_node *node;      /* current node, or NULL when off the tree */
+	int depth;                  /* entries in path[], -1 when too deep */
+	int stale;                  /* the tree was modified under the iterator */
+	struct {
+		struct ceb_node *node;  /* ancestor of the current node */
+		uint64_t split;         /* its split value, used to find leaves */
+		int side;               /* the branch taken towards the current node */
+	} path[CEB_ITER_DEPTH];
+};
+
 /* indicates whether a valid node is in a tree or not */
 static inline int ceb_intree(const struct ceb_node *node)
 {
 	return !!node->b[0];
 }
 
+/* returns non-zero if the iterator detected a modification of its tree */
+static inline int ceb_iter_stale(const struct ceb_iter *iter)
+{
+	return iter->stale;
+}
+
 /* tag an untagged pointer */
 static inline struct ceb_node *__ceb_dotag(const struct ceb_node *node)
 {
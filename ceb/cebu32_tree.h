@@ -31,28 +31,50 @@
 struct ceb_node *cebu32_insert(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu32_first(struct ceb_node **root);
 struct ceb_node *cebu32_last(struct ceb_node **root);
+struct ceb_node *cebu32_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg);
+void cebu32_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebu32_iter_next(struct ceb_iter *iter);
+struct ceb_node *cebu32_iter_prev(struct ceb_iter *iter);
+struct ceb_node *cebu32_iter_seek(struct ceb_iter *iter, uint32_t key);
+struct ceb_node *cebu32_walk_range(struct ceb_node **root, uint32_t lo, uint32_t hi, ceb_walk_cb cb, void *arg);
+size_t cebu32_count_range(struct ceb_node **root, uint32_t lo, uint32_t hi);
 struct ceb_node *cebu32_lookup(struct ceb_node **root, uint32_t key);
 struct ceb_node *cebu32_lookup_le(struct ceb_node **root, uint32_t key);
 struct ceb_node *cebu32_lookup_lt(struct ceb_node **root, uint32_t key);
 struct ceb_node *cebu32_lookup_ge(struct ceb_node **root, uint32_t key);
 struct ceb_node *cebu32_lookup_gt(struct ceb_node **root, uint32_t key);
+struct ceb_node *cebu32_lookup_bracket(struct ceb_node **root, uint32_t key, struct ceb_node **prev, struct ceb_node **next);
 struct ceb_node *cebu32_next(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu32_prev(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu32_delete(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu32_pick(struct ceb_node **root, uint32_t key);
+size_t cebu32_delete_range(struct ceb_node **root, uint32_t lo, uint32_t hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebu32_lookup_xor_nearest(struct ceb_node **root, uint32_t key);
+struct ceb_node *cebu32_lookup_xor_next(struct ceb_node **root, uint32_t key, struct ceb_node *node);
 void cebu32_default_dump(struct ceb_node **ceb_root, const char *label, const void *ctx);
 
 /* version taking a key offset */
 struct ceb_node *cebu32_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu32_ofs_first(struct ceb_node **root, ptrdiff_t kofs);
 struct ceb_node *cebu32_ofs_last(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebu32_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebu32_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebu32_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebu32_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebu32_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, uint32_t key);
+struct ceb_node *cebu32_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, uint32_t lo, uint32_t hi, ceb_walk_cb cb, void *arg);
+size_t cebu32_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, uint32_t lo, uint32_t hi);
 struct ceb_node *cebu32_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
 struct ceb_node *cebu32_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
 struct ceb_node *cebu32_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
 struct ceb_node *cebu32_ofs_lookup_ge(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
 struct ceb_node *cebu32_ofs_lookup_gt(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
+struct ceb_node *cebu32_ofs_lookup_bracket(struct ceb_node **root, ptrdiff_t kofs, uint32_t key, struct ceb_node **prev, struct ceb_node **next);
 struct ceb_node *cebu32_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu32_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu32_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu32_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
+size_t cebu32_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, uint32_t lo, uint32_t hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebu32_ofs_lookup_xor_nearest(struct ceb_node **root, ptrdiff_t kofs, uint32_t key);
+struct ceb_node *cebu32_ofs_lookup_xor_next(struct ceb_node **root, ptrdiff_t kofs, uint32_t key, struct ceb_node *node);
 void cebu32_ofs_default_dump(struct ceb_node **root, ptrdiff_t kofs, const char *label, const void *ctx);
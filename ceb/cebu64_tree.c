@@ -46,19 +46,81 @@ CEB_FDECL3(struct ceb_node *, cebu64, _insert, struct ceb_node **, root, ptrdiff
 {
 	uint64_t key = NODEK(node, kofs)->u64;
 
-	return _cebu_insert(root, node, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* return the first node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebu64, _first, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_first(root, kofs, CEB_KT_U64);
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64);
 }
 
 /* return the last node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebu64, _last, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_last(root, kofs, CEB_KT_U64);
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebu64, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebu64, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebu64, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_U64, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebu64, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_U64, 0, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, uint64_t, key)
+{
+	return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_U64, 0, key, NULL);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEB_FDECL6(struct ceb_node *, cebu64, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, lo, uint64_t, hi, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ */
+CEB_FDECL4(size_t, cebu64, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, lo, uint64_t, hi)
+{
+	return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL);
 }
 
 /* look up the specified key, and returns either the node containing it, or
@@ -66,7 +128,7 @@ CEB_FDECL2(struct ceb_node *, cebu64, _last, struct ceb_node **, root, ptrdiff_t
  */
 CEB_FDECL3(struct ceb_node *, cebu64, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
 {
-	return _cebu_lookup(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified key or the highest below it, and returns either the
@@ -74,7 +136,7 @@ CEB_FDECL3(struct ceb_node *, cebu64, _lookup, struct ceb_node **, root, ptrdiff
  */
 CEB_FDECL3(struct ceb_node *, cebu64, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
 {
-	return _cebu_lookup_le(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up highest key below the specified one, and returns either the
@@ -82,7 +144,7 @@ CEB_FDECL3(struct ceb_node *, cebu64, _lookup_le, struct ceb_node **, root, ptrd
  */
 CEB_FDECL3(struct ceb_node *, cebu64, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
 {
-	return _cebu_lookup_lt(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified key or the smallest above it, and returns either the
@@ -90,7 +152,7 @@ CEB_FDECL3(struct ceb_node *, cebu64, _lookup_lt, struct ceb_node **, root, ptrd
  */
 CEB_FDECL3(struct ceb_node *, cebu64, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
 {
-	return _cebu_lookup_ge(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the smallest key above the specified one, and returns either the
@@ -98,7 +160,17 @@ CEB_FDECL3(struct ceb_node *, cebu64, _lookup_ge, struct ceb_node **, root, ptrd
  */
 CEB_FDECL3(struct ceb_node *, cebu64, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
 {
-	return _cebu_lookup_gt(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the specified key, and returns either the node containing it, or
+ * NULL if not found. The nodes immediately below and above the key are
+ * returned in <prev> and <next> respectively, or NULL if there is none. This
+ * is cheaper than a lookup_le() followed by a lookup_ge().
+ */
+CEB_FDECL5(struct ceb_node *, cebu64, _lookup_bracket, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key, struct ceb_node **, prev, struct ceb_node **, next)
+{
+	return _cebu_lookup_bracket(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL, prev, next);
 }
 
 /* search for the next node after the specified one, and return it, or NULL if
@@ -110,7 +182,7 @@ CEB_FDECL3(struct ceb_node *, cebu64, _next, struct ceb_node **, root, ptrdiff_t
 {
 	uint64_t key = NODEK(node, kofs)->u64;
 
-	return _cebu_next(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* search for the prev node before the specified one, and return it, or NULL if
@@ -122,7 +194,7 @@ CEB_FDECL3(struct ceb_node *, cebu64, _prev, struct ceb_node **, root, ptrdiff_t
 {
 	uint64_t key = NODEK(node, kofs)->u64;
 
-	return _cebu_prev(root, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified node with its key and deletes it if found, and in any
@@ -132,7 +204,7 @@ CEB_FDECL3(struct ceb_node *, cebu64, _delete, struct ceb_node **, root, ptrdiff
 {
 	uint64_t key = NODEK(node, kofs)->u64;
 
-	return _cebu_delete(root, node, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified key, and detaches it and returns it if found, or NULL
@@ -140,7 +212,49 @@ CEB_FDECL3(struct ceb_node *, cebu64, _delete, struct ceb_node **, root, ptrdiff
  */
 CEB_FDECL3(struct ceb_node *, cebu64, _pick, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
 {
-	return _cebu_delete(root, NULL, kofs, CEB_KT_U64, 0, key, NULL);
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Each deleted node is passed to <free_cb> with <arg>
+ * once detached, unless <free_cb> is NULL. The nodes are not passed in any
+ * particular order.
+ */
+CEB_FDECL6(size_t, cebu64, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, lo, uint64_t, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL, free_cb, arg);
+}
+
+/* look up the node whose key is the closest to the specified one by XOR
+ * distance, i.e. sharing the longest leading bits with it, and returns it, or
+ * NULL if the tree is empty. This only takes a single descent.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64, _lookup_xor_nearest, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key)
+{
+	return _cebu_xor_nearest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL, NULL);
+}
+
+/* look up the node following <node> by XOR distance to the specified key,
+ * and returns it, or NULL if <node> was the farthest one. Starting from
+ * lookup_xor_nearest() and calling this one k-1 times returns the k nearest
+ * nodes in ascending distance order, at the cost of one descent each. <node>
+ * must be in the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebu64, _lookup_xor_next, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, key, struct ceb_node *, node)
+{
+	return _cebu_xor_nearest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL, node);
+}
+
+/* estimates the number of nodes whose key lies between <lo> and <hi>
+ * inclusive, without visiting them all. Only the nodes crossing the range
+ * boundaries and the <depth> first levels of the subtrees within the range are
+ * visited, the size of the deeper ones is estimated from one random descent
+ * each. The estimate gets more accurate as <depth> grows, and is exact once it
+ * exceeds the tree's height (e.g. ~0U).
+ */
+CEB_FDECL5(size_t, cebu64, _count_estimate, struct ceb_node **, root, ptrdiff_t, kofs, uint64_t, lo, uint64_t, hi, unsigned int, depth)
+{
+	return _cebu_count_estimate(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, lo, hi, depth);
 }
 
 /* dumps a ceb_node tree using the default functions above. If a node matches
@@ -157,7 +271,7 @@ CEB_FDECL4(void, cebu64, _default_dump, struct ceb_node **, root, ptrdiff_t, kof
 	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
 	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
 
-	cebu_default_dump_tree(kofs, CEB_KT_U64, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, CEB_KT_U64, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
 
 	printf("}\n");
 }
@@ -31,28 +31,52 @@
 struct ceb_node *cebu64_insert(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu64_first(struct ceb_node **root);
 struct ceb_node *cebu64_last(struct ceb_node **root);
+struct ceb_node *cebu64_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg);
+void cebu64_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebu64_iter_next(struct ceb_iter *iter);
+struct ceb_node *cebu64_iter_prev(struct ceb_iter *iter);
+struct ceb_node *cebu64_iter_seek(struct ceb_iter *iter, uint64_t key);
+struct ceb_node *cebu64_walk_range(struct ceb_node **root, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebu64_count_range(struct ceb_node **root, uint64_t lo, uint64_t hi);
 struct ceb_node *cebu64_lookup(struct ceb_node **root, uint64_t key);
 struct ceb_node *cebu64_lookup_le(struct ceb_node **root, uint64_t key);
 struct ceb_node *cebu64_lookup_lt(struct ceb_node **root, uint64_t key);
 struct ceb_node *cebu64_lookup_ge(struct ceb_node **root, uint64_t key);
 struct ceb_node *cebu64_lookup_gt(struct ceb_node **root, uint64_t key);
+struct ceb_node *cebu64_lookup_bracket(struct ceb_node **root, uint64_t key, struct ceb_node **prev, struct ceb_node **next);
 struct ceb_node *cebu64_next(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu64_prev(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu64_delete(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebu64_pick(struct ceb_node **root, uint64_t key);
+size_t cebu64_delete_range(struct ceb_node **root, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebu64_lookup_xor_nearest(struct ceb_node **root, uint64_t key);
+struct ceb_node *cebu64_lookup_xor_next(struct ceb_node **root, uint64_t key, struct ceb_node *node);
+size_t cebu64_count_estimate(struct ceb_node **root, uint64_t lo, uint64_t hi, unsigned int depth);
 void cebu64_default_dump(struct ceb_node **ceb_root, const char *label, const void *ctx);
 
 /* version taking a key offset */
 struct ceb_node *cebu64_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu64_ofs_first(struct ceb_node **root, ptrdiff_t kofs);
 struct ceb_node *cebu64_ofs_last(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebu64_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebu64_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebu64_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebu64_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebu64_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, uint64_t key);
+struct ceb_node *cebu64_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebu64_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, uint64_t lo, uint64_t hi);
 struct ceb_node *cebu64_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
 struct ceb_node *cebu64_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
 struct ceb_node *cebu64_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
 struct ceb_node *cebu64_ofs_lookup_ge(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
 struct ceb_node *cebu64_ofs_lookup_gt(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
+struct ceb_node *cebu64_ofs_lookup_bracket(struct ceb_node **root, ptrdiff_t kofs, uint64_t key, struct ceb_node **prev, struct ceb_node **next);
 struct ceb_node *cebu64_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu64_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu64_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebu64_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
+size_t cebu64_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebu64_ofs_lookup_xor_nearest(struct ceb_node **root, ptrdiff_t kofs, uint64_t key);
+struct ceb_node *cebu64_ofs_lookup_xor_next(struct ceb_node **root, ptrdiff_t kofs, uint64_t key, struct ceb_node *node);
+size_t cebu64_ofs_count_estimate(struct ceb_node **root, ptrdiff_t kofs, uint64_t lo, uint64_t hi, unsigned int depth);
 void cebu64_ofs_default_dump(struct ceb_node **root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -0,0 +1,235 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on signed 64-bit keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebu64i_*" and one with "cebu64i_ofs_*" which takes a key  *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct ceb_node) in *
+ * the call to the underlying functions.                                     *
+\*****************************************************************************/
+
+/* Inserts node <node> into unique tree <tree> based on its key that
+ * immediately follows the node. Returns the inserted node or the one
+ * that already contains the same key.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _insert, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = NODEK(node, kofs)->u64;
+
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* return the first node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebu64i, _first, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64);
+}
+
+/* return the last node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebu64i, _last, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebu64i, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebu64i, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebu64i, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_I64, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebu64i, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_I64, 0, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_I64, 0, key, NULL);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEB_FDECL6(struct ceb_node *, cebu64i, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, lo, int64_t, hi, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, lo, NULL, 0, hi, NULL, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ */
+CEB_FDECL4(size_t, cebu64i, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, lo, int64_t, hi)
+{
+	return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, lo, NULL, 0, hi, NULL);
+}
+
+/* look up the specified key, and returns either the node containing it, or
+ * NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* look up the specified key or the highest below it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* look up highest key below the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* look up the specified key or the smallest above it, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* look up the smallest key above the specified one, and returns either the
+ * node containing it, or NULL if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a left turn was made, and returning the first node along the right
+ * branch at that fork.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _next, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = NODEK(node, kofs)->u64;
+
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found. The approach consists in looking up that node, recalling the last
+ * time a right turn was made, and returning the last node along the left
+ * branch at that fork.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _prev, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = NODEK(node, kofs)->u64;
+
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _delete, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = NODEK(node, kofs)->u64;
+
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* look up the specified key, and detaches it and returns it if found, or NULL
+ * if not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebu64i, _pick, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, key)
+{
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, key, NULL);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Each deleted node is passed to <free_cb> with <arg>
+ * once detached, unless <free_cb> is NULL. The nodes are not passed in any
+ * particular order.
+ */
+CEB_FDECL6(size_t, cebu64i, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, int64_t, lo, int64_t, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_I64, 0, lo, NULL, 0, hi, NULL, free_cb, arg);
+}
+
+/* dumps a ceb_node tree using the default functions above. If a node matches
+ * <ctx>, this one will be highlighted in red.
+ */
+CEB_FDECL4(void, cebu64i, _default_dump, struct ceb_node **, root, ptrdiff_t, kofs, const char *, label, const void *, ctx)
+{
+	printf("\ndigraph cebu64i_tree {\n"
+	       "  fontname=\"fixed\";\n"
+	       "  fontsize=8\n"
+	       "  label=\"%s\"\n"
+	       "", label);
+
+	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
+	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
+
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, CEB_KT_I64, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+
+	printf("}\n");
+}
@@ -43,19 +43,81 @@
  */
 CEB_FDECL3(struct ceb_node *, cebua, _insert, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
 {
-	return _cebu_insert(root, node, kofs, CEB_KT_ADDR, 0, 0, node);
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, node);
 }
 
 /* return the first node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebua, _first, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_first(root, kofs, CEB_KT_ADDR);
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR);
 }
 
 /* return the last node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebua, _last, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_last(root, kofs, CEB_KT_ADDR);
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebua, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebua, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebua, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_ADDR, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebua, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_ADDR, 0, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEB_FDECL3(struct ceb_node *, cebua, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, const void *, key)
+{
+	return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_ADDR, 0, 0, key);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEB_FDECL6(struct ceb_node *, cebua, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, lo, 0, 0, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ */
+CEB_FDECL4(size_t, cebua, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi)
+{
+	return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, lo, 0, 0, hi);
 }
 
 /* look up the specified key, and returns either the node containing it, or
@@ -63,7 +125,7 @@ CEB_FDECL2(struct ceb_node *, cebua, _last, struct ceb_node **, root, ptrdiff_t,
  */
 CEB_FDECL3(struct ceb_node *, cebua, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup(root, kofs, CEB_KT_ADDR, 0, 0, key);
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, key);
 }
 
 /* look up the specified key or the highest below it, and returns either the
@@ -71,7 +133,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _lookup, struct ceb_node **, root, ptrdiff_
  */
 CEB_FDECL3(struct ceb_node *, cebua, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_le(root, kofs, CEB_KT_ADDR, 0, 0, key);
+	return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, key);
 }
 
 /* look up highest key below the specified one, and returns either the
@@ -79,7 +141,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _lookup_le, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebua, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_lt(root, kofs, CEB_KT_ADDR, 0, 0, key);
+	return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, key);
 }
 
 /* look up the specified key or the smallest above it, and returns either the
@@ -87,7 +149,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _lookup_lt, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebua, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_ge(root, kofs, CEB_KT_ADDR, 0, 0, key);
+	return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, key);
 }
 
 /* look up the smallest key above the specified one, and returns either the
@@ -95,7 +157,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _lookup_ge, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebua, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_gt(root, kofs, CEB_KT_ADDR, 0, 0, key);
+	return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, key);
 }
 
 /* search for the next node after the specified one, and return it, or NULL if
@@ -105,7 +167,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _lookup_gt, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebua, _next, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
 {
-	return _cebu_next(root, kofs, CEB_KT_ADDR, 0, 0, node);
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, node);
 }
 
 /* search for the prev node before the specified one, and return it, or NULL if
@@ -115,7 +177,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _next, struct ceb_node **, root, ptrdiff_t,
  */
 CEB_FDECL3(struct ceb_node *, cebua, _prev, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
 {
-	return _cebu_prev(root, kofs, CEB_KT_ADDR, 0, 0, node);
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, node);
 }
 
 /* look up the specified node with its key and deletes it if found, and in any
@@ -123,7 +185,7 @@ CEB_FDECL3(struct ceb_node *, cebua, _prev, struct ceb_node **, root, ptrdiff_t,
  */
 CEB_FDECL3(struct ceb_node *, cebua, _delete, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
 {
-	return _cebu_delete(root, node, kofs, CEB_KT_ADDR, 0, 0, node);
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, node);
 }
 
 /* look up the specified key, and detaches it and returns it if found, or NULL
@@ -131,7 +193,17 @@ CEB_FDECL3(struct ceb_node *, cebua, _delete, struct ceb_node **, root, ptrdiff_
  */
 CEB_FDECL3(struct ceb_node *, cebua, _pick, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_delete(root, NULL, kofs, CEB_KT_ADDR, 0, 0, key);
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Each deleted node is passed to <free_cb> with <arg>
+ * once detached, unless <free_cb> is NULL. The nodes are not passed in any
+ * particular order.
+ */
+CEB_FDECL6(size_t, cebua, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, 0, 0, lo, 0, 0, hi, free_cb, arg);
 }
 
 /* dumps a ceb_node tree using the default functions above. If a node matches
@@ -148,7 +220,7 @@ CEB_FDECL4(void, cebua, _default_dump, struct ceb_node **, root, ptrdiff_t, kofs
 	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
 	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
 
-	cebu_default_dump_tree(kofs, CEB_KT_ADDR, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, CEB_KT_ADDR, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
 
 	printf("}\n");
 }
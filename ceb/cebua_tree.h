@@ -30,6 +30,13 @@
 struct ceb_node *cebua_insert(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebua_first(struct ceb_node **root);
 struct ceb_node *cebua_last(struct ceb_node **root);
+struct ceb_node *cebua_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg);
+void cebua_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebua_iter_next(struct ceb_iter *iter);
+struct ceb_node *cebua_iter_prev(struct ceb_iter *iter);
+struct ceb_node *cebua_iter_seek(struct ceb_iter *iter, const void *key);
+struct ceb_node *cebua_walk_range(struct ceb_node **root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebua_count_range(struct ceb_node **root, const void *lo, const void *hi);
 struct ceb_node *cebua_lookup(struct ceb_node **root, const void *key);
 struct ceb_node *cebua_lookup_le(struct ceb_node **root, const void *key);
 struct ceb_node *cebua_lookup_lt(struct ceb_node **root, const void *key);
@@ -39,12 +46,20 @@ struct ceb_node *cebua_next(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebua_prev(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebua_delete(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebua_pick(struct ceb_node **root, const void *key);
+size_t cebua_delete_range(struct ceb_node **root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
 void cebua_default_dump(struct ceb_node **root, const char *label, const void *ctx);
 
 /* version taking a key offset */
 struct ceb_node *cebua_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebua_ofs_first(struct ceb_node **root, ptrdiff_t kofs);
 struct ceb_node *cebua_ofs_last(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebua_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebua_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebua_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebua_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebua_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebua_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebua_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi);
 struct ceb_node *cebua_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, const void *key);
 struct ceb_node *cebua_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, const void *key);
 struct ceb_node *cebua_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, const void *key);
@@ -54,4 +69,5 @@ struct ceb_node *cebua_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct c
 struct ceb_node *cebua_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebua_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebua_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+size_t cebua_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
 void cebua_ofs_default_dump(struct ceb_node **root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -30,6 +30,13 @@
 struct ceb_node *cebub_insert(struct ceb_node **root, struct ceb_node *node, size_t len);
 struct ceb_node *cebub_first(struct ceb_node **root);
 struct ceb_node *cebub_last(struct ceb_node **root);
+struct ceb_node *cebub_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg, size_t len);
+void cebub_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebub_iter_next(struct ceb_iter *iter, size_t len);
+struct ceb_node *cebub_iter_prev(struct ceb_iter *iter, size_t len);
+struct ceb_node *cebub_iter_seek(struct ceb_iter *iter, const void *key, size_t len);
+struct ceb_node *cebub_walk_range(struct ceb_node **root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebub_count_range(struct ceb_node **root, const void *lo, const void *hi, size_t len);
 struct ceb_node *cebub_lookup(struct ceb_node **root, const void *key, size_t len);
 struct ceb_node *cebub_lookup_le(struct ceb_node **root, const void *key, size_t len);
 struct ceb_node *cebub_lookup_lt(struct ceb_node **root, const void *key, size_t len);
@@ -39,11 +46,21 @@ struct ceb_node *cebub_next(struct ceb_node **root, struct ceb_node *node, size_
 struct ceb_node *cebub_prev(struct ceb_node **root, struct ceb_node *node, size_t len);
 struct ceb_node *cebub_delete(struct ceb_node **root, struct ceb_node *node, size_t len);
 struct ceb_node *cebub_pick(struct ceb_node **root, const void *key, size_t len);
+size_t cebub_delete_range(struct ceb_node **root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
+struct ceb_node *cebub_lookup_xor_nearest(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebub_lookup_xor_next(struct ceb_node **root, const void *key, size_t len, struct ceb_node *node);
 
 /* version taking a key offset */
 struct ceb_node *cebub_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node, size_t len);
 struct ceb_node *cebub_ofs_first(struct ceb_node **root, ptrdiff_t kofs, size_t len);
 struct ceb_node *cebub_ofs_last(struct ceb_node **root, ptrdiff_t kofs, size_t len);
+struct ceb_node *cebub_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg, size_t len);
+void cebub_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebub_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct ceb_node *cebub_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct ceb_node *cebub_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebub_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebub_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, size_t len);
 struct ceb_node *cebub_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
 struct ceb_node *cebub_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
 struct ceb_node *cebub_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
@@ -53,3 +70,6 @@ struct ceb_node *cebub_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct c
 struct ceb_node *cebub_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node, size_t len);
 struct ceb_node *cebub_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node, size_t len);
 struct ceb_node *cebub_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+size_t cebub_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
+struct ceb_node *cebub_ofs_lookup_xor_nearest(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebub_ofs_lookup_xor_next(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len, struct ceb_node *node);
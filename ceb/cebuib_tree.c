@@ -47,19 +47,84 @@ CEB_FDECL4(struct ceb_node *, cebuib, _insert, struct ceb_node **, root, ptrdiff
 {
 	const void *key = NODEK(node, kofs)->ptr;
 
-	return _cebu_insert(root, node, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* return the first node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebuib, _first, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_first(root, kofs, CEB_KT_IM);
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM);
 }
 
 /* return the last node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebuib, _last, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_last(root, kofs, CEB_KT_IM);
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM);
+}
+
+/* calls <cb> with <arg> for each node in ascending order of keys of <len>
+ * bytes, visiting each of them once, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes were
+ * visited. <cb> must not modify the tree.
+ */
+CEB_FDECL5(struct ceb_node *, cebuib, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, len, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebuib, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. Keys are <len> bytes long. NULL is also returned once the
+ * iterator is stale.
+ */
+CEB_FDECL3(struct ceb_node *, cebuib, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs, size_t, len)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_IM, len, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. Keys are <len> bytes long. NULL is also returned once the
+ * iterator is stale.
+ */
+CEB_FDECL3(struct ceb_node *, cebuib, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs, size_t, len)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_IM, len, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEB_FDECL4(struct ceb_node *, cebuib, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_IM, 0, len, key);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Keys are <len> bytes long. Returns the node the walk stopped
+ * on, or NULL once all nodes in the range were visited. The walk descends
+ * once towards <lo>, then visits the following nodes until the first one
+ * past <hi>. <cb> must not modify the tree.
+ */
+CEB_FDECL7(struct ceb_node *, cebuib, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg, size_t, len)
+{
+	return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, lo, 0, len, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ * Keys are <len> bytes long.
+ */
+CEB_FDECL5(size_t, cebuib, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, size_t, len)
+{
+	return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, lo, 0, len, hi);
 }
 
 /* look up the specified key <key> of length <len>, and returns either the node
@@ -67,7 +132,7 @@ CEB_FDECL2(struct ceb_node *, cebuib, _last, struct ceb_node **, root, ptrdiff_t
  */
 CEB_FDECL4(struct ceb_node *, cebuib, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
 {
-	return _cebu_lookup(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* look up the specified key or the highest below it, and returns either the
@@ -75,7 +140,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _lookup, struct ceb_node **, root, ptrdiff
  */
 CEB_FDECL4(struct ceb_node *, cebuib, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
 {
-	return _cebu_lookup_le(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* look up highest key below the specified one, and returns either the
@@ -83,7 +148,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _lookup_le, struct ceb_node **, root, ptrd
  */
 CEB_FDECL4(struct ceb_node *, cebuib, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
 {
-	return _cebu_lookup_lt(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* look up the specified key or the smallest above it, and returns either the
@@ -91,7 +156,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _lookup_lt, struct ceb_node **, root, ptrd
  */
 CEB_FDECL4(struct ceb_node *, cebuib, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
 {
-	return _cebu_lookup_ge(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* look up the smallest key above the specified one, and returns either the
@@ -99,7 +164,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _lookup_ge, struct ceb_node **, root, ptrd
  */
 CEB_FDECL4(struct ceb_node *, cebuib, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
 {
-	return _cebu_lookup_gt(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* search for the next node after the specified one, and return it, or NULL if
@@ -112,7 +177,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _next, struct ceb_node **, root, ptrdiff_t
 {
 	const void *key = NODEK(node, kofs)->ptr;
 
-	return _cebu_next(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* search for the prev node before the specified one, and return it, or NULL if
@@ -125,7 +190,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _prev, struct ceb_node **, root, ptrdiff_t
 {
 	const void *key = NODEK(node, kofs)->ptr;
 
-	return _cebu_prev(root, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* look up the specified node with its key and deletes it if found, and in any
@@ -136,7 +201,7 @@ CEB_FDECL4(struct ceb_node *, cebuib, _delete, struct ceb_node **, root, ptrdiff
 {
 	const void *key = NODEK(node, kofs)->ptr;
 
-	return _cebu_delete(root, node, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
 }
 
 /* look up the specified key, and detaches it and returns it if found, or NULL
@@ -144,5 +209,15 @@ CEB_FDECL4(struct ceb_node *, cebuib, _delete, struct ceb_node **, root, ptrdiff
  */
 CEB_FDECL4(struct ceb_node *, cebuib, _pick, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
 {
-	return _cebu_delete(root, NULL, kofs, CEB_KT_IM, 0, len, key);
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Keys are <len> bytes long. Each deleted node is
+ * passed to <free_cb> with <arg> once detached, unless <free_cb> is NULL.
+ * The nodes are not passed in any particular order.
+ */
+CEB_FDECL7(size_t, cebuib, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg, size_t, len)
+{
+	return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_IM, 0, len, lo, 0, len, hi, free_cb, arg);
 }
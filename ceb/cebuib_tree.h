@@ -30,6 +30,13 @@
 struct ceb_node *cebuib_insert(struct ceb_node **root, struct ceb_node *node, size_t len);
 struct ceb_node *cebuib_first(struct ceb_node **root);
 struct ceb_node *cebuib_last(struct ceb_node **root);
+struct ceb_node *cebuib_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg, size_t len);
+void cebuib_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebuib_iter_next(struct ceb_iter *iter, size_t len);
+struct ceb_node *cebuib_iter_prev(struct ceb_iter *iter, size_t len);
+struct ceb_node *cebuib_iter_seek(struct ceb_iter *iter, const void *key, size_t len);
+struct ceb_node *cebuib_walk_range(struct ceb_node **root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebuib_count_range(struct ceb_node **root, const void *lo, const void *hi, size_t len);
 struct ceb_node *cebuib_lookup(struct ceb_node **root, const void *key, size_t len);
 struct ceb_node *cebuib_lookup_le(struct ceb_node **root, const void *key, size_t len);
 struct ceb_node *cebuib_lookup_lt(struct ceb_node **root, const void *key, size_t len);
@@ -39,11 +46,19 @@ struct ceb_node *cebuib_next(struct ceb_node **root, struct ceb_node *node, size
 struct ceb_node *cebuib_prev(struct ceb_node **root, struct ceb_node *node, size_t len);
 struct ceb_node *cebuib_delete(struct ceb_node **root, struct ceb_node *node, size_t len);
 struct ceb_node *cebuib_pick(struct ceb_node **root, const void *key, size_t len);
+size_t cebuib_delete_range(struct ceb_node **root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
 
 /* version taking a key offset */
 struct ceb_node *cebuib_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node, size_t len);
 struct ceb_node *cebuib_ofs_first(struct ceb_node **root, ptrdiff_t kofs, size_t len);
 struct ceb_node *cebuib_ofs_last(struct ceb_node **root, ptrdiff_t kofs, size_t len);
+struct ceb_node *cebuib_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg, size_t len);
+void cebuib_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebuib_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct ceb_node *cebuib_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct ceb_node *cebuib_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuib_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebuib_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, size_t len);
 struct ceb_node *cebuib_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
 struct ceb_node *cebuib_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
 struct ceb_node *cebuib_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
@@ -53,3 +68,4 @@ struct ceb_node *cebuib_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct
 struct ceb_node *cebuib_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node, size_t len);
 struct ceb_node *cebuib_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node, size_t len);
 struct ceb_node *cebuib_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+size_t cebuib_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
@@ -30,28 +30,56 @@
 struct ceb_node *cebuis_insert(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebuis_first(struct ceb_node **root);
 struct ceb_node *cebuis_last(struct ceb_node **root);
+struct ceb_node *cebuis_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg);
+void cebuis_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebuis_iter_next(struct ceb_iter *iter);
+struct ceb_node *cebuis_iter_prev(struct ceb_iter *iter);
+struct ceb_node *cebuis_iter_seek(struct ceb_iter *iter, const void *key);
+struct ceb_node *cebuis_walk_range(struct ceb_node **root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebuis_count_range(struct ceb_node **root, const void *lo, const void *hi);
 struct ceb_node *cebuis_lookup(struct ceb_node **root, const void *key);
 struct ceb_node *cebuis_lookup_le(struct ceb_node **root, const void *key);
 struct ceb_node *cebuis_lookup_lt(struct ceb_node **root, const void *key);
 struct ceb_node *cebuis_lookup_ge(struct ceb_node **root, const void *key);
 struct ceb_node *cebuis_lookup_gt(struct ceb_node **root, const void *key);
+struct ceb_node *cebuis_lookup_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuis_lookup_le_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuis_lookup_lt_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuis_lookup_ge_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuis_lookup_gt_len(struct ceb_node **root, const void *key, size_t len);
 struct ceb_node *cebuis_next(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebuis_prev(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebuis_delete(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebuis_pick(struct ceb_node **root, const void *key);
+size_t cebuis_delete_range(struct ceb_node **root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebuis_walk_prefix(struct ceb_node **root, const void *prefix, ceb_walk_cb cb, void *arg);
 void cebuis_default_dump(struct ceb_node **root, const char *label, const void *ctx);
 
 /* version taking a key offset */
 struct ceb_node *cebuis_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebuis_ofs_first(struct ceb_node **root, ptrdiff_t kofs);
 struct ceb_node *cebuis_ofs_last(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebuis_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebuis_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebuis_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebuis_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebuis_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuis_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebuis_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi);
 struct ceb_node *cebuis_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, const void *key);
 struct ceb_node *cebuis_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, const void *key);
 struct ceb_node *cebuis_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, const void *key);
 struct ceb_node *cebuis_ofs_lookup_ge(struct ceb_node **root, ptrdiff_t kofs, const void *key);
 struct ceb_node *cebuis_ofs_lookup_gt(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuis_ofs_lookup_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuis_ofs_lookup_le_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuis_ofs_lookup_lt_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuis_ofs_lookup_ge_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuis_ofs_lookup_gt_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
 struct ceb_node *cebuis_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebuis_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebuis_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebuis_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+size_t cebuis_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebuis_ofs_walk_prefix(struct ceb_node **root, ptrdiff_t kofs, const void *prefix, ceb_walk_cb cb, void *arg);
 void cebuis_ofs_default_dump(struct ceb_node **root, ptrdiff_t kofs, const char *label, const void *ctx);
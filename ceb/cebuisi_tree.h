@@ -0,0 +1,85 @@
+/*
+ * Compact Elastic Binary Trees - exported functions on indirect case-insensitive strings
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct ceb_node *cebuisi_insert(struct ceb_node **root, struct ceb_node *node);
+struct ceb_node *cebuisi_first(struct ceb_node **root);
+struct ceb_node *cebuisi_last(struct ceb_node **root);
+struct ceb_node *cebuisi_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg);
+void cebuisi_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebuisi_iter_next(struct ceb_iter *iter);
+struct ceb_node *cebuisi_iter_prev(struct ceb_iter *iter);
+struct ceb_node *cebuisi_iter_seek(struct ceb_iter *iter, const void *key);
+struct ceb_node *cebuisi_walk_range(struct ceb_node **root, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebuisi_count_range(struct ceb_node **root, const void *lo, const void *hi);
+struct ceb_node *cebuisi_lookup(struct ceb_node **root, const void *key);
+struct ceb_node *cebuisi_lookup_le(struct ceb_node **root, const void *key);
+struct ceb_node *cebuisi_lookup_lt(struct ceb_node **root, const void *key);
+struct ceb_node *cebuisi_lookup_ge(struct ceb_node **root, const void *key);
+struct ceb_node *cebuisi_lookup_gt(struct ceb_node **root, const void *key);
+struct ceb_node *cebuisi_lookup_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuisi_lookup_le_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuisi_lookup_lt_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuisi_lookup_ge_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuisi_lookup_gt_len(struct ceb_node **root, const void *key, size_t len);
+struct ceb_node *cebuisi_next(struct ceb_node **root, struct ceb_node *node);
+struct ceb_node *cebuisi_prev(struct ceb_node **root, struct ceb_node *node);
+struct ceb_node *cebuisi_delete(struct ceb_node **root, struct ceb_node *node);
+struct ceb_node *cebuisi_pick(struct ceb_node **root, const void *key);
+size_t cebuisi_delete_range(struct ceb_node **root, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebuisi_walk_prefix(struct ceb_node **root, const void *prefix, ceb_walk_cb cb, void *arg);
+void cebuisi_default_dump(struct ceb_node **root, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct ceb_node *cebuisi_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
+struct ceb_node *cebuisi_ofs_first(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebuisi_ofs_last(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebuisi_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebuisi_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebuisi_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebuisi_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebuisi_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuisi_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebuisi_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi);
+struct ceb_node *cebuisi_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuisi_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuisi_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuisi_ofs_lookup_ge(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuisi_ofs_lookup_gt(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+struct ceb_node *cebuisi_ofs_lookup_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuisi_ofs_lookup_le_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuisi_ofs_lookup_lt_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuisi_ofs_lookup_ge_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuisi_ofs_lookup_gt_len(struct ceb_node **root, ptrdiff_t kofs, const void *key, size_t len);
+struct ceb_node *cebuisi_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
+struct ceb_node *cebuisi_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
+struct ceb_node *cebuisi_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
+struct ceb_node *cebuisi_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, const void *key);
+size_t cebuisi_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebuisi_ofs_walk_prefix(struct ceb_node **root, ptrdiff_t kofs, const void *prefix, ceb_walk_cb cb, void *arg);
+void cebuisi_ofs_default_dump(struct ceb_node **root, ptrdiff_t kofs, const char *label, const void *ctx);
@@ -47,27 +47,107 @@ CEB_FDECL3(struct ceb_node *, cebul, _insert, struct ceb_node **, root, ptrdiff_
 	unsigned long key = NODEK(node, kofs)->ul;
 
 	if (sizeof(long) <= 4)
-		return _cebu_insert(root, node, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_insert(root, node, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* return the first node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebul, _first, struct ceb_node **, root, ptrdiff_t, kofs)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_first(root, kofs, CEB_KT_U32);
+		return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32);
 	else
-		return _cebu_first(root, kofs, CEB_KT_U64);
+		return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64);
 }
 
 /* return the last node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebul, _last, struct ceb_node **, root, ptrdiff_t, kofs)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_last(root, kofs, CEB_KT_U32);
+		return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32);
 	else
-		return _cebu_last(root, kofs, CEB_KT_U64);
+		return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebul, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, 0, cb, arg);
+	else
+		return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebul, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebul, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_U32, 0, 0);
+	else
+		return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_U64, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebul, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_U32, 0, 1);
+	else
+		return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_U64, 0, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEB_FDECL3(struct ceb_node *, cebul, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_U32, key, 0, NULL);
+	else
+		return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_U64, 0, key, NULL);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEB_FDECL6(struct ceb_node *, cebul, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, lo, unsigned long, hi, ceb_walk_cb, cb, void *, arg)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, lo, 0, NULL, hi, 0, NULL, cb, arg);
+	else
+		return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ */
+CEB_FDECL4(size_t, cebul, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, lo, unsigned long, hi)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, lo, 0, NULL, hi, 0, NULL);
+	else
+		return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL);
 }
 
 /* look up the specified key, and returns either the node containing it, or
@@ -76,9 +156,9 @@ CEB_FDECL2(struct ceb_node *, cebul, _last, struct ceb_node **, root, ptrdiff_t,
 CEB_FDECL3(struct ceb_node *, cebul, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_lookup(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_lookup(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified key or the highest below it, and returns either the
@@ -87,9 +167,9 @@ CEB_FDECL3(struct ceb_node *, cebul, _lookup, struct ceb_node **, root, ptrdiff_
 CEB_FDECL3(struct ceb_node *, cebul, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_lookup_le(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_lookup_le(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up highest key below the specified one, and returns either the
@@ -98,9 +178,9 @@ CEB_FDECL3(struct ceb_node *, cebul, _lookup_le, struct ceb_node **, root, ptrdi
 CEB_FDECL3(struct ceb_node *, cebul, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_lookup_lt(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_lookup_lt(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified key or the smallest above it, and returns either the
@@ -109,9 +189,9 @@ CEB_FDECL3(struct ceb_node *, cebul, _lookup_lt, struct ceb_node **, root, ptrdi
 CEB_FDECL3(struct ceb_node *, cebul, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_lookup_ge(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_lookup_ge(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the smallest key above the specified one, and returns either the
@@ -120,9 +200,37 @@ CEB_FDECL3(struct ceb_node *, cebul, _lookup_ge, struct ceb_node **, root, ptrdi
 CEB_FDECL3(struct ceb_node *, cebul, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_lookup_gt(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* look up the specified key, and returns either the node containing it, or
+ * NULL if not found. The nodes immediately below and above the key are
+ * returned in <prev> and <next> respectively, or NULL if there is none. This
+ * is cheaper than a lookup_le() followed by a lookup_ge().
+ */
+CEB_FDECL5(struct ceb_node *, cebul, _lookup_bracket, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key, struct ceb_node **, prev, struct ceb_node **, next)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_lookup_bracket(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL, prev, next);
 	else
-		return _cebu_lookup_gt(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_lookup_bracket(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL, prev, next);
+}
+
+/* returns a randomly picked node using the random generator <rnd> called with
+ * <arg>, or NULL if the tree is empty. With <depth> at zero, nodes close to
+ * the root are more likely to be picked. Otherwise, all nodes not deeper than
+ * <depth> are picked with the same probability, which takes about
+ * 2^depth/nodes descents. A value slightly larger than log2 of the number of
+ * nodes is a good compromise.
+ */
+CEB_FDECL5(struct ceb_node *, cebul, _lookup_random, struct ceb_node **, root, ptrdiff_t, kofs, ceb_rnd_cb, rnd, void *, arg, unsigned int, depth)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_lookup_random(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, rnd, arg, depth);
+	else
+		return _cebu_lookup_random(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, rnd, arg, depth);
 }
 
 /* search for the next node after the specified one, and return it, or NULL if
@@ -135,9 +243,9 @@ CEB_FDECL3(struct ceb_node *, cebul, _next, struct ceb_node **, root, ptrdiff_t,
 	unsigned long key = NODEK(node, kofs)->ul;
 
 	if (sizeof(long) <= 4)
-		return _cebu_next(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_next(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* search for the prev node before the specified one, and return it, or NULL if
@@ -150,9 +258,9 @@ CEB_FDECL3(struct ceb_node *, cebul, _prev, struct ceb_node **, root, ptrdiff_t,
 	unsigned long key = NODEK(node, kofs)->ul;
 
 	if (sizeof(long) <= 4)
-		return _cebu_prev(root, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_prev(root, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified node with its key and deletes it if found, and in any
@@ -163,9 +271,9 @@ CEB_FDECL3(struct ceb_node *, cebul, _delete, struct ceb_node **, root, ptrdiff_
 	unsigned long key = NODEK(node, kofs)->ul;
 
 	if (sizeof(long) <= 4)
-		return _cebu_delete(root, node, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
 	else
-		return _cebu_delete(root, node, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
 }
 
 /* look up the specified key, and detaches it and returns it if found, or NULL
@@ -174,9 +282,48 @@ CEB_FDECL3(struct ceb_node *, cebul, _delete, struct ceb_node **, root, ptrdiff_
 CEB_FDECL3(struct ceb_node *, cebul, _pick, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
 {
 	if (sizeof(long) <= 4)
-		return _cebu_delete(root, NULL, kofs, CEB_KT_U32, key, 0, NULL);
+		return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL);
+	else
+		return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Each deleted node is passed to <free_cb> with <arg>
+ * once detached, unless <free_cb> is NULL. The nodes are not passed in any
+ * particular order.
+ */
+CEB_FDECL6(size_t, cebul, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, lo, unsigned long, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, lo, 0, NULL, hi, 0, NULL, free_cb, arg);
+	else
+		return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, lo, NULL, 0, hi, NULL, free_cb, arg);
+}
+
+/* look up the node whose key is the closest to the specified one by XOR
+ * distance, i.e. sharing the longest leading bits with it, and returns it, or
+ * NULL if the tree is empty. This only takes a single descent.
+ */
+CEB_FDECL3(struct ceb_node *, cebul, _lookup_xor_nearest, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_xor_nearest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL, NULL);
+	else
+		return _cebu_xor_nearest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL, NULL);
+}
+
+/* look up the node following <node> by XOR distance to the specified key,
+ * and returns it, or NULL if <node> was the farthest one. Starting from
+ * lookup_xor_nearest() and calling this one k-1 times returns the k nearest
+ * nodes in ascending distance order, at the cost of one descent each. <node>
+ * must be in the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebul, _lookup_xor_next, struct ceb_node **, root, ptrdiff_t, kofs, unsigned long, key, struct ceb_node *, node)
+{
+	if (sizeof(long) <= 4)
+		return _cebu_xor_nearest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U32, key, 0, NULL, node);
 	else
-		return _cebu_delete(root, NULL, kofs, CEB_KT_U64, 0, key, NULL);
+		return _cebu_xor_nearest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_U64, 0, key, NULL, node);
 }
 
 /* dumps a ceb_node tree using the default functions above. If a node matches
@@ -193,7 +340,7 @@ CEB_FDECL4(void, cebul, _default_dump, struct ceb_node **, root, ptrdiff_t, kofs
 	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
 	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
 
-	cebu_default_dump_tree(kofs, sizeof(long) <= 4 ? CEB_KT_U32 : CEB_KT_U64, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, sizeof(long) <= 4 ? CEB_KT_U32 : CEB_KT_U64, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
 
 	printf("}\n");
 }
@@ -30,28 +30,52 @@
 struct ceb_node *cebul_insert(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebul_first(struct ceb_node **root);
 struct ceb_node *cebul_last(struct ceb_node **root);
+struct ceb_node *cebul_walk(struct ceb_node **root, ceb_walk_cb cb, void *arg);
+void cebul_iter_init(struct ceb_iter *iter, struct ceb_node **root);
+struct ceb_node *cebul_iter_next(struct ceb_iter *iter);
+struct ceb_node *cebul_iter_prev(struct ceb_iter *iter);
+struct ceb_node *cebul_iter_seek(struct ceb_iter *iter, unsigned long key);
+struct ceb_node *cebul_walk_range(struct ceb_node **root, unsigned long lo, unsigned long hi, ceb_walk_cb cb, void *arg);
+size_t cebul_count_range(struct ceb_node **root, unsigned long lo, unsigned long hi);
 struct ceb_node *cebul_lookup(struct ceb_node **root, unsigned long key);
 struct ceb_node *cebul_lookup_le(struct ceb_node **root, unsigned long key);
 struct ceb_node *cebul_lookup_lt(struct ceb_node **root, unsigned long key);
 struct ceb_node *cebul_lookup_ge(struct ceb_node **root, unsigned long key);
 struct ceb_node *cebul_lookup_gt(struct ceb_node **root, unsigned long key);
+struct ceb_node *cebul_lookup_bracket(struct ceb_node **root, unsigned long key, struct ceb_node **prev, struct ceb_node **next);
+struct ceb_node *cebul_lookup_random(struct ceb_node **root, ceb_rnd_cb rnd, void *arg, unsigned int depth);
 struct ceb_node *cebul_next(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebul_prev(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebul_delete(struct ceb_node **root, struct ceb_node *node);
 struct ceb_node *cebul_pick(struct ceb_node **root, unsigned long key);
+size_t cebul_delete_range(struct ceb_node **root, unsigned long lo, unsigned long hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebul_lookup_xor_nearest(struct ceb_node **root, unsigned long key);
+struct ceb_node *cebul_lookup_xor_next(struct ceb_node **root, unsigned long key, struct ceb_node *node);
 void cebul_default_dump(struct ceb_node **ceb_root, const char *label, const void *ctx);
 
 /* version taking a key offset */
 struct ceb_node *cebul_ofs_insert(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebul_ofs_first(struct ceb_node **root, ptrdiff_t kofs);
 struct ceb_node *cebul_ofs_last(struct ceb_node **root, ptrdiff_t kofs);
+struct ceb_node *cebul_ofs_walk(struct ceb_node **root, ptrdiff_t kofs, ceb_walk_cb cb, void *arg);
+void cebul_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, struct ceb_node **root);
+struct ceb_node *cebul_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebul_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct ceb_node *cebul_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, unsigned long key);
+struct ceb_node *cebul_ofs_walk_range(struct ceb_node **root, ptrdiff_t kofs, unsigned long lo, unsigned long hi, ceb_walk_cb cb, void *arg);
+size_t cebul_ofs_count_range(struct ceb_node **root, ptrdiff_t kofs, unsigned long lo, unsigned long hi);
 struct ceb_node *cebul_ofs_lookup(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
 struct ceb_node *cebul_ofs_lookup_le(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
 struct ceb_node *cebul_ofs_lookup_lt(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
 struct ceb_node *cebul_ofs_lookup_ge(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
 struct ceb_node *cebul_ofs_lookup_gt(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
+struct ceb_node *cebul_ofs_lookup_bracket(struct ceb_node **root, ptrdiff_t kofs, unsigned long key, struct ceb_node **prev, struct ceb_node **next);
+struct ceb_node *cebul_ofs_lookup_random(struct ceb_node **root, ptrdiff_t kofs, ceb_rnd_cb rnd, void *arg, unsigned int depth);
 struct ceb_node *cebul_ofs_next(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebul_ofs_prev(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebul_ofs_delete(struct ceb_node **root, ptrdiff_t kofs, struct ceb_node *node);
 struct ceb_node *cebul_ofs_pick(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
+size_t cebul_ofs_delete_range(struct ceb_node **root, ptrdiff_t kofs, unsigned long lo, unsigned long hi, ceb_free_cb free_cb, void *arg);
+struct ceb_node *cebul_ofs_lookup_xor_nearest(struct ceb_node **root, ptrdiff_t kofs, unsigned long key);
+struct ceb_node *cebul_ofs_lookup_xor_next(struct ceb_node **root, ptrdiff_t kofs, unsigned long key, struct ceb_node *node);
 void cebul_ofs_default_dump(struct ceb_node **root, ptrdiff_t kofs, const char *label, const void *ctx);
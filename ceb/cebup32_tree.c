@@ -0,0 +1,173 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on u32 prefix keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebup32_*" and one with "cebup32_ofs_*" which takes a key  *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct ceb_node) in *
+ * the call to the underlying functions.                                     *
+\*****************************************************************************/
+
+/* Inserts node <node> into unique tree <tree> based on its 32-bit network
+ * immediately following the node, itself followed by its prefix length in
+ * bits on 32 bits, which must not be larger than 32. Bits of the network past
+ * this length are ignored. Returns the inserted node or the one that already
+ * contains the same prefix.
+ */
+CEB_FDECL3(struct ceb_node *, cebup32, _insert, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = _ceb_k64(CEB_KT_P32, NODEK(node, kofs));
+
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, key, NULL);
+}
+
+/* return the first node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebup32, _first, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32);
+}
+
+/* return the last node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebup32, _last, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebup32, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebup32, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebup32, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_P32, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebup32, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_P32, 0, 1);
+}
+
+/* look up the prefix made of the first <plen> bits of <net>, and returns either
+ * the node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebup32, _lookup_prefix, struct ceb_node **, root, ptrdiff_t, kofs, uint32_t, net, uint32_t, plen)
+{
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, _ceb_p32_enc(net, plen), NULL);
+}
+
+/* look up the longest prefix matching address <addr>, and returns either the
+ * node containing it, or NULL if none matches.
+ */
+CEB_FDECL3(struct ceb_node *, cebup32, _lookup_longest, struct ceb_node **, root, ptrdiff_t, kofs, uint32_t, addr)
+{
+	return _cebu_lookup_longest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, addr, 0, NULL);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. Prefixes are ordered by their bits, a prefix being placed after
+ * the longer ones it covers that continue with a zero, and before those that
+ * continue with a one.
+ */
+CEB_FDECL3(struct ceb_node *, cebup32, _next, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = _ceb_k64(CEB_KT_P32, NODEK(node, kofs));
+
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, key, NULL);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebup32, _prev, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = _ceb_k64(CEB_KT_P32, NODEK(node, kofs));
+
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, key, NULL);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node.
+ */
+CEB_FDECL3(struct ceb_node *, cebup32, _delete, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	uint64_t key = _ceb_k64(CEB_KT_P32, NODEK(node, kofs));
+
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, key, NULL);
+}
+
+/* look up the prefix made of the first <plen> bits of <net>, and detaches it
+ * and returns it if found, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebup32, _pick_prefix, struct ceb_node **, root, ptrdiff_t, kofs, uint32_t, net, uint32_t, plen)
+{
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_P32, 0, _ceb_p32_enc(net, plen), NULL);
+}
+
+/* dumps a ceb_node tree using the default functions above. If a node matches
+ * <ctx>, this one will be highlighted in red.
+ */
+CEB_FDECL4(void, cebup32, _default_dump, struct ceb_node **, root, ptrdiff_t, kofs, const char *, label, const void *, ctx)
+{
+	printf("\ndigraph cebup32_tree {\n"
+	       "  fontname=\"fixed\";\n"
+	       "  fontsize=8\n"
+	       "  label=\"%s\"\n"
+	       "", label);
+
+	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
+	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
+
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, CEB_KT_P32, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+
+	printf("}\n");
+}
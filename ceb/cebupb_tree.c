@@ -0,0 +1,161 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on prefix keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cebtree.h"
+#include "cebtree-prv.h"
+
+/*****************************************************************************\
+ * The declarations below always cause two functions to be declared, one     *
+ * starting with "cebupb_*" and one with "cebupb_ofs_*" which takes a key    *
+ * offset just after the root. The one without kofs just has this argument   *
+ * omitted from its declaration and replaced with sizeof(struct ceb_node) in *
+ * the call to the underlying functions.                                     *
+\*****************************************************************************/
+
+/* Inserts node <node> into unique tree <tree> based on its prefix whose length
+ * in bits is stored in a 32-bit word immediately following the node, just
+ * before the prefix itself. Bits past this length are ignored, so that two
+ * prefixes only differing there are equal. Returns the inserted node or the
+ * one that already contains the same prefix.
+ */
+CEB_FDECL3(struct ceb_node *, cebupb, _insert, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->pfx.data;
+	size_t plen = NODEK(node, kofs)->pfx.plen;
+
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, plen, key);
+}
+
+/* return the first node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebupb, _first, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB);
+}
+
+/* return the last node or NULL if not found. */
+CEB_FDECL2(struct ceb_node *, cebupb, _last, struct ceb_node **, root, ptrdiff_t, kofs)
+{
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebupb, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebupb, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebupb, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_PB, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebupb, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_PB, 0, 1);
+}
+
+/* look up the prefix made of the first <plen> bits of <key>, and returns either
+ * the node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebupb, _lookup_prefix, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, plen)
+{
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, plen, key);
+}
+
+/* look up the longest prefix matching the first <len> bits of <key>, and
+ * returns either the node containing it, or NULL if none matches. A prefix
+ * matches if it is not longer than <len> and all of its bits are equal to
+ * those of <key>.
+ */
+CEB_FDECL4(struct ceb_node *, cebupb, _lookup_longest, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_lookup_longest(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, len, key);
+}
+
+/* search for the next node after the specified one, and return it, or NULL if
+ * not found. Prefixes are ordered by their bits, a prefix being placed after
+ * the longer ones it covers that continue with a zero, and before those that
+ * continue with a one.
+ */
+CEB_FDECL3(struct ceb_node *, cebupb, _next, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->pfx.data;
+	size_t plen = NODEK(node, kofs)->pfx.plen;
+
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, plen, key);
+}
+
+/* search for the prev node before the specified one, and return it, or NULL if
+ * not found.
+ */
+CEB_FDECL3(struct ceb_node *, cebupb, _prev, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->pfx.data;
+	size_t plen = NODEK(node, kofs)->pfx.plen;
+
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, plen, key);
+}
+
+/* look up the specified node with its key and deletes it if found, and in any
+ * case, returns the node.
+ */
+CEB_FDECL3(struct ceb_node *, cebupb, _delete, struct ceb_node **, root, ptrdiff_t, kofs, struct ceb_node *, node)
+{
+	const void *key = NODEK(node, kofs)->pfx.data;
+	size_t plen = NODEK(node, kofs)->pfx.plen;
+
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, plen, key);
+}
+
+/* look up the prefix made of the first <plen> bits of <key>, and detaches it
+ * and returns it if found, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebupb, _pick_prefix, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, plen)
+{
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_PB, 0, plen, key);
+}
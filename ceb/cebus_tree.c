@@ -47,19 +47,81 @@ CEB_FDECL3(struct ceb_node *, cebus, _insert, struct ceb_node **, root, ptrdiff_
 {
 	const void *key = NODEK(node, kofs)->str;
 
-	return _cebu_insert(root, node, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_insert(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* return the first node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebus, _first, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_first(root, kofs, CEB_KT_ST);
+	return _cebu_first(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST);
 }
 
 /* return the last node or NULL if not found. */
 CEB_FDECL2(struct ceb_node *, cebus, _last, struct ceb_node **, root, ptrdiff_t, kofs)
 {
-	return _cebu_last(root, kofs, CEB_KT_ST);
+	return _cebu_last(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST);
+}
+
+/* calls <cb> with <arg> for each node in ascending order, visiting each
+ * of them once, and stops as soon as <cb> returns non-zero. Returns the node
+ * the walk stopped on, or NULL once all nodes were visited. <cb> must not
+ * modify the tree.
+ */
+CEB_FDECL4(struct ceb_node *, cebus, _walk, struct ceb_node **, root, ptrdiff_t, kofs, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, cb, arg);
+}
+
+/* binds iterator <iter> to the tree <root> and places it off the tree. */
+CEB_FDECL3(void, cebus, _iter_init, struct ceb_iter *, iter, ptrdiff_t, kofs, struct ceb_node **, root)
+{
+	_cebu_iter_init(iter, root, NULL);
+}
+
+/* moves iterator <iter> to the next node and returns it, or returns NULL and
+ * goes off the tree past the last one. From off the tree, it moves to the
+ * first node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebus, _iter_next, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_ST, 0, 0);
+}
+
+/* moves iterator <iter> to the previous node and returns it, or returns NULL
+ * and goes off the tree past the first one. From off the tree, it moves to
+ * the last node. NULL is also returned once the iterator is stale.
+ */
+CEB_FDECL2(struct ceb_node *, cebus, _iter_prev, struct ceb_iter *, iter, ptrdiff_t, kofs)
+{
+	return _cebu_iter_step(iter, kofs, CEB_AM_ABS, CEB_KT_ST, 0, 1);
+}
+
+/* moves iterator <iter> to the first node whose key is greater than or equal
+ * to the specified one and returns it, or returns NULL and goes off the tree
+ * if there is none.
+ */
+CEB_FDECL3(struct ceb_node *, cebus, _iter_seek, struct ceb_iter *, iter, ptrdiff_t, kofs, const void *, key)
+{
+	return _cebu_iter_seek(iter, kofs, CEB_AM_ABS, CEB_KT_ST, 0, 0, key);
+}
+
+/* calls <cb> with <arg> for each node whose key is between <lo> and <hi>
+ * inclusive, in ascending order, and stops as soon as <cb> returns
+ * non-zero. Returns the node the walk stopped on, or NULL once all nodes in
+ * the range were visited. The walk descends once towards <lo>, then visits
+ * the following nodes until the first one past <hi>. <cb> must not modify
+ * the tree.
+ */
+CEB_FDECL6(struct ceb_node *, cebus, _walk_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, lo, 0, 0, hi, cb, arg);
+}
+
+/* returns the number of nodes whose key is between <lo> and <hi> inclusive.
+ */
+CEB_FDECL4(size_t, cebus, _count_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi)
+{
+	return _cebu_count_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, lo, 0, 0, hi);
 }
 
 /* look up the specified key, and returns either the node containing it, or
@@ -67,7 +129,7 @@ CEB_FDECL2(struct ceb_node *, cebus, _last, struct ceb_node **, root, ptrdiff_t,
  */
 CEB_FDECL3(struct ceb_node *, cebus, _lookup, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* look up the specified key or the highest below it, and returns either the
@@ -75,7 +137,7 @@ CEB_FDECL3(struct ceb_node *, cebus, _lookup, struct ceb_node **, root, ptrdiff_
  */
 CEB_FDECL3(struct ceb_node *, cebus, _lookup_le, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_le(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* look up highest key below the specified one, and returns either the
@@ -83,7 +145,7 @@ CEB_FDECL3(struct ceb_node *, cebus, _lookup_le, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebus, _lookup_lt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_lt(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* look up the specified key or the smallest above it, and returns either the
@@ -91,7 +153,7 @@ CEB_FDECL3(struct ceb_node *, cebus, _lookup_lt, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebus, _lookup_ge, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_ge(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* look up the smallest key above the specified one, and returns either the
@@ -99,7 +161,71 @@ CEB_FDECL3(struct ceb_node *, cebus, _lookup_ge, struct ceb_node **, root, ptrdi
  */
 CEB_FDECL3(struct ceb_node *, cebus, _lookup_gt, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_lookup_gt(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
+}
+
+/* look up the specified key, and returns either the node containing it, or
+ * NULL if not found. The nodes immediately below and above the key are
+ * returned in <prev> and <next> respectively, or NULL if there is none. This
+ * is cheaper than a lookup_le() followed by a lookup_ge().
+ */
+CEB_FDECL5(struct ceb_node *, cebus, _lookup_bracket, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, struct ceb_node **, prev, struct ceb_node **, next)
+{
+	return _cebu_lookup_bracket(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key, prev, next);
+}
+
+/* returns a randomly picked node using the random generator <rnd> called with
+ * <arg>, or NULL if the tree is empty. With <depth> at zero, nodes close to
+ * the root are more likely to be picked. Otherwise, all nodes not deeper than
+ * <depth> are picked with the same probability, which takes about
+ * 2^depth/nodes descents. A value slightly larger than log2 of the number of
+ * nodes is a good compromise.
+ */
+CEB_FDECL5(struct ceb_node *, cebus, _lookup_random, struct ceb_node **, root, ptrdiff_t, kofs, ceb_rnd_cb, rnd, void *, arg, unsigned int, depth)
+{
+	return _cebu_lookup_random(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, rnd, arg, depth);
+}
+
+/* look up the specified key <key> made of <len> bytes which do not need to be
+ * NUL-terminated, and returns either the node containing it, or NULL if not
+ * found. The key ends at its first zero byte or after <len> bytes, so that it
+ * may directly designate a part of a larger buffer.
+ */
+CEB_FDECL4(struct ceb_node *, cebus, _lookup_len, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_lookup(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, (uint64_t)len + 1, key);
+}
+
+/* look up the specified key <key> of <len> bytes or the highest below it, and
+ * returns either the node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebus, _lookup_le_len, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_lookup_le(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, (uint64_t)len + 1, key);
+}
+
+/* look up highest key below the specified key <key> of <len> bytes, and
+ * returns either the node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebus, _lookup_lt_len, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_lookup_lt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, (uint64_t)len + 1, key);
+}
+
+/* look up the specified key <key> of <len> bytes or the smallest above it, and
+ * returns either the node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebus, _lookup_ge_len, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_lookup_ge(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, (uint64_t)len + 1, key);
+}
+
+/* look up the smallest key above the specified key <key> of <len> bytes, and
+ * returns either the node containing it, or NULL if not found.
+ */
+CEB_FDECL4(struct ceb_node *, cebus, _lookup_gt_len, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key, size_t, len)
+{
+	return _cebu_lookup_gt(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, (uint64_t)len + 1, key);
 }
 
 /* search for the next node after the specified one, and return it, or NULL if
@@ -111,7 +237,7 @@ CEB_FDECL3(struct ceb_node *, cebus, _next, struct ceb_node **, root, ptrdiff_t,
 {
 	const void *key = NODEK(node, kofs)->str;
 
-	return _cebu_next(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_next(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* search for the prev node before the specified one, and return it, or NULL if
@@ -123,7 +249,7 @@ CEB_FDECL3(struct ceb_node *, cebus, _prev, struct ceb_node **, root, ptrdiff_t,
 {
 	const void *key = NODEK(node, kofs)->str;
 
-	return _cebu_prev(root, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_prev(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* look up the specified node with its key and deletes it if found, and in any
@@ -133,7 +259,7 @@ CEB_FDECL3(struct ceb_node *, cebus, _delete, struct ceb_node **, root, ptrdiff_
 {
 	const void *key = NODEK(node, kofs)->str;
 
-	return _cebu_delete(root, node, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_delete(root, node, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
 }
 
 /* look up the specified key, and detaches it and returns it if found, or NULL
@@ -141,7 +267,27 @@ CEB_FDECL3(struct ceb_node *, cebus, _delete, struct ceb_node **, root, ptrdiff_
  */
 CEB_FDECL3(struct ceb_node *, cebus, _pick, struct ceb_node **, root, ptrdiff_t, kofs, const void *, key)
 {
-	return _cebu_delete(root, NULL, kofs, CEB_KT_ST, 0, 0, key);
+	return _cebu_delete(root, NULL, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, key);
+}
+
+/* deletes all nodes whose key is between <lo> and <hi> inclusive, and
+ * returns their number. Each deleted node is passed to <free_cb> with <arg>
+ * once detached, unless <free_cb> is NULL. The nodes are not passed in any
+ * particular order.
+ */
+CEB_FDECL6(size_t, cebus, _delete_range, struct ceb_node **, root, ptrdiff_t, kofs, const void *, lo, const void *, hi, ceb_free_cb, free_cb, void *, arg)
+{
+	return _cebu_delete_range(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, 0, 0, lo, 0, 0, hi, free_cb, arg);
+}
+
+/* calls <cb> with <arg> for each node whose key starts with <prefix>, in
+ * ascending order, until <cb> returns non-zero. The walk only covers the
+ * subtree holding these keys, which is looked up once. Returns the node the
+ * walk stopped on, or NULL if all matching nodes were visited.
+ */
+CEB_FDECL5(struct ceb_node *, cebus, _walk_prefix, struct ceb_node **, root, ptrdiff_t, kofs, const void *, prefix, ceb_walk_cb, cb, void *, arg)
+{
+	return _cebu_walk_prefix(root, kofs, CEB_AM_ABS, NULL, CEB_KT_ST, prefix, cb, arg);
 }
 
 /* dumps a ceb_node tree using the default functions above. If a node matches
@@ -158,7 +304,7 @@ CEB_FDECL4(void, cebus, _default_dump, struct ceb_node **, root, ptrdiff_t, kofs
 	printf("  node [fontname=\"fixed\" fontsize=8 shape=\"box\" style=\"filled\" color=\"black\" fillcolor=\"white\"];\n"
 	       "  edge [fontname=\"fixed\" fontsize=8 style=\"solid\" color=\"magenta\" dir=\"forward\"];\n");
 
-	cebu_default_dump_tree(kofs, CEB_KT_ST, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
+	cebu_default_dump_tree(kofs, CEB_AM_ABS, NULL, CEB_KT_ST, root, 0, NULL, 0, ctx, NULL, NULL, NULL);
 
 	printf("}\n");
 }
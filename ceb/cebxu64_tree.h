@@ -0,0 +1,74 @@
+/*
+ * Compact Elastic Binary Trees - exported functions for operations on u64 keys
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+#include <inttypes.h>
+
+/* simpler version */
+struct cebx_node *cebxu64_insert(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_first(uint32_t *root, const void *base);
+struct cebx_node *cebxu64_last(uint32_t *root, const void *base);
+struct cebx_node *cebxu64_walk(uint32_t *root, const void *base, ceb_walk_cb cb, void *arg);
+void cebxu64_iter_init(struct ceb_iter *iter, uint32_t *root, const void *base);
+struct cebx_node *cebxu64_iter_next(struct ceb_iter *iter);
+struct cebx_node *cebxu64_iter_prev(struct ceb_iter *iter);
+struct cebx_node *cebxu64_iter_seek(struct ceb_iter *iter, uint64_t key);
+struct cebx_node *cebxu64_walk_range(uint32_t *root, const void *base, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebxu64_count_range(uint32_t *root, const void *base, uint64_t lo, uint64_t hi);
+struct cebx_node *cebxu64_lookup(uint32_t *root, const void *base, uint64_t key);
+struct cebx_node *cebxu64_lookup_le(uint32_t *root, const void *base, uint64_t key);
+struct cebx_node *cebxu64_lookup_lt(uint32_t *root, const void *base, uint64_t key);
+struct cebx_node *cebxu64_lookup_ge(uint32_t *root, const void *base, uint64_t key);
+struct cebx_node *cebxu64_lookup_gt(uint32_t *root, const void *base, uint64_t key);
+struct cebx_node *cebxu64_next(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_prev(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_delete(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_pick(uint32_t *root, const void *base, uint64_t key);
+size_t cebxu64_delete_range(uint32_t *root, const void *base, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+void cebxu64_default_dump(uint32_t *ceb_root, const void *base, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebx_node *cebxu64_ofs_insert(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_ofs_first(uint32_t *root, ptrdiff_t kofs, const void *base);
+struct cebx_node *cebxu64_ofs_last(uint32_t *root, ptrdiff_t kofs, const void *base);
+struct cebx_node *cebxu64_ofs_walk(uint32_t *root, ptrdiff_t kofs, const void *base, ceb_walk_cb cb, void *arg);
+void cebxu64_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, uint32_t *root, const void *base);
+struct cebx_node *cebxu64_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebx_node *cebxu64_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebx_node *cebxu64_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, uint64_t key);
+struct cebx_node *cebxu64_ofs_walk_range(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t lo, uint64_t hi, ceb_walk_cb cb, void *arg);
+size_t cebxu64_ofs_count_range(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t lo, uint64_t hi);
+struct cebx_node *cebxu64_ofs_lookup(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t key);
+struct cebx_node *cebxu64_ofs_lookup_le(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t key);
+struct cebx_node *cebxu64_ofs_lookup_lt(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t key);
+struct cebx_node *cebxu64_ofs_lookup_ge(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t key);
+struct cebx_node *cebxu64_ofs_lookup_gt(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t key);
+struct cebx_node *cebxu64_ofs_next(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_ofs_prev(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_ofs_delete(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxu64_ofs_pick(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t key);
+size_t cebxu64_ofs_delete_range(uint32_t *root, ptrdiff_t kofs, const void *base, uint64_t lo, uint64_t hi, ceb_free_cb free_cb, void *arg);
+void cebxu64_ofs_default_dump(uint32_t *root, ptrdiff_t kofs, const void *base, const char *label, const void *ctx);
@@ -0,0 +1,72 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on indirect blocks
+ * using the index addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct cebx_node *cebxuib_insert(uint32_t *root, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_first(uint32_t *root, const void *base);
+struct cebx_node *cebxuib_last(uint32_t *root, const void *base);
+struct cebx_node *cebxuib_walk(uint32_t *root, const void *base, ceb_walk_cb cb, void *arg, size_t len);
+void cebxuib_iter_init(struct ceb_iter *iter, uint32_t *root, const void *base);
+struct cebx_node *cebxuib_iter_next(struct ceb_iter *iter, size_t len);
+struct cebx_node *cebxuib_iter_prev(struct ceb_iter *iter, size_t len);
+struct cebx_node *cebxuib_iter_seek(struct ceb_iter *iter, const void *key, size_t len);
+struct cebx_node *cebxuib_walk_range(uint32_t *root, const void *base, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebxuib_count_range(uint32_t *root, const void *base, const void *lo, const void *hi, size_t len);
+struct cebx_node *cebxuib_lookup(uint32_t *root, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_lookup_le(uint32_t *root, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_lookup_lt(uint32_t *root, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_lookup_ge(uint32_t *root, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_lookup_gt(uint32_t *root, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_next(uint32_t *root, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_prev(uint32_t *root, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_delete(uint32_t *root, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_pick(uint32_t *root, const void *base, const void *key, size_t len);
+size_t cebxuib_delete_range(uint32_t *root, const void *base, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
+
+/* version taking a key offset */
+struct cebx_node *cebxuib_ofs_insert(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_ofs_first(uint32_t *root, ptrdiff_t kofs, const void *base);
+struct cebx_node *cebxuib_ofs_last(uint32_t *root, ptrdiff_t kofs, const void *base);
+struct cebx_node *cebxuib_ofs_walk(uint32_t *root, ptrdiff_t kofs, const void *base, ceb_walk_cb cb, void *arg, size_t len);
+void cebxuib_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, uint32_t *root, const void *base);
+struct cebx_node *cebxuib_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct cebx_node *cebxuib_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs, size_t len);
+struct cebx_node *cebxuib_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key, size_t len);
+struct cebx_node *cebxuib_ofs_walk_range(uint32_t *root, ptrdiff_t kofs, const void *base, const void *lo, const void *hi, ceb_walk_cb cb, void *arg, size_t len);
+size_t cebxuib_ofs_count_range(uint32_t *root, ptrdiff_t kofs, const void *base, const void *lo, const void *hi, size_t len);
+struct cebx_node *cebxuib_ofs_lookup(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_ofs_lookup_le(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_ofs_lookup_lt(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_ofs_lookup_ge(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_ofs_lookup_gt(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key, size_t len);
+struct cebx_node *cebxuib_ofs_next(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_ofs_prev(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_ofs_delete(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node, size_t len);
+struct cebx_node *cebxuib_ofs_pick(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key, size_t len);
+size_t cebxuib_ofs_delete_range(uint32_t *root, ptrdiff_t kofs, const void *base, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg, size_t len);
@@ -0,0 +1,74 @@
+/*
+ * Compact Elastic Binary Trees - exported functions operating on indirect strings
+ * using the index addressing model
+ *
+ * Copyright (C) 2014-2024 Willy Tarreau - w@1wt.eu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cebtree.h"
+
+/* simpler version */
+struct cebx_node *cebxuis_insert(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_first(uint32_t *root, const void *base);
+struct cebx_node *cebxuis_last(uint32_t *root, const void *base);
+struct cebx_node *cebxuis_walk(uint32_t *root, const void *base, ceb_walk_cb cb, void *arg);
+void cebxuis_iter_init(struct ceb_iter *iter, uint32_t *root, const void *base);
+struct cebx_node *cebxuis_iter_next(struct ceb_iter *iter);
+struct cebx_node *cebxuis_iter_prev(struct ceb_iter *iter);
+struct cebx_node *cebxuis_iter_seek(struct ceb_iter *iter, const void *key);
+struct cebx_node *cebxuis_walk_range(uint32_t *root, const void *base, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebxuis_count_range(uint32_t *root, const void *base, const void *lo, const void *hi);
+struct cebx_node *cebxuis_lookup(uint32_t *root, const void *base, const void *key);
+struct cebx_node *cebxuis_lookup_le(uint32_t *root, const void *base, const void *key);
+struct cebx_node *cebxuis_lookup_lt(uint32_t *root, const void *base, const void *key);
+struct cebx_node *cebxuis_lookup_ge(uint32_t *root, const void *base, const void *key);
+struct cebx_node *cebxuis_lookup_gt(uint32_t *root, const void *base, const void *key);
+struct cebx_node *cebxuis_next(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_prev(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_delete(uint32_t *root, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_pick(uint32_t *root, const void *base, const void *key);
+size_t cebxuis_delete_range(uint32_t *root, const void *base, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+void cebxuis_default_dump(uint32_t *root, const void *base, const char *label, const void *ctx);
+
+/* version taking a key offset */
+struct cebx_node *cebxuis_ofs_insert(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_ofs_first(uint32_t *root, ptrdiff_t kofs, const void *base);
+struct cebx_node *cebxuis_ofs_last(uint32_t *root, ptrdiff_t kofs, const void *base);
+struct cebx_node *cebxuis_ofs_walk(uint32_t *root, ptrdiff_t kofs, const void *base, ceb_walk_cb cb, void *arg);
+void cebxuis_ofs_iter_init(struct ceb_iter *iter, ptrdiff_t kofs, uint32_t *root, const void *base);
+struct cebx_node *cebxuis_ofs_iter_next(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebx_node *cebxuis_ofs_iter_prev(struct ceb_iter *iter, ptrdiff_t kofs);
+struct cebx_node *cebxuis_ofs_iter_seek(struct ceb_iter *iter, ptrdiff_t kofs, const void *key);
+struct cebx_node *cebxuis_ofs_walk_range(uint32_t *root, ptrdiff_t kofs, const void *base, const void *lo, const void *hi, ceb_walk_cb cb, void *arg);
+size_t cebxuis_ofs_count_range(uint32_t *root, ptrdiff_t kofs, const void *base, const void *lo, const void *hi);
+struct cebx_node *cebxuis_ofs_lookup(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key);
+struct cebx_node *cebxuis_ofs_lookup_le(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key);
+struct cebx_node *cebxuis_ofs_lookup_lt(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key);
+struct cebx_node *cebxuis_ofs_lookup_ge(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key);
+struct cebx_node *cebxuis_ofs_lookup_gt(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key);
+struct cebx_node *cebxuis_ofs_next(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_ofs_prev(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_ofs_delete(uint32_t *root, ptrdiff_t kofs, const void *base, struct cebx_node *node);
+struct cebx_node *cebxuis_ofs_pick(uint32_t *root, ptrdiff_t kofs, const void *base, const void *key);
+size_t cebxuis_ofs_delete_range(uint32_t *root, ptrdiff_t kofs, const void *base, const void *lo, const void *hi, ceb_free_cb free_cb, void *arg);
+void cebxuis_ofs_default_dump(uint32_t *root, ptrdiff_t kofs, const void *base, const char *label, const void *ctx);
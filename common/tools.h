@@ -259,6 +259,185 @@ static forceinline size_t string_equal_bits(const unsigned char *a,
 	return (beg << 3) - flsnz(c);
 }
 
+/* Compare blocks <a> of <alen> bytes and <b> of <blen> bytes, from bit <ignore>.
+ * Blocks are seen as a sequence of 9-bit symbols, each byte being preceded by
+ * a one and the block being terminated by a zero, so that a block is always
+ * lower than the blocks it is a prefix of. Return the number of equal bits in
+ * this representation, assuming that the first <ignore> ones are already
+ * identical. The caller is responsible for not passing an <ignore> value
+ * larger than 9 times the shortest length. Equal blocks are reported as a
+ * negative number of bits, which indicates the end was reached.
+ */
+static forceinline size_t vblock_equal_bits(const unsigned char *a, size_t alen,
+					    const unsigned char *b, size_t blen,
+					    size_t ignore)
+{
+	size_t len = (alen < blen) ? alen : blen;
+	size_t beg;
+	unsigned char c;
+
+	for (beg = ignore / 9; beg < len; beg++) {
+		c = a[beg] ^ b[beg];
+		if (c) {
+			/* the byte's bits follow its leading one */
+			return beg * 9 + 9 - flsnz(c);
+		}
+	}
+
+	if (alen == blen)
+		return (size_t)-1;
+
+	/* the shortest one ends here */
+	return len * 9;
+}
+
+/* Compare blocks <a> of <alen> bytes and <b> of <blen> bytes in the same
+ * representation as vblock_equal_bits() above, with the same <ignore> hint.
+ * Returns <0, 0 or >0 if <a> is respectively lower than, equal to, or greater
+ * than <b>, i.e. the lexicographic order where a shorter block comes first.
+ */
+static forceinline int vblock_cmp(const unsigned char *a, size_t alen,
+				  const unsigned char *b, size_t blen,
+				  size_t ignore)
+{
+	size_t pos = vblock_equal_bits(a, alen, b, blen, ignore);
+
+	if (pos == (size_t)-1)
+		return 0;
+
+	if (pos % 9 == 0) /* one of them ends there */
+		return (pos / 9 < alen) ? 1 : -1;
+
+	return (a[pos / 9] > b[pos / 9]) ? 1 : -1;
+}
+
+/* returns the lower case version of ASCII character <c>, other characters
+ * being left untouched. Note that this is not locale-dependent.
+ */
+static forceinline unsigned char ascii_tolower(unsigned char c)
+{
+	return ((unsigned char)(c - 'A') < 26) ? c | 0x20 : c;
+}
+
+/* Same as string_equal_bits() above except that ASCII letters are compared
+ * after being turned to lower case, so that the number of equal bits is the
+ * one between the lower case versions of the two strings.
+ */
+static forceinline size_t string_equal_bits_ci(const unsigned char *a,
+					       const unsigned char *b,
+					       size_t ignore)
+{
+	unsigned char c, d;
+	size_t beg;
+
+	beg = ignore >> 3;
+
+	while (1) {
+		c = ascii_tolower(a[beg]);
+		d = ascii_tolower(b[beg]);
+		beg++;
+
+		c ^= d;
+		if (c)
+			break;
+		if (!d)
+			return (size_t)-1;
+	}
+	return (beg << 3) - flsnz(c);
+}
+
+/* Compares strings <a> and <b> after turning their ASCII letters to lower
+ * case, and returns <0, 0 or >0 like strcmp(). Contrary to strcasecmp(), the
+ * result never depends on the locale, and matches string_equal_bits_ci().
+ */
+static forceinline int string_cmp_ci(const unsigned char *a, const unsigned char *b)
+{
+	unsigned char c, d;
+
+	while (1) {
+		c = ascii_tolower(*a++);
+		d = ascii_tolower(*b++);
+		if (c != d || !c)
+			return c - d;
+	}
+}
+
+/* Same as string_equal_bits() above except that <a> is a slice of <alen>
+ * bytes which is not necessarily NUL-terminated. It is considered as ending
+ * with a zero either at its first zero byte or after its last byte. The
+ * caller must not pass an <ignore> value larger than <alen> bytes.
+ */
+static forceinline size_t slice_equal_bits(const unsigned char *a, size_t alen,
+					   const unsigned char *b,
+					   size_t ignore)
+{
+	unsigned char c, d;
+	size_t beg;
+
+	beg = ignore >> 3;
+
+	while (1) {
+		c = (beg < alen) ? a[beg] : 0;
+		d = b[beg];
+		beg++;
+
+		c ^= d;
+		if (c)
+			break;
+		if (!d)
+			return (size_t)-1;
+	}
+	return (beg << 3) - flsnz(c);
+}
+
+/* Same as slice_equal_bits() above, ignoring the case of ASCII letters like
+ * string_equal_bits_ci() does.
+ */
+static forceinline size_t slice_equal_bits_ci(const unsigned char *a, size_t alen,
+					      const unsigned char *b,
+					      size_t ignore)
+{
+	unsigned char c, d;
+	size_t beg;
+
+	beg = ignore >> 3;
+
+	while (1) {
+		c = ascii_tolower((beg < alen) ? a[beg] : 0);
+		d = ascii_tolower(b[beg]);
+		beg++;
+
+		c ^= d;
+		if (c)
+			break;
+		if (!d)
+			return (size_t)-1;
+	}
+	return (beg << 3) - flsnz(c);
+}
+
+/* Compares slice <a> of <alen> bytes, ending like in slice_equal_bits(), with
+ * string <b>, and returns <0, 0 or >0 like strcmp(). The case of ASCII letters
+ * is ignored when <ci> is non-zero.
+ */
+static forceinline int slice_cmp(const unsigned char *a, size_t alen,
+				 const unsigned char *b, int ci)
+{
+	unsigned char c, d;
+	size_t ofs;
+
+	for (ofs = 0; ; ofs++) {
+		c = (ofs < alen) ? a[ofs] : 0;
+		d = b[ofs];
+		if (ci) {
+			c = ascii_tolower(c);
+			d = ascii_tolower(d);
+		}
+		if (c != d || !c)
+			return c - d;
+	}
+}
+
 static forceinline int cmp_bits(const unsigned char *a, const unsigned char *b, unsigned int pos)
 {
 	unsigned int ofs;
@@ -282,4 +461,92 @@ static forceinline int get_bit(const unsigned char *a, unsigned int pos)
 	return (a[ofs] >> pos) & 1;
 }
 
+/* Prefixes are blocks of which only the first <len> bits are significant. In
+ * order to tell a prefix from its extensions, a prefix is seen as its <len>
+ * first bits followed by a one and only zeroes past it. The functions below
+ * work on this representation, which orders prefixes by their bits, a prefix
+ * sorting after the longer ones it covers that continue with a zero, and
+ * before those that continue with a one.
+ */
+
+/* returns the bit at position <pos> of prefix <a> of <alen> bits */
+static forceinline int prefix_get_bit(const unsigned char *a, size_t alen, size_t pos)
+{
+	if (pos < alen)
+		return get_bit(a, pos);
+	return pos == alen;
+}
+
+/* Compare prefixes <a> of <alen> bits and <b> of <blen> bits, and return the
+ * number of equal bits between them, or a negative number if they are equal.
+ */
+static forceinline size_t prefix_equal_bits(const unsigned char *a, size_t alen,
+					    const unsigned char *b, size_t blen)
+{
+	const unsigned char *t;
+	size_t len = (alen < blen) ? alen : blen;
+	size_t pos;
+
+	pos = equal_bits(a, b, 0, len);
+	if (pos < len)
+		return pos;
+
+	if (alen == blen)
+		return (size_t)-1;
+
+	if (alen > blen) {
+		t = a; a = b; b = t;
+		pos = alen; alen = blen; blen = pos;
+	}
+
+	/* <a> is a prefix of <b>: they're equal at <alen> only if <b> has a
+	 * one there, then they differ at the next one of <b>, at worst at its
+	 * own trailing one.
+	 */
+	if (!get_bit(b, alen))
+		return alen;
+
+	for (pos = alen + 1; pos < blen; pos++) {
+		if (!(pos & 7) && pos + 8 <= blen && !b[pos >> 3]) {
+			pos += 7;
+			continue;
+		}
+		if (get_bit(b, pos))
+			return pos;
+	}
+	return blen;
+}
+
+/* Compare prefixes <a> of <alen> bits and <b> of <blen> bits, and returns <0,
+ * 0 or >0 if <a> is respectively lower than, equal to or greater than <b>.
+ */
+static forceinline int prefix_cmp(const unsigned char *a, size_t alen,
+				  const unsigned char *b, size_t blen)
+{
+	size_t pos = prefix_equal_bits(a, alen, b, blen);
+
+	if (pos == (size_t)-1)
+		return 0;
+	return prefix_get_bit(a, alen, pos) - prefix_get_bit(b, blen, pos);
+}
+
+/* Returns the position of the last one strictly before bit <pos> in prefix
+ * <a> of <alen> bits, or -1 if there is none.
+ */
+static forceinline long prefix_last_one(const unsigned char *a, size_t alen, size_t pos)
+{
+	if (pos > alen)
+		return alen;
+
+	while (pos--) {
+		if ((pos & 7) == 7 && !a[pos >> 3]) {
+			pos -= 7;
+			continue;
+		}
+		if (get_bit(a, pos))
+			return pos;
+	}
+	return -1;
+}
+
 #endif /* _EBTREE_TOOLS_H */
@@ -0,0 +1,118 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu64_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+struct key {
+	struct ceb_node node;
+	uint64_t key;
+};
+
+#define RND32SEED 2463534242U
+static uint32_t rnd32seed = RND32SEED;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+static uint64_t rnd64()
+{
+	return ((uint64_t)rnd32() << 32) + rnd32();
+}
+
+/* Range lookups benchmark: random keys are inserted, then random keys which
+ * are mostly absent are looked up using the method passed in argument, which
+ * involves finding a neighbour for all of them but "eq". The "next" and "prev"
+ * methods look up a neighbour of the node found by "ge".
+ */
+int main(int argc, char **argv)
+{
+	int entries, lookups, loops, found, i;
+	struct ceb_node *prev, *ret, *old;
+	struct key *key;
+	uint64_t mask;
+	const char *meth;
+
+	if (argc < 4) {
+		printf("Usage: %s entries lookups loops [eq|le|lt|ge|gt|next|prev] [mask]\n", argv[0]);
+		exit(1);
+	}
+
+	entries = atoi(argv[1]);
+	lookups = atoi(argv[2]);
+	loops   = atoi(argv[3]);
+	meth    = argc > 4 ? argv[4] : "ge";
+	mask    = argc > 5 ? strtoull(argv[5], NULL, 0) : ~0ULL;
+	found   = 0;
+
+	key = calloc(1, sizeof(*key));
+
+	for (i = 0; i < entries; i++) {
+		key->key = rnd64() & mask;
+	try_again:
+		prev = cebu64_insert(&ceb_root, &key->node);
+		if (prev != &key->node) {
+			ret = cebu64_delete(&ceb_root, prev);
+			if (ret != prev) {
+				/* was not properly removed either: THIS IS A BUG! */
+				fprintf(stderr, "failed to remove %p (returned %p)\n", prev, ret);
+				abort();
+			}
+			free(container_of(ret, struct key, node));
+			goto try_again;
+		}
+		/* key was inserted, we need a new one */
+		key = calloc(1, sizeof(*key));
+	}
+
+	printf("Now looking up\n");
+
+	while (loops-- > 0) {
+		rnd32seed = RND32SEED;
+		found = 0;
+		for (i = 0; i < lookups; i++) {
+			uint64_t v = rnd64() & mask;
+
+			switch (*meth) {
+			case 'e':
+				old = cebu64_lookup(&ceb_root, v);
+				break;
+			case 'l':
+				old = (meth[1] == 't') ? cebu64_lookup_lt(&ceb_root, v) : cebu64_lookup_le(&ceb_root, v);
+				break;
+			case 'g':
+				old = (meth[1] == 't') ? cebu64_lookup_gt(&ceb_root, v) : cebu64_lookup_ge(&ceb_root, v);
+				break;
+			case 'n':
+				old = cebu64_lookup_ge(&ceb_root, v);
+				old = old ? cebu64_next(&ceb_root, old) : NULL;
+				break;
+			case 'p':
+				old = cebu64_lookup_ge(&ceb_root, v);
+				old = old ? cebu64_prev(&ceb_root, old) : NULL;
+				break;
+			default:
+				printf("Unknown method '%s'\n", meth);
+				exit(1);
+			}
+			if (old)
+				found++;
+		}
+	}
+
+	printf("found=%d\n", found);
+	return 0;
+}
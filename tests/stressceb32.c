@@ -0,0 +1,272 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ceb32_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+struct key {
+	struct ceb_node node;
+	uint32_t key;
+};
+
+/* all allocated keys, in the tree or not */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* state of a walk: the nodes expected in order and the current position */
+struct walk_ctx {
+	struct ceb_node **exp;
+	int pos;
+};
+
+/* walk callback verifying that nodes are visited in the same order as with
+ * first/next, including duplicates. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (ctx->exp[ctx->pos] != node) {
+		printf("walk mismatch at %d\n", ctx->pos);
+		abort();
+	}
+	ctx->pos++;
+	return 0;
+}
+
+/* range deletion callback: the node must have been marked as deleted. It's
+ * removed from the keys and released.
+ */
+static void free_cb(struct ceb_node *node, void *arg)
+{
+	int idx;
+
+	if (node->b[0]) {
+		printf("range deletion passed node %p still marked in the tree\n", node);
+		abort();
+	}
+
+	for (idx = 0; idx < nb_keys && &keys[idx]->node != node; idx++)
+		;
+	if (idx == nb_keys) {
+		printf("range deletion passed unknown node %p\n", node);
+		abort();
+	}
+	free(keys[idx]);
+	keys[idx] = keys[--nb_keys];
+}
+
+/* walks the whole tree forwards and backwards and verifies that keys are
+ * properly ordered, that duplicates appear in the same order in both
+ * directions and with a walk, and that exactly <nodes> nodes are present.
+ * A range walk is also performed between two random keys within <mask>.
+ * Aborts on error.
+ */
+static void check_tree(int nodes, uint32_t mask)
+{
+	struct ceb_node *node, *prev;
+	struct ceb_node **fwd;
+	struct walk_ctx ctx;
+	uint32_t lo, hi;
+	int n = 0;
+	int i, j;
+
+	fwd = calloc(nodes + 1, sizeof(*fwd));
+	prev = NULL;
+	for (node = ceb32_first(&ceb_root); node; node = ceb32_next(&ceb_root, node)) {
+		if (n == nodes) {
+			printf("more than %d nodes in the tree\n", nodes);
+			abort();
+		}
+		if (prev && container_of(prev, struct key, node)->key > container_of(node, struct key, node)->key) {
+			printf("key %u after %u\n", container_of(node, struct key, node)->key, container_of(prev, struct key, node)->key);
+			abort();
+		}
+		if (prev && container_of(prev, struct key, node)->key != container_of(node, struct key, node)->key &&
+		    ceb32_lookup(&ceb_root, container_of(node, struct key, node)->key) != node) {
+			printf("lookup(%u) doesn't return the first duplicate\n", container_of(node, struct key, node)->key);
+			abort();
+		}
+		fwd[n++] = prev = node;
+	}
+
+	if (n != nodes) {
+		printf("found %d nodes instead of %d\n", n, nodes);
+		abort();
+	}
+
+	ctx.exp = fwd;
+	ctx.pos = 0;
+	if (ceb32_walk(&ceb_root, walk_cb, &ctx) || ctx.pos != nodes) {
+		printf("walk visited %d nodes instead of %d\n", ctx.pos, nodes);
+		abort();
+	}
+
+	/* range walk between two random keys, which must visit the same nodes
+	 * as the full walk once past those below <lo>.
+	 */
+	lo = rnd32() & mask;
+	hi = rnd32() & mask;
+	for (i = 0; i < nodes && container_of(fwd[i], struct key, node)->key < lo; i++)
+		;
+	for (j = i; j < nodes && container_of(fwd[j], struct key, node)->key <= hi; j++)
+		;
+	ctx.exp = fwd + i;
+	ctx.pos = 0;
+	if (ceb32_walk_range(&ceb_root, lo, hi, walk_cb, &ctx) || ctx.pos != j - i ||
+	    ceb32_count_range(&ceb_root, lo, hi) != (size_t)(j - i)) {
+		printf("range walk %u-%u visited %d nodes instead of %d\n", lo, hi, ctx.pos, j - i);
+		abort();
+	}
+
+	for (node = ceb32_last(&ceb_root); node; node = ceb32_prev(&ceb_root, node)) {
+		if (!n || fwd[--n] != node) {
+			printf("backwards walk mismatch at %d\n", n);
+			abort();
+		}
+	}
+
+	if (n) {
+		printf("backwards walk stopped at %d\n", n);
+		abort();
+	}
+	free(fwd);
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint32_t v, lo, hi;
+	size_t cnt;
+	int test = 0;
+	uint32_t mask = 0xf;
+	int count = 10;
+	int debug = 0;
+	int nodes = 0;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [test [cnt [mask [seed]]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		test = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 2)
+		mask = atol(larg = *(argv++));
+
+	if (argc > 3)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* test 0: random inserts and deletes of random nodes.
+	 * test 1: same, but deletes are performed using pick().
+	 * One delete out of 4 removes a short range of keys starting at the
+	 * node's key instead.
+	 * The tree is fully checked after each operation when <test> has its
+	 * bit 1 set (i.e. 2 and 3), otherwise only at the end.
+	 */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0 && (v & 0xc00) == 0) {
+			/* range delete */
+			lo = keys[(v >> 12) % nb_keys]->key;
+			hi = lo + ((v >> 20) & 3);
+			cnt = ceb32_count_range(&ceb_root, lo, hi);
+			if (ceb32_delete_range(&ceb_root, lo, hi, free_cb, NULL) != cnt ||
+			    ceb32_count_range(&ceb_root, lo, hi))
+				abort();
+			nodes -= cnt;
+			old = NULL;
+		}
+		else if (nb_keys && (v & 0x300) == 0) {
+			/* delete */
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (test & 1)
+				old = ceb32_pick(&ceb_root, key->key);
+			else
+				old = ceb32_delete(&ceb_root, &key->node);
+
+			if (!old || (!(test & 1) && old != &key->node))
+				abort();
+
+			/* the node is not in the tree anymore */
+			if (ceb32_delete(&ceb_root, old))
+				abort();
+
+			for (idx = 0; keys[idx] != container_of(old, struct key, node); idx++)
+				;
+			free(keys[idx]);
+			keys[idx] = keys[--nb_keys];
+			nodes--;
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			key->key = v & mask;
+			old = ceb32_insert(&ceb_root, &key->node);
+			if (old != &key->node)
+				abort();
+			keys[nb_keys++] = key;
+			nodes++;
+		}
+
+		if (debug > 1) {
+			static int round;
+			char cmd[100];
+			size_t len;
+
+			len = snprintf(cmd, sizeof(cmd), "%s %d/%d : %p %d\n", orig_argv, round, round+count, old, v & mask);
+			ceb32_default_dump(&ceb_root, len < sizeof(cmd) ? cmd : orig_argv, old);
+			round++;
+		}
+
+		if (test & 2)
+			check_tree(nodes, mask);
+	}
+
+	check_tree(nodes, mask);
+
+	if (debug == 1)
+		ceb32_default_dump(&ceb_root, orig_argv, 0);
+	return 0;
+}
@@ -0,0 +1,325 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu32_tree.h"
+#include "cebhu32_tree.h"
+
+/* The relative tree is entirely contained in a 64 kB arena starting with its
+ * root, so that it can be copied anywhere. The same keys are also indexed in
+ * an absolute tree made of reference nodes, used to check the results.
+ */
+#define ARENA_SIZE 65536
+
+struct key {
+	struct cebh_node node; // relative node, key follows
+	uint32_t key;
+};
+
+struct arena {
+	int16_t root;
+	struct key keys[0];
+};
+
+struct ref {
+	struct ceb_node node;
+	uint32_t key;
+};
+
+struct ceb_node *ceb_root = NULL;
+struct ref *refs;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns the index of relative node <node> in arena <a>, or -1 for NULL */
+static long idx(const struct arena *a, const struct cebh_node *node)
+{
+	if (!node)
+		return -1;
+	return container_of(node, struct key, node) - a->keys;
+}
+
+/* returns the index of reference node <node>, or -1 for NULL */
+static long ridx(const struct ceb_node *node)
+{
+	if (!node)
+		return -1;
+	return container_of(node, struct ref, node) - refs;
+}
+
+/* compares the relative tree in arena <a> against the reference one using all
+ * lookup methods around key <v>. Aborts on error.
+ */
+static void check(const char *step, struct arena *a, uint32_t v)
+{
+	long i1, i2;
+
+#define CHECK(name, rel, abs) do {					\
+		i1 = idx(a, rel); i2 = ridx(abs);			\
+		if (i1 != i2) {						\
+			printf("%s: %s(%u) mismatch: %ld vs %ld\n",	\
+			       step, name, v, i1, i2);			\
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebhu32_lookup(&a->root, v),    cebu32_lookup(&ceb_root, v));
+	CHECK("lookup_le", cebhu32_lookup_le(&a->root, v), cebu32_lookup_le(&ceb_root, v));
+	CHECK("lookup_lt", cebhu32_lookup_lt(&a->root, v), cebu32_lookup_lt(&ceb_root, v));
+	CHECK("lookup_ge", cebhu32_lookup_ge(&a->root, v), cebu32_lookup_ge(&ceb_root, v));
+	CHECK("lookup_gt", cebhu32_lookup_gt(&a->root, v), cebu32_lookup_gt(&ceb_root, v));
+#undef CHECK
+}
+
+/* walks the relative tree in arena <a> and the reference one in both
+ * directions and verifies they contain the same nodes. Aborts on error.
+ */
+static void check_walk(const char *step, struct arena *a)
+{
+	struct cebh_node *node;
+	struct ceb_node *rnode;
+
+	for (node = cebhu32_first(&a->root), rnode = cebu32_first(&ceb_root);
+	     node || rnode;
+	     node = cebhu32_next(&a->root, node), rnode = cebu32_next(&ceb_root, rnode)) {
+		if (idx(a, node) != ridx(rnode)) {
+			printf("%s: forward walk mismatch: %ld vs %ld\n", step, idx(a, node), ridx(rnode));
+			abort();
+		}
+	}
+
+	for (node = cebhu32_last(&a->root), rnode = cebu32_last(&ceb_root);
+	     node || rnode;
+	     node = cebhu32_prev(&a->root, node), rnode = cebu32_prev(&ceb_root, rnode)) {
+		if (idx(a, node) != ridx(rnode)) {
+			printf("%s: backward walk mismatch: %ld vs %ld\n", step, idx(a, node), ridx(rnode));
+			abort();
+		}
+	}
+}
+
+/* steps iterator <iter> over the relative tree in arena <a> forwards or
+ * backwards from key <*cur>, or from outside the tree if <*on> is zero, and
+ * compares the result with the same move in the reference tree. A stale
+ * iterator is repositioned on a random key using a seek. Aborts on error.
+ */
+static void check_iter(struct ceb_iter *iter, struct arena *a, uint32_t *cur, int *on, int back, uint32_t mask)
+{
+	struct cebh_node *ret;
+	struct ceb_node *exp;
+
+	ret = back ? cebhu32_iter_prev(iter) : cebhu32_iter_next(iter);
+	if (ceb_iter_stale(iter)) {
+		*cur = rnd32() & mask;
+		ret = cebhu32_iter_seek(iter, *cur);
+		exp = cebu32_lookup_ge(&ceb_root, *cur);
+	}
+	else if (!*on)
+		exp = back ? cebu32_last(&ceb_root) : cebu32_first(&ceb_root);
+	else
+		exp = back ? cebu32_lookup_lt(&ceb_root, *cur) : cebu32_lookup_gt(&ceb_root, *cur);
+
+	if (idx(a, ret) != ridx(exp)) {
+		printf("iter %s from %#x (%s) returned %ld instead of %ld\n", back ? "prev" : "next",
+		       *cur, *on ? "on" : "off", idx(a, ret), ridx(exp));
+		abort();
+	}
+
+	*on = !!ret;
+	if (ret)
+		*cur = container_of(ret, struct key, node)->key;
+}
+
+int main(int argc, char **argv)
+{
+	struct arena *arena, *copy;
+	struct ceb_iter iter;
+	struct cebh_node *node;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint32_t v;
+	uint32_t mask = 0xffff;
+	uint32_t cur, lo, hi;
+	size_t cnt;
+	int count = 1000;
+	int debug = 0;
+	int i, j, on;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = atol(larg = *(argv++));
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	if (count > (ARENA_SIZE - (int)sizeof(struct arena)) / (int)sizeof(struct key))
+		count = (ARENA_SIZE - sizeof(struct arena)) / sizeof(struct key);
+
+	/* twice the size to verify that nodes past the window are rejected */
+	arena = calloc(1, 2 * ARENA_SIZE);
+	copy = calloc(1, ARENA_SIZE);
+	refs = calloc(count, sizeof(*refs));
+
+	/* insert random keys, and delete some from time to time */
+	for (i = 0; i < count; i++) {
+		v = rnd32() & mask;
+		key = &arena->keys[i];
+		key->key = refs[i].key = v;
+
+		if (cebhu32_insert(&arena->root, &key->node) == &key->node) {
+			if (cebu32_insert(&ceb_root, &refs[i].node) != &refs[i].node)
+				abort();
+		}
+
+		if (!(rnd32() & 7)) {
+			v = rnd32() & mask;
+			if (ridx(cebu32_pick(&ceb_root, v)) != idx(arena, cebhu32_pick(&arena->root, v)))
+				abort();
+		}
+		check("insert", arena, v);
+	}
+
+	check_walk("orig", arena);
+
+	/* the last node entirely fitting in the window is accepted, the next
+	 * one is rejected without touching the tree.
+	 */
+	key = (struct key *)((char *)arena + ARENA_SIZE - sizeof(struct cebh_node));
+	key->key = ~0U;
+	if (cebhu32_insert(&arena->root, &key->node) != &key->node ||
+	    cebhu32_last(&arena->root) != &key->node ||
+	    cebhu32_delete(&arena->root, &key->node) != &key->node)
+		abort();
+
+	key = (struct key *)((char *)arena + ARENA_SIZE);
+	key->key = ~0U;
+	if (cebhu32_insert(&arena->root, &key->node) != NULL)
+		abort();
+	check_walk("far", arena);
+
+	/* now the tree is moved elsewhere and must still be valid there */
+	memcpy(copy, arena, ARENA_SIZE);
+	memset(arena, 0, ARENA_SIZE);
+	check_walk("copy", copy);
+
+	if (debug)
+		cebhu32_default_dump(&copy->root, orig_argv, 0);
+
+	for (i = 0; i < count; i++) {
+		v = rnd32() & mask;
+		check("copy", copy, v);
+	}
+
+	/* an iterator moves back and forth over the copy while random keys are
+	 * deleted and inserted again around it. Deleted nodes remain readable in
+	 * the arena, and deleting the iterator's current node must always make
+	 * it stale.
+	 */
+	cebhu32_iter_init(&iter, &copy->root);
+	cur = 0; on = 0;
+	for (i = 0; i < count; i++) {
+		if (on && !(rnd32() & 15)) {
+			node = cebhu32_lookup(&copy->root, cur);
+			if (!node)
+				abort();
+			j = idx(copy, node);
+			if (cebhu32_delete(&copy->root, node) != node ||
+			    cebu32_delete(&ceb_root, &refs[j].node) != &refs[j].node)
+				abort();
+			if (cebhu32_iter_next(&iter) || !ceb_iter_stale(&iter)) {
+				printf("iter: deleting current node %#x didn't make it stale\n", cur);
+				abort();
+			}
+		}
+		else {
+			j = rnd32() % count;
+			key = &copy->keys[j];
+			node = cebhu32_lookup(&copy->root, key->key);
+			if (node == &key->node) {
+				if (cebhu32_delete(&copy->root, node) != node ||
+				    cebu32_delete(&ceb_root, &refs[j].node) != &refs[j].node)
+					abort();
+			}
+			else if (!node) {
+				if (cebhu32_insert(&copy->root, &key->node) != &key->node ||
+				    cebu32_insert(&ceb_root, &refs[j].node) != &refs[j].node)
+					abort();
+			}
+		}
+		check_iter(&iter, copy, &cur, &on, rnd32() & 1, mask);
+		check_iter(&iter, copy, &cur, &on, rnd32() & 1, mask);
+	}
+	check_walk("iter", copy);
+
+	/* random ranges deleted from the copy and the reference tree must remove
+	 * the same keys from both.
+	 */
+	for (i = 0; i < 16; i++) {
+		lo = rnd32() & mask;
+		hi = lo + ((rnd32() & mask) >> 6);
+		if (hi < lo)
+			hi = lo;
+
+		cnt = cebu32_count_range(&ceb_root, lo, hi);
+		if (cebhu32_count_range(&copy->root, lo, hi) != cnt ||
+		    cebhu32_delete_range(&copy->root, lo, hi, NULL, NULL) != cnt ||
+		    cebu32_delete_range(&ceb_root, lo, hi, NULL, NULL) != cnt ||
+		    cebhu32_count_range(&copy->root, lo, hi)) {
+			printf("range %#x-%#x: failed to delete %lu keys\n",
+			       lo, hi, (unsigned long)cnt);
+			abort();
+		}
+		check_walk("range", copy);
+	}
+
+	/* delete everything from the copy */
+	for (i = 0; i < count; i++) {
+		key = &copy->keys[i];
+		if (cebhu32_lookup(&copy->root, key->key) == &key->node) {
+			if (cebhu32_delete(&copy->root, &key->node) != &key->node)
+				abort();
+			if (cebu32_delete(&ceb_root, &refs[i].node) != &refs[i].node)
+				abort();
+		}
+	}
+
+	if (copy->root || ceb_root)
+		abort();
+
+	return 0;
+}
@@ -0,0 +1,338 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu64_tree.h"
+#include "cebqu64_tree.h"
+
+/* The relative tree is entirely contained in an arena starting with its root,
+ * so that it can be copied anywhere. The same keys are also indexed in an
+ * absolute tree used as a reference.
+ */
+struct key {
+	struct ceb_node anode; // absolute reference
+	struct cebq_node node; // relative node, key follows
+	uint64_t key;
+};
+
+struct arena {
+	int64_t root;
+	struct key keys[0];
+};
+
+struct ceb_node *ceb_root = NULL;
+
+/* offset of the key relative to the absolute node */
+#define AKOFS (offsetof(struct key, key) - offsetof(struct key, anode))
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns the index of relative node <node> in arena <a>, or -1 for NULL */
+static long idx(const struct arena *a, const struct cebq_node *node)
+{
+	if (!node)
+		return -1;
+	return container_of(node, struct key, node) - a->keys;
+}
+
+/* returns the index of absolute node <node> in arena <a>, or -1 for NULL */
+static long aidx(const struct arena *a, const struct ceb_node *node)
+{
+	if (!node)
+		return -1;
+	return container_of(node, struct key, anode) - a->keys;
+}
+
+/* compares the relative tree in arena <a> against the absolute one built
+ * using the nodes of arena <ref>, using all lookup methods around key <v>.
+ * Aborts on error.
+ */
+static void check(const char *step, struct arena *a, struct arena *ref, uint64_t v)
+{
+	long i1, i2;
+
+#define CHECK(name, rel, abs) do {					\
+		i1 = idx(a, rel); i2 = aidx(ref, abs);			\
+		if (i1 != i2) {						\
+			printf("%s: %s(%llu) mismatch: %ld vs %ld\n",	\
+			       step, name, (unsigned long long)v, i1, i2); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebqu64_lookup(&a->root, v),    cebu64_ofs_lookup(&ceb_root, AKOFS, v));
+	CHECK("lookup_le", cebqu64_lookup_le(&a->root, v), cebu64_ofs_lookup_le(&ceb_root, AKOFS, v));
+	CHECK("lookup_lt", cebqu64_lookup_lt(&a->root, v), cebu64_ofs_lookup_lt(&ceb_root, AKOFS, v));
+	CHECK("lookup_ge", cebqu64_lookup_ge(&a->root, v), cebu64_ofs_lookup_ge(&ceb_root, AKOFS, v));
+	CHECK("lookup_gt", cebqu64_lookup_gt(&a->root, v), cebu64_ofs_lookup_gt(&ceb_root, AKOFS, v));
+#undef CHECK
+}
+
+/* state of a walk over a relative tree compared with the absolute one */
+struct walk_ctx {
+	const char *step;
+	struct arena *a, *ref;
+	struct ceb_node *anode;
+};
+
+/* walk callback verifying that nodes of the relative tree are visited in the
+ * same order as those of the absolute one with first/next. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (idx(ctx->a, (struct cebq_node *)node) != aidx(ctx->ref, ctx->anode)) {
+		printf("%s: walk mismatch: %ld vs %ld\n", ctx->step,
+		       idx(ctx->a, (struct cebq_node *)node), aidx(ctx->ref, ctx->anode));
+		abort();
+	}
+	ctx->anode = cebu64_ofs_next(&ceb_root, AKOFS, ctx->anode);
+	return 0;
+}
+
+/* walks the relative tree in arena <a> and the absolute one in both directions
+ * and verifies they contain the same nodes. Aborts on error.
+ */
+static void check_walk(const char *step, struct arena *a, struct arena *ref)
+{
+	struct cebq_node *node;
+	struct ceb_node *anode;
+	struct walk_ctx ctx;
+
+	for (node = cebqu64_first(&a->root), anode = cebu64_ofs_first(&ceb_root, AKOFS);
+	     node || anode;
+	     node = cebqu64_next(&a->root, node), anode = cebu64_ofs_next(&ceb_root, AKOFS, anode)) {
+		if (idx(a, node) != aidx(ref, anode)) {
+			printf("%s: forward walk mismatch: %ld vs %ld\n", step, idx(a, node), aidx(ref, anode));
+			abort();
+		}
+	}
+
+	for (node = cebqu64_last(&a->root), anode = cebu64_ofs_last(&ceb_root, AKOFS);
+	     node || anode;
+	     node = cebqu64_prev(&a->root, node), anode = cebu64_ofs_prev(&ceb_root, AKOFS, anode)) {
+		if (idx(a, node) != aidx(ref, anode)) {
+			printf("%s: backward walk mismatch: %ld vs %ld\n", step, idx(a, node), aidx(ref, anode));
+			abort();
+		}
+	}
+
+	ctx.step = step;
+	ctx.a = a;
+	ctx.ref = ref;
+	ctx.anode = cebu64_ofs_first(&ceb_root, AKOFS);
+	if (cebqu64_walk(&a->root, walk_cb, &ctx) || ctx.anode) {
+		printf("%s: walk stopped early\n", step);
+		abort();
+	}
+}
+
+/* steps iterator <iter> over the relative tree in arena <a> forwards or
+ * backwards from key <*cur>, or from outside the tree if <*on> is zero, and
+ * compares the result with the same move in the absolute tree built using the
+ * nodes of arena <ref>. A stale iterator is repositioned on a random key using
+ * a seek. Aborts on error.
+ */
+static void check_iter(struct ceb_iter *iter, struct arena *a, struct arena *ref,
+                       uint64_t *cur, int *on, int back, uint64_t mask)
+{
+	struct cebq_node *ret;
+	struct ceb_node *exp;
+
+	ret = back ? cebqu64_iter_prev(iter) : cebqu64_iter_next(iter);
+	if (ceb_iter_stale(iter)) {
+		*cur = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		ret = cebqu64_iter_seek(iter, *cur);
+		exp = cebu64_ofs_lookup_ge(&ceb_root, AKOFS, *cur);
+	}
+	else if (!*on)
+		exp = back ? cebu64_ofs_last(&ceb_root, AKOFS) : cebu64_ofs_first(&ceb_root, AKOFS);
+	else
+		exp = back ? cebu64_ofs_lookup_lt(&ceb_root, AKOFS, *cur) : cebu64_ofs_lookup_gt(&ceb_root, AKOFS, *cur);
+
+	if (idx(a, ret) != aidx(ref, exp)) {
+		printf("iter %s from %#llx (%s) returned %ld instead of %ld\n", back ? "prev" : "next",
+		       (unsigned long long)*cur, *on ? "on" : "off", idx(a, ret), aidx(ref, exp));
+		abort();
+	}
+
+	*on = !!ret;
+	if (ret)
+		*cur = container_of(ret, struct key, node)->key;
+}
+
+int main(int argc, char **argv)
+{
+	struct arena *arena, *copy;
+	struct ceb_iter iter;
+	struct cebq_node *node;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint64_t v;
+	uint64_t mask = 0xffff;
+	uint64_t cur, lo, hi;
+	size_t cnt;
+	int count = 1000;
+	int debug = 0;
+	size_t size;
+	int i, j, on;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = atoll(larg = *(argv++));
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	size = sizeof(*arena) + count * sizeof(*arena->keys);
+	arena = calloc(1, size);
+	copy = calloc(1, size);
+
+	/* insert random keys, and delete some from time to time */
+	for (i = 0; i < count; i++) {
+		v = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		key = &arena->keys[i];
+		key->key = v;
+
+		if (cebqu64_insert(&arena->root, &key->node) == &key->node) {
+			if (cebu64_ofs_insert(&ceb_root, AKOFS, &key->anode) != &key->anode)
+				abort();
+		}
+
+		if (!(rnd32() & 7)) {
+			v = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+			if (aidx(arena, cebu64_ofs_pick(&ceb_root, AKOFS, v)) != idx(arena, cebqu64_pick(&arena->root, v)))
+				abort();
+		}
+		check("insert", arena, arena, v);
+	}
+
+	check_walk("orig", arena, arena);
+
+	/* now the tree is moved elsewhere and must still be valid there */
+	memcpy(copy, arena, size);
+	memset(arena, 0, sizeof(*arena));
+	check_walk("copy", copy, arena);
+
+	if (debug)
+		cebqu64_default_dump(&copy->root, orig_argv, 0);
+
+	for (i = 0; i < count; i++) {
+		v = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		check("copy", copy, arena, v);
+	}
+
+	/* an iterator moves back and forth over the copy while random keys are
+	 * deleted and inserted again around it. Deleted nodes remain readable in
+	 * the arena, and deleting the iterator's current node must always make
+	 * it stale.
+	 */
+	cebqu64_iter_init(&iter, &copy->root);
+	cur = 0; on = 0;
+	for (i = 0; i < count; i++) {
+		if (on && !(rnd32() & 15)) {
+			node = cebqu64_lookup(&copy->root, cur);
+			if (!node)
+				abort();
+			j = idx(copy, node);
+			if (cebqu64_delete(&copy->root, node) != node ||
+			    cebu64_ofs_delete(&ceb_root, AKOFS, &arena->keys[j].anode) != &arena->keys[j].anode)
+				abort();
+			if (cebqu64_iter_next(&iter) || !ceb_iter_stale(&iter)) {
+				printf("iter: deleting current node %#llx didn't make it stale\n", (unsigned long long)cur);
+				abort();
+			}
+		}
+		else {
+			j = rnd32() % count;
+			key = &copy->keys[j];
+			node = cebqu64_lookup(&copy->root, key->key);
+			if (node == &key->node) {
+				if (cebqu64_delete(&copy->root, node) != node ||
+				    cebu64_ofs_delete(&ceb_root, AKOFS, &arena->keys[j].anode) != &arena->keys[j].anode)
+					abort();
+			}
+			else if (!node) {
+				if (cebqu64_insert(&copy->root, &key->node) != &key->node ||
+				    cebu64_ofs_insert(&ceb_root, AKOFS, &arena->keys[j].anode) != &arena->keys[j].anode)
+					abort();
+			}
+		}
+		check_iter(&iter, copy, arena, &cur, &on, rnd32() & 1, mask);
+		check_iter(&iter, copy, arena, &cur, &on, rnd32() & 1, mask);
+	}
+	check_walk("iter", copy, arena);
+
+	/* random ranges deleted from the copy and the reference tree must remove
+	 * the same keys from both.
+	 */
+	for (i = 0; i < 16; i++) {
+		lo = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		hi = lo + ((rnd32() & mask) >> 6);
+		if (hi < lo)
+			hi = lo;
+
+		cnt = cebu64_ofs_count_range(&ceb_root, AKOFS, lo, hi);
+		if (cebqu64_count_range(&copy->root, lo, hi) != cnt ||
+		    cebqu64_delete_range(&copy->root, lo, hi, NULL, NULL) != cnt ||
+		    cebu64_ofs_delete_range(&ceb_root, AKOFS, lo, hi, NULL, NULL) != cnt ||
+		    cebqu64_count_range(&copy->root, lo, hi)) {
+			printf("range %#llx-%#llx: failed to delete %lu keys\n",
+			       (unsigned long long)lo, (unsigned long long)hi, (unsigned long)cnt);
+			abort();
+		}
+		check_walk("range", copy, arena);
+	}
+
+	/* deleting from the copy must not affect the original's area */
+	for (i = 0; i < count; i++) {
+		key = &copy->keys[i];
+		if (cebqu64_lookup(&copy->root, key->key) == &key->node) {
+			if (cebqu64_delete(&copy->root, &key->node) != &key->node)
+				abort();
+			if (cebu64_ofs_delete(&ceb_root, AKOFS, &arena->keys[i].anode) != &arena->keys[i].anode)
+				abort();
+		}
+	}
+
+	if (copy->root || ceb_root)
+		abort();
+
+	return 0;
+}
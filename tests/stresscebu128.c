@@ -0,0 +1,298 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu128_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+struct key {
+	struct ceb_node node;
+	uint64_t key[2]; // most significant word first
+};
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+static uint64_t rnd64()
+{
+	return ((uint64_t)rnd32() << 32) + rnd32();
+}
+
+/* compares keys <a> and <b> as 128-bit integers */
+static int cmp(const uint64_t *a, const uint64_t *b)
+{
+	if (a[0] != b[0])
+		return a[0] < b[0] ? -1 : 1;
+	if (a[1] != b[1])
+		return a[1] < b[1] ? -1 : 1;
+	return 0;
+}
+
+/* returns the key of node <node> or "-" if NULL, in a static buffer */
+static const char *kstr(const struct ceb_node *node)
+{
+	static char buf[2][40];
+	static int idx;
+	const struct key *key;
+
+	idx ^= 1;
+	if (!node)
+		return "-";
+	key = container_of(node, struct key, node);
+	snprintf(buf[idx], sizeof(buf[idx]), "%016llx:%016llx",
+		 (unsigned long long)key->key[0], (unsigned long long)key->key[1]);
+	return buf[idx];
+}
+
+/* compares the result of all lookups around <v> with the expected ones
+ * calculated from the list of keys. Aborts on error.
+ */
+static void check(uint64_t hi, uint64_t lo)
+{
+	struct key *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	const uint64_t v[2] = { hi, lo };
+	int i, c;
+
+	for (i = 0; i < nb_keys; i++) {
+		struct key *k = keys[i];
+
+		c = cmp(k->key, v);
+		if (c == 0)
+			eq = k;
+		if (c <= 0 && (!le || cmp(k->key, le->key) > 0))
+			le = k;
+		if (c <  0 && (!lt || cmp(k->key, lt->key) > 0))
+			lt = k;
+		if (c >= 0 && (!ge || cmp(k->key, ge->key) < 0))
+			ge = k;
+		if (c >  0 && (!gt || cmp(k->key, gt->key) < 0))
+			gt = k;
+	}
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->node : NULL)) {			\
+			printf("%s(%016llx:%016llx) returned %s instead of %s\n", \
+			       name, (unsigned long long)hi, (unsigned long long)lo, \
+			       kstr(n), kstr(exp ? &exp->node : NULL));	\
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebu128_lookup(&ceb_root, hi, lo),    eq);
+	CHECK("lookup_le", cebu128_lookup_le(&ceb_root, hi, lo), le);
+	CHECK("lookup_lt", cebu128_lookup_lt(&ceb_root, hi, lo), lt);
+	CHECK("lookup_ge", cebu128_lookup_ge(&ceb_root, hi, lo), ge);
+	CHECK("lookup_gt", cebu128_lookup_gt(&ceb_root, hi, lo), gt);
+#undef CHECK
+}
+
+/* walks the whole tree in both directions, verifying that keys are ordered
+ * and that all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebu128_first(&ceb_root); node; prev = node, node = cebu128_next(&ceb_root, node), n++) {
+		if (prev && cmp(container_of(prev, struct key, node)->key, container_of(node, struct key, node)->key) >= 0) {
+			printf("key %s after %s\n", kstr(node), kstr(prev));
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebu128_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebu128_last(&ceb_root); node; prev = node, node = cebu128_prev(&ceb_root, node), n++) {
+		if (prev && cmp(container_of(prev, struct key, node)->key, container_of(node, struct key, node)->key) <= 0) {
+			printf("key %s before %s\n", kstr(node), kstr(prev));
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebu128_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+/* orders keys as 128-bit integers, for qsort() */
+static int keysort(const void *a, const void *b)
+{
+	return cmp((*(const struct key **)a)->key, (*(const struct key **)b)->key);
+}
+
+/* state of a range walk: the keys expected in this order, their number and
+ * the number of nodes visited.
+ */
+struct walk_ctx {
+	struct key **exp;
+	size_t nb, visits;
+};
+
+/* range walk callback verifying that nodes are visited in the order of the
+ * sorted keys. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (ctx->visits >= ctx->nb || node != &ctx->exp[ctx->visits]->node) {
+		printf("range walk visited %s instead of %s\n", kstr(node),
+		       ctx->visits < ctx->nb ? kstr(&ctx->exp[ctx->visits]->node) : "-");
+		abort();
+	}
+	ctx->visits++;
+	return 0;
+}
+
+/* walks and counts the nodes between <lo> and <hi>, comparing them with the
+ * sorted keys of this range. Aborts on error.
+ */
+static void check_range(const uint64_t *lo, const uint64_t *hi)
+{
+	struct walk_ctx ctx;
+	int i;
+
+	ctx.exp = malloc((nb_keys + 1) * sizeof(*ctx.exp));
+	ctx.nb = ctx.visits = 0;
+	for (i = 0; i < nb_keys; i++) {
+		if (cmp(keys[i]->key, lo) >= 0 && cmp(keys[i]->key, hi) <= 0)
+			ctx.exp[ctx.nb++] = keys[i];
+	}
+	qsort(ctx.exp, ctx.nb, sizeof(*ctx.exp), keysort);
+
+	if (cebu128_walk_range(&ceb_root, lo[0], lo[1], hi[0], hi[1], walk_cb, &ctx) || ctx.visits != ctx.nb ||
+	    cebu128_count_range(&ceb_root, lo[0], lo[1], hi[0], hi[1]) != ctx.nb) {
+		printf("range %016llx:%016llx-%016llx:%016llx: visited %zu nodes instead of %zu\n",
+		       (unsigned long long)lo[0], (unsigned long long)lo[1],
+		       (unsigned long long)hi[0], (unsigned long long)hi[1], ctx.visits, ctx.nb);
+		abort();
+	}
+	free(ctx.exp);
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint64_t lo[2], hi[2], tmp;
+	uint64_t mask = 0xffff;
+	int count = 1000;
+	int debug = 0;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = strtoull(larg = *(argv++), NULL, 0);
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* random inserts and deletes. The mask applies to both words, and the
+	 * upper word only uses a few values so that many keys share it.
+	 */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			/* delete */
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (v & 0x400)
+				old = cebu128_pick(&ceb_root, key->key[0], key->key[1]);
+			else
+				old = cebu128_delete(&ceb_root, &key->node);
+			if (old != &key->node)
+				abort();
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			key->key[0] = (rnd64() & mask) >> (v & 63);
+			key->key[1] = rnd64() & mask;
+			old = cebu128_insert(&ceb_root, &key->node);
+			if (old == &key->node)
+				keys[nb_keys++] = key;
+			else
+				free(key);
+		}
+
+		v = rnd32();
+		check((rnd64() & mask) >> (v & 63), rnd64() & mask);
+		check(rnd64(), rnd64());
+
+		/* a range whose bounds may differ by either word */
+		lo[0] = (rnd64() & mask) >> (v & 63);
+		lo[1] = rnd64() & mask;
+		hi[0] = (v & 0x40) ? lo[0] : (rnd64() & mask) >> ((v >> 8) & 63);
+		hi[1] = rnd64() & mask;
+		if (cmp(lo, hi) > 0) {
+			tmp = lo[0]; lo[0] = hi[0]; hi[0] = tmp;
+			tmp = lo[1]; lo[1] = hi[1]; hi[1] = tmp;
+		}
+		check_range(lo, hi);
+	}
+
+	check_walk();
+
+	/* limits */
+	check(0, 0);
+	check(0, ~0ULL);
+	check(1, 0);
+	check(~0ULL, ~0ULL);
+	lo[0] = lo[1] = 0;
+	hi[0] = hi[1] = ~0ULL;
+	check_range(lo, hi);
+
+	if (debug)
+		cebu128_default_dump(&ceb_root, orig_argv, 0);
+	return 0;
+}
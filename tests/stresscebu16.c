@@ -0,0 +1,253 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu16_tree.h"
+#include "cebu8_tree.h"
+
+struct ceb_node *ceb_root16 = NULL;
+struct ceb_node *ceb_root8 = NULL;
+
+/* each key is indexed in both trees. The 16-bit key immediately follows its
+ * node and is followed by random bytes which must never be considered. The
+ * 8-bit key is the low byte of the 16-bit one and is reached via its offset.
+ */
+struct key {
+	struct ceb_node node16;
+	uint16_t key16;
+	uint8_t garbage[6];
+	struct ceb_node node8;
+	uint8_t key8;
+};
+
+/* offset of the 8-bit key relative to its node */
+#define KOFS8 (offsetof(struct key, key8) - offsetof(struct key, node8))
+
+/* all keys present in the 16-bit tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns the key expected for a lookup of <v> using operation <op> ("eq",
+ * "le", "lt", "ge", "gt"), calculated from the list of keys for which
+ * <present> is true. <bits> indicates whether the 16-bit or 8-bit key is
+ * compared.
+ */
+static struct key *expect(const char *op, uint32_t v, int bits, int (*present)(const struct key *))
+{
+	struct key *best = NULL;
+	uint32_t k, b = 0;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		if (!present(keys[i]))
+			continue;
+		k = (bits == 16) ? keys[i]->key16 : keys[i]->key8;
+		if ((strcmp(op, "eq") == 0 && k == v) ||
+		    (strcmp(op, "le") == 0 && k <= v && (!best || k > b)) ||
+		    (strcmp(op, "lt") == 0 && k <  v && (!best || k > b)) ||
+		    (strcmp(op, "ge") == 0 && k >= v && (!best || k < b)) ||
+		    (strcmp(op, "gt") == 0 && k >  v && (!best || k < b))) {
+			best = keys[i];
+			b = k;
+		}
+	}
+	return best;
+}
+
+/* keys are always in the 16-bit tree */
+static int in16(const struct key *key)
+{
+	return 1;
+}
+
+/* keys are only in the 8-bit tree when their node is attached */
+static int in8(const struct key *key)
+{
+	return cebu8_ofs_lookup(&ceb_root8, KOFS8, key->key8) == &key->node8;
+}
+
+/* compares the result of all lookups around <v> in both trees with the
+ * expected ones calculated from the list of keys. Aborts on error.
+ */
+static void check(uint16_t v)
+{
+	struct key *exp;
+	struct ceb_node *n;
+
+#define CHECK(name, bits, res, field) do {					\
+		exp = expect(name, (bits == 16) ? v : (uint8_t)v, bits,	\
+			     (bits == 16) ? in16 : in8);			\
+		n = res;						\
+		if (n != (exp ? &exp->field : NULL)) {			\
+			printf("cebu%d lookup_%s(%u) returned %p instead of %p\n", \
+			       bits, name, (bits == 16) ? v : (uint8_t)v, n, exp ? &exp->field : NULL); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("eq", 16, cebu16_lookup(&ceb_root16, v),    node16);
+	CHECK("le", 16, cebu16_lookup_le(&ceb_root16, v), node16);
+	CHECK("lt", 16, cebu16_lookup_lt(&ceb_root16, v), node16);
+	CHECK("ge", 16, cebu16_lookup_ge(&ceb_root16, v), node16);
+	CHECK("gt", 16, cebu16_lookup_gt(&ceb_root16, v), node16);
+
+	CHECK("le", 8, cebu8_ofs_lookup_le(&ceb_root8, KOFS8, v), node8);
+	CHECK("lt", 8, cebu8_ofs_lookup_lt(&ceb_root8, KOFS8, v), node8);
+	CHECK("ge", 8, cebu8_ofs_lookup_ge(&ceb_root8, KOFS8, v), node8);
+	CHECK("gt", 8, cebu8_ofs_lookup_gt(&ceb_root8, KOFS8, v), node8);
+#undef CHECK
+}
+
+/* walks both trees in both directions, verifying that keys are ordered and
+ * that the expected number of nodes is visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	int n, n8, i;
+
+	for (n = 0, prev = NULL, node = cebu16_first(&ceb_root16); node; prev = node, node = cebu16_next(&ceb_root16, node), n++) {
+		if (prev && container_of(prev, struct key, node16)->key16 >= container_of(node, struct key, node16)->key16) {
+			printf("cebu16: key %u after %u\n", container_of(node, struct key, node16)->key16, container_of(prev, struct key, node16)->key16);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebu16_last(&ceb_root16)) {
+		printf("cebu16: forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebu16_last(&ceb_root16); node; prev = node, node = cebu16_prev(&ceb_root16, node), n++)
+		;
+
+	if (n != nb_keys || prev != cebu16_first(&ceb_root16)) {
+		printf("cebu16: backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n8 = i = 0; i < nb_keys; i++)
+		n8 += in8(keys[i]);
+
+	for (n = 0, prev = NULL, node = cebu8_ofs_first(&ceb_root8, KOFS8); node; prev = node, node = cebu8_ofs_next(&ceb_root8, KOFS8, node), n++) {
+		if (prev && container_of(prev, struct key, node8)->key8 >= container_of(node, struct key, node8)->key8) {
+			printf("cebu8: key %u after %u\n", container_of(node, struct key, node8)->key8, container_of(prev, struct key, node8)->key8);
+			abort();
+		}
+	}
+
+	if (n != n8 || prev != cebu8_ofs_last(&ceb_root8, KOFS8)) {
+		printf("cebu8: forward walk found %d nodes instead of %d\n", n, n8);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebu8_ofs_last(&ceb_root8, KOFS8); node; prev = node, node = cebu8_ofs_prev(&ceb_root8, KOFS8, node), n++)
+		;
+
+	if (n != n8 || prev != cebu8_ofs_first(&ceb_root8, KOFS8)) {
+		printf("cebu8: backward walk found %d nodes instead of %d\n", n, n8);
+		abort();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint32_t mask = 0xffff;
+	int count = 1000;
+	int debug = 0;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = atol(larg = *(argv++));
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* random inserts and deletes */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			/* delete */
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (in8(key) && cebu8_ofs_pick(&ceb_root8, KOFS8, key->key8) != &key->node8)
+				abort();
+			if (cebu16_pick(&ceb_root16, key->key16) != &key->node16)
+				abort();
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			key->key16 = v & mask;
+			key->key8  = v & mask;
+			memset(key->garbage, rnd32(), sizeof(key->garbage));
+			old = cebu16_insert(&ceb_root16, &key->node16);
+			if (old == &key->node16) {
+				keys[nb_keys++] = key;
+				cebu8_ofs_insert(&ceb_root8, KOFS8, &key->node8);
+			}
+			else
+				free(key);
+		}
+
+		check(rnd32() & mask);
+		check(rnd32());
+	}
+
+	check_walk();
+
+	/* limits */
+	check(0);
+	check(0xff);
+	check(0x100);
+	check(0xffff);
+
+	if (debug)
+		cebu16_default_dump(&ceb_root16, orig_argv, 0);
+	return 0;
+}
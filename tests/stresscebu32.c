@@ -51,6 +51,54 @@ static uint32_t rnd32()
 	return rnd32seed;
 }
 
+/* compares the result of a bracket lookup of <v> with the ones of the
+ * equivalent separate lookups. Aborts on error.
+ */
+static void check_bracket(uint32_t v)
+{
+	struct ceb_node *eq, *prev, *next;
+
+	eq = cebu32_lookup_bracket(&ceb_root, v, &prev, &next);
+	if (eq != cebu32_lookup(&ceb_root, v) ||
+	    prev != cebu32_lookup_lt(&ceb_root, v) ||
+	    next != cebu32_lookup_gt(&ceb_root, v)) {
+		printf("bracket(%#x) returned %p,%p,%p instead of %p,%p,%p\n", v, prev, eq, next,
+		       cebu32_lookup_lt(&ceb_root, v), cebu32_lookup(&ceb_root, v), cebu32_lookup_gt(&ceb_root, v));
+		abort();
+	}
+}
+
+/* steps iterator <iter> forwards or backwards from the node of key <*cur>, or
+ * from off the tree if <*on> is zero, and compares the result with the
+ * equivalent lookups unless the iterator became stale, in which case it's
+ * repositioned using a seek. <*cur> and <*on> are updated. Aborts on error.
+ */
+static void check_iter(struct ceb_iter *iter, uint32_t *cur, int *on, int back, uint32_t mask)
+{
+	struct ceb_node *ret, *exp;
+
+	ret = back ? cebu32_iter_prev(iter) : cebu32_iter_next(iter);
+	if (ceb_iter_stale(iter)) {
+		*cur = rnd32() & mask;
+		ret = cebu32_iter_seek(iter, *cur);
+		exp = cebu32_lookup_ge(&ceb_root, *cur);
+	}
+	else if (!*on)
+		exp = back ? cebu32_last(&ceb_root) : cebu32_first(&ceb_root);
+	else
+		exp = back ? cebu32_lookup_lt(&ceb_root, *cur) : cebu32_lookup_gt(&ceb_root, *cur);
+
+	if (ret != exp) {
+		printf("iter %s from %#x (%s) returned %p instead of %p\n", back ? "prev" : "next",
+		       *cur, *on ? "on" : "off", ret, exp);
+		abort();
+	}
+
+	*on = !!ret;
+	if (ret)
+		*cur = container_of(ret, struct key, node)->key;
+}
+
 int main(int argc, char **argv)
 {
 	struct ceb_node *old, *back __attribute__((unused));
@@ -179,6 +227,57 @@ int main(int argc, char **argv)
 				round++;
 			}
 		}
+	} else if (test == 3) {
+		/* random inserts and deletes, checking brackets in between */
+		while (count--) {
+			v = rnd32() & mask;
+			old = cebu32_lookup(&ceb_root, v);
+			if (old) {
+				if (cebu32_delete(&ceb_root, old) != old)
+					abort();
+				free(container_of(old, struct key, node));
+			}
+			else {
+				key = calloc(1, sizeof(*key));
+				key->key = v;
+				old = cebu32_insert(&ceb_root, &key->node);
+				if (old != &key->node)
+					abort();
+			}
+			check_bracket(rnd32() & mask);
+			check_bracket(v);
+			check_bracket(v - 1);
+			check_bracket(v + 1);
+		}
+		check_bracket(0);
+		check_bracket(~0U);
+		} else if (test == 4) {
+		/* random inserts and deletes while an iterator moves back and
+		 * forth. Removed nodes are not freed since the iterator may still
+		 * reference them.
+		 */
+		struct ceb_iter iter;
+		uint32_t cur = 0;
+		int on = 0;
+
+		cebu32_iter_init(&iter, &ceb_root);
+		while (count--) {
+			v = rnd32() & mask;
+			old = cebu32_lookup(&ceb_root, v);
+			if (old) {
+				if (cebu32_delete(&ceb_root, old) != old)
+					abort();
+			}
+			else {
+				key = calloc(1, sizeof(*key));
+				key->key = v;
+				old = cebu32_insert(&ceb_root, &key->node);
+				if (old != &key->node)
+					abort();
+			}
+			check_iter(&iter, &cur, &on, rnd32() & 1, mask);
+			check_iter(&iter, &cur, &on, rnd32() & 1, mask);
+		}
 	}
 
 	if (debug == 1)
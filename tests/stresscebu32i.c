@@ -0,0 +1,270 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu32i_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+struct key {
+	struct ceb_node node;
+	int32_t key;
+};
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns the key of node <node> or "-" if NULL, in a static buffer */
+static const char *kstr(const struct ceb_node *node)
+{
+	static char buf[2][16];
+	static int idx;
+
+	idx ^= 1;
+	if (!node)
+		return "-";
+	snprintf(buf[idx], sizeof(buf[idx]), "%d", container_of(node, struct key, node)->key);
+	return buf[idx];
+}
+
+/* compares the result of all range lookups around <v> with the expected ones
+ * calculated from the list of keys. Aborts on error.
+ */
+static void check(int32_t v)
+{
+	struct key *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		struct key *k = keys[i];
+
+		if (k->key == v)
+			eq = k;
+		if (k->key <= v && (!le || k->key > le->key))
+			le = k;
+		if (k->key <  v && (!lt || k->key > lt->key))
+			lt = k;
+		if (k->key >= v && (!ge || k->key < ge->key))
+			ge = k;
+		if (k->key >  v && (!gt || k->key < gt->key))
+			gt = k;
+	}
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->node : NULL)) {			\
+			printf("%s(%d) returned %s instead of %s\n",	\
+			       name, v, kstr(n), kstr(exp ? &exp->node : NULL)); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebu32i_lookup(&ceb_root, v),    eq);
+	CHECK("lookup_le", cebu32i_lookup_le(&ceb_root, v), le);
+	CHECK("lookup_lt", cebu32i_lookup_lt(&ceb_root, v), lt);
+	CHECK("lookup_ge", cebu32i_lookup_ge(&ceb_root, v), ge);
+	CHECK("lookup_gt", cebu32i_lookup_gt(&ceb_root, v), gt);
+#undef CHECK
+}
+
+/* walks the whole tree in both directions, verifying that keys are ordered as
+ * signed integers and that all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebu32i_first(&ceb_root); node; prev = node, node = cebu32i_next(&ceb_root, node), n++) {
+		if (prev && container_of(prev, struct key, node)->key >= container_of(node, struct key, node)->key) {
+			printf("key %s after %s\n", kstr(node), kstr(prev));
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebu32i_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebu32i_last(&ceb_root); node; prev = node, node = cebu32i_prev(&ceb_root, node), n++) {
+		if (prev && container_of(prev, struct key, node)->key <= container_of(node, struct key, node)->key) {
+			printf("key %s before %s\n", kstr(node), kstr(prev));
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebu32i_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+/* orders keys as signed integers, for qsort() */
+static int keysort(const void *a, const void *b)
+{
+	const struct key *ka = *(const struct key **)a;
+	const struct key *kb = *(const struct key **)b;
+
+	return (ka->key > kb->key) - (ka->key < kb->key);
+}
+
+/* state of a range walk: the keys expected in this order, their number and
+ * the number of nodes visited.
+ */
+struct walk_ctx {
+	struct key **exp;
+	size_t nb, visits;
+};
+
+/* range walk callback verifying that nodes are visited in the order of the
+ * sorted keys. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (ctx->visits >= ctx->nb || node != &ctx->exp[ctx->visits]->node) {
+		printf("range walk visited %s instead of %s\n", kstr(node),
+		       ctx->visits < ctx->nb ? kstr(&ctx->exp[ctx->visits]->node) : "-");
+		abort();
+	}
+	ctx->visits++;
+	return 0;
+}
+
+/* walks and counts the nodes between <lo> and <hi>, comparing them with the
+ * sorted keys of this range. Aborts on error.
+ */
+static void check_range(int32_t lo, int32_t hi)
+{
+	struct walk_ctx ctx;
+	int i;
+
+	ctx.exp = malloc((nb_keys + 1) * sizeof(*ctx.exp));
+	ctx.nb = ctx.visits = 0;
+	for (i = 0; i < nb_keys; i++) {
+		if (keys[i]->key >= lo && keys[i]->key <= hi)
+			ctx.exp[ctx.nb++] = keys[i];
+	}
+	qsort(ctx.exp, ctx.nb, sizeof(*ctx.exp), keysort);
+
+	if (cebu32i_walk_range(&ceb_root, lo, hi, walk_cb, &ctx) || ctx.visits != ctx.nb ||
+	    cebu32i_count_range(&ceb_root, lo, hi) != ctx.nb) {
+		printf("range %d..%d: visited %zu nodes instead of %zu\n", lo, hi, ctx.visits, ctx.nb);
+		abort();
+	}
+	free(ctx.exp);
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint32_t mask = 0xffff;
+	int count = 1000;
+	int debug = 0;
+	int32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = atol(larg = *(argv++));
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* random inserts and deletes of keys spread around zero. The mask is
+	 * applied to the absolute value so that both signs are equally present.
+	 */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			/* delete */
+			idx = ((uint32_t)v >> 12) % nb_keys;
+			key = keys[idx];
+			old = cebu32i_pick(&ceb_root, key->key);
+			if (old != &key->node)
+				abort();
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			key->key = (rnd32() & 1) ? (int32_t)(v & mask) : -(int32_t)(v & mask) - 1;
+			old = cebu32i_insert(&ceb_root, &key->node);
+			if (old == &key->node)
+				keys[nb_keys++] = key;
+			else
+				free(key);
+		}
+
+		v = rnd32();
+		check((rnd32() & 1) ? (int32_t)(v & mask) : -(int32_t)(v & mask) - 1);
+		check((int32_t)v);
+
+		/* a range crossing zero, and one within a single sign */
+		v = rnd32();
+		check_range(-(int32_t)(v & mask) - 1, (int32_t)(rnd32() & mask));
+		v = rnd32() & mask;
+		check_range((int32_t)(v & (v >> 1)), (int32_t)v);
+		check_range(-(int32_t)v - 1, -(int32_t)(v & (v >> 1)) - 1);
+	}
+
+	check_walk();
+
+	/* limits */
+	check(INT32_MIN);
+	check(INT32_MAX);
+	check(0);
+	check(-1);
+	check_range(INT32_MIN, INT32_MAX);
+	check_range(INT32_MIN, -1);
+	check_range(-1, 0);
+	check_range(0, INT32_MAX);
+
+	if (debug)
+		cebu32i_default_dump(&ceb_root, orig_argv, 0);
+	return 0;
+}
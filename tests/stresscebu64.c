@@ -57,13 +57,68 @@ static uint64_t rnd64()
 	return ((uint64_t)rnd32() << 32) + rnd32();
 }
 
+/* visits all nodes by ascending XOR distance to <v>, verifying that distances
+ * strictly grow, that the nearest one was found and that all nodes are
+ * visited. Aborts on error.
+ */
+static void check_xor(uint64_t v)
+{
+	struct ceb_node *node;
+	uint64_t best = ~0ULL, d, prev = 0;
+	int n, total = 0;
+
+	for (node = cebu64_first(&ceb_root); node; node = cebu64_next(&ceb_root, node), total++) {
+		d = container_of(node, struct key, node)->key ^ v;
+		if (d < best)
+			best = d;
+	}
+
+	for (n = 0, node = cebu64_lookup_xor_nearest(&ceb_root, v); node; node = cebu64_lookup_xor_next(&ceb_root, v, node), n++) {
+		d = container_of(node, struct key, node)->key ^ v;
+		if ((!n && d != best) || (n && d <= prev)) {
+			printf("xor walk to %#llx: node %d at distance %#llx after %#llx (best %#llx)\n",
+			       (unsigned long long)v, n, (unsigned long long)d, (unsigned long long)prev, (unsigned long long)best);
+			abort();
+		}
+		prev = d;
+	}
+
+	if (n != total) {
+		printf("xor walk to %#llx found %d nodes instead of %d\n", (unsigned long long)v, n, total);
+		abort();
+	}
+}
+
+/* counts the nodes between <lo> and <hi> by walking the whole tree, and
+ * verifies that the estimate matches it when all levels are counted. Aborts
+ * on error.
+ */
+static void check_count(uint64_t lo, uint64_t hi)
+{
+	struct ceb_node *node;
+	uint64_t k;
+	size_t n = 0, est;
+
+	for (node = cebu64_first(&ceb_root); node; node = cebu64_next(&ceb_root, node)) {
+		k = container_of(node, struct key, node)->key;
+		n += k >= lo && k <= hi;
+	}
+
+	est = cebu64_count_estimate(&ceb_root, lo, hi, ~0U);
+	if (est != n) {
+		printf("count in [%#llx, %#llx] estimated to %lu instead of %lu\n",
+		       (unsigned long long)lo, (unsigned long long)hi, (unsigned long)est, (unsigned long)n);
+		abort();
+	}
+}
+
 int main(int argc, char **argv)
 {
 	struct ceb_node *old, *back __attribute__((unused));
 	char *orig_argv, *argv0 = *argv, *larg;
 	struct key *key;
 	char *p;
-	uint64_t v;
+	uint64_t v, lo, hi;
 	int test = 0;
 	uint64_t mask = ~0ULL;
 	int count = 10;
@@ -185,6 +240,49 @@ int main(int argc, char **argv)
 				round++;
 			}
 		}
+	} else if (test == 3) {
+		/* random inserts and deletes, checking XOR walks in between */
+		while (count--) {
+			v = rnd64() & mask;
+			old = cebu64_lookup(&ceb_root, v);
+			if (old) {
+				if (cebu64_delete(&ceb_root, old) != old)
+					abort();
+				free(container_of(old, struct key, node));
+			}
+			else {
+				key = calloc(1, sizeof(*key));
+				key->key = v;
+				old = cebu64_insert(&ceb_root, &key->node);
+				if (old != &key->node)
+					abort();
+			}
+			check_xor(rnd64() & mask);
+			check_xor(v);
+		}
+	} else if (test == 4) {
+		/* random inserts and deletes, checking exact range counts */
+		while (count--) {
+			v = rnd64() & mask;
+			old = cebu64_lookup(&ceb_root, v);
+			if (old) {
+				if (cebu64_delete(&ceb_root, old) != old)
+					abort();
+				free(container_of(old, struct key, node));
+			}
+			else {
+				key = calloc(1, sizeof(*key));
+				key->key = v;
+				old = cebu64_insert(&ceb_root, &key->node);
+				if (old != &key->node)
+					abort();
+			}
+			lo = rnd64() & mask;
+			hi = rnd64() & mask;
+			check_count(lo < hi ? lo : hi, lo < hi ? hi : lo);
+			check_count(v, v);
+			check_count(0, v);
+		}
 	}
 
 	if (debug == 1)
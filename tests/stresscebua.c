@@ -0,0 +1,181 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebua_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+/* nodes are taken from a contiguous array so that the key location (right
+ * after the node) is the next node's address, which differs from the node's
+ * own address by carries on many bits.
+ */
+#define NODES 4096
+
+static struct ceb_node *arena;
+static char used[NODES];
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* compares the result of all lookups around address <ptr> with the expected
+ * ones calculated from the used slots. Aborts on error.
+ */
+static void check(const char *ptr)
+{
+	struct ceb_node *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	int i;
+
+	for (i = 0; i < NODES; i++) {
+		if (!used[i])
+			continue;
+		if ((char *)&arena[i] == ptr)
+			eq = &arena[i];
+		if ((char *)&arena[i] <= ptr)
+			le = &arena[i];
+		if ((char *)&arena[i] <  ptr)
+			lt = &arena[i];
+		if ((char *)&arena[i] >= ptr && !ge)
+			ge = &arena[i];
+		if ((char *)&arena[i] >  ptr && !gt)
+			gt = &arena[i];
+	}
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != exp) {						\
+			printf("%s(%p) returned %p instead of %p\n",	\
+			       name, ptr, n, exp);			\
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebua_lookup(&ceb_root, ptr),    eq);
+	CHECK("lookup_le", cebua_lookup_le(&ceb_root, ptr), le);
+	CHECK("lookup_lt", cebua_lookup_lt(&ceb_root, ptr), lt);
+	CHECK("lookup_ge", cebua_lookup_ge(&ceb_root, ptr), ge);
+	CHECK("lookup_gt", cebua_lookup_gt(&ceb_root, ptr), gt);
+#undef CHECK
+}
+
+/* walks the tree in both directions, verifying that nodes are ordered and
+ * that all of them are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebua_first(&ceb_root); node && n <= nb_keys; prev = node, node = cebua_next(&ceb_root, node), n++) {
+		if (prev && (uintptr_t)node <= (uintptr_t)prev) {
+			printf("%p after %p\n", node, prev);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebua_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebua_last(&ceb_root); node && n <= nb_keys; prev = node, node = cebua_prev(&ceb_root, node), n++) {
+		if (prev && (uintptr_t)node >= (uintptr_t)prev) {
+			printf("%p before %p\n", node, prev);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebua_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	char *p;
+	int count = 1000;
+	int debug = 0;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [seed]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	arena = calloc(NODES, sizeof(*arena));
+
+	/* random inserts and deletes, either by node or by address, each
+	 * followed by a full walk and lookups of a random address.
+	 */
+	while (count--) {
+		v = rnd32();
+		idx = (v >> 8) % NODES;
+		if (used[idx]) {
+			if (v & 1)
+				old = cebua_delete(&ceb_root, &arena[idx]);
+			else
+				old = cebua_pick(&ceb_root, &arena[idx]);
+
+			if (old != &arena[idx])
+				abort();
+			used[idx] = 0;
+			nb_keys--;
+		}
+		else {
+			old = cebua_insert(&ceb_root, &arena[idx]);
+			if (old != &arena[idx])
+				abort();
+			used[idx] = 1;
+			nb_keys++;
+		}
+
+		check((char *)arena + rnd32() % (NODES * sizeof(*arena)));
+		check_walk();
+	}
+
+	if (debug)
+		cebua_default_dump(&ceb_root, orig_argv, 0);
+
+	/* limits */
+	check((char *)arena - 1);
+	check((char *)arena);
+	check((char *)(arena + NODES));
+	return 0;
+}
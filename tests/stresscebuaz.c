@@ -0,0 +1,182 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebuaz_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+/* the object starts with the node, immediately followed by its size */
+struct key {
+	struct ceb_node node;
+	size_t size;
+};
+
+/* objects are placed in slots of this size in the arena, at a random offset
+ * and with a random size not crossing the slot's end, so that they never
+ * overlap.
+ */
+#define SLOT 256
+#define SLOTS 4096
+
+static char *arena;
+static char used[SLOTS];
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* compares the result of the containment lookup of address <ptr> with the
+ * expected one calculated from the list of keys. Aborts on error.
+ */
+static void check(const char *ptr)
+{
+	struct key *exp = NULL;
+	struct ceb_node *n;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		if (ptr >= (char *)keys[i] && ptr < (char *)keys[i] + keys[i]->size)
+			exp = keys[i];
+	}
+
+	n = cebuaz_lookup_contains(&ceb_root, ptr);
+	if (n != (exp ? &exp->node : NULL)) {
+		printf("lookup_contains(%p) returned %p instead of %p\n",
+		       ptr, n, exp ? &exp->node : NULL);
+		abort();
+	}
+}
+
+/* walks the tree in both directions, verifying that nodes are ordered and
+ * that all of them are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebuaz_first(&ceb_root); node; prev = node, node = cebuaz_next(&ceb_root, node), n++) {
+		if (prev && (uintptr_t)node <= (uintptr_t)prev) {
+			printf("%p after %p\n", node, prev);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebuaz_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebuaz_last(&ceb_root); node; prev = node, node = cebuaz_prev(&ceb_root, node), n++)
+		;
+
+	if (n != nb_keys || prev != cebuaz_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	int count = 1000;
+	int debug = 0;
+	uint32_t v, ofs;
+	int idx, slot;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [seed]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	arena = calloc(SLOTS, SLOT);
+	keys = calloc(SLOTS, sizeof(*keys));
+
+	/* random inserts and deletes, either by node or by address */
+	while (count--) {
+		v = rnd32();
+		slot = (v >> 8) % SLOTS;
+		if (used[slot]) {
+			for (idx = 0; (char *)keys[idx] - arena < slot * SLOT ||
+				     (char *)keys[idx] - arena >= (slot + 1) * SLOT; idx++)
+				;
+			key = keys[idx];
+			if (v & 1)
+				old = cebuaz_delete(&ceb_root, &key->node);
+			else
+				old = cebuaz_pick(&ceb_root, key);
+
+			if (old != &key->node)
+				abort();
+
+			/* the node is not in the tree anymore */
+			if (cebuaz_lookup(&ceb_root, key))
+				abort();
+
+			keys[idx] = keys[--nb_keys];
+			used[slot] = 0;
+		}
+		else {
+			ofs = rnd32() % (SLOT - sizeof(*key)) & -sizeof(void *);
+			key = (struct key *)(arena + slot * SLOT + ofs);
+			key->size = sizeof(*key) + rnd32() % (SLOT - sizeof(*key) - ofs + 1);
+			old = cebuaz_insert(&ceb_root, &key->node);
+			if (old != &key->node)
+				abort();
+			keys[nb_keys++] = key;
+			used[slot] = 1;
+		}
+
+		check(arena + rnd32() % (SLOTS * SLOT));
+	}
+
+	check_walk();
+
+	if (debug)
+		cebuaz_default_dump(&ceb_root, orig_argv, 0);
+
+	/* limits */
+	check(arena - 1);
+	check(arena);
+	check(arena + SLOTS * SLOT);
+	return 0;
+}
@@ -0,0 +1,377 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebub_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+/* the key is a 32-bit big endian word stored as a 4-byte block */
+struct key {
+	struct ceb_node node;
+	unsigned char key[4];
+};
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+/* 256-bit keys, long enough to build a tree deeper than what iterators keep
+ * track of. Each of them has a single bit set, or none.
+ */
+#define LKEYS 257
+struct ceb_node *ceb_lroot = NULL;
+
+struct lkey {
+	struct ceb_node node;
+	unsigned char key[32];
+};
+
+/* the long keys present in the tree, indexed by their bit plus one */
+struct lkey *lkeys[LKEYS];
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* stores <v> as a big endian block at <blk> */
+static void blkset(unsigned char *blk, uint32_t v)
+{
+	blk[0] = v >> 24; blk[1] = v >> 16; blk[2] = v >> 8; blk[3] = v;
+}
+
+/* returns the block at <blk> as a 32-bit word */
+static uint32_t blkget(const unsigned char *blk)
+{
+	return ((uint32_t)blk[0] << 24) + ((uint32_t)blk[1] << 16) + ((uint32_t)blk[2] << 8) + blk[3];
+}
+
+/* returns the key of node <node> or "-" if NULL, in a static buffer */
+static const char *kstr(const struct ceb_node *node)
+{
+	static char buf[2][16];
+	static int idx;
+
+	idx ^= 1;
+	if (!node)
+		return "-";
+	snprintf(buf[idx], sizeof(buf[idx]), "%#x", blkget(container_of(node, struct key, node)->key));
+	return buf[idx];
+}
+
+/* range deletion callback: the node must have been marked as deleted. It's
+ * removed from the keys and released.
+ */
+static void free_cb(struct ceb_node *node, void *arg)
+{
+	int idx;
+
+	if (node->b[0]) {
+		printf("range deletion passed node %s still marked in the tree\n", kstr(node));
+		abort();
+	}
+
+	for (idx = 0; idx < nb_keys && &keys[idx]->node != node; idx++)
+		;
+	if (idx == nb_keys) {
+		printf("range deletion passed unknown node %s\n", kstr(node));
+		abort();
+	}
+	free(keys[idx]);
+	keys[idx] = keys[--nb_keys];
+}
+
+/* compares the result of all range lookups around <v> with the expected ones
+ * calculated from the list of keys. Aborts on error.
+ */
+static void check(uint32_t v)
+{
+	struct key *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	unsigned char blk[4];
+	uint32_t k;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		k = blkget(keys[i]->key);
+
+		if (k == v)
+			eq = keys[i];
+		if (k <= v && (!le || k > blkget(le->key)))
+			le = keys[i];
+		if (k <  v && (!lt || k > blkget(lt->key)))
+			lt = keys[i];
+		if (k >= v && (!ge || k < blkget(ge->key)))
+			ge = keys[i];
+		if (k >  v && (!gt || k < blkget(gt->key)))
+			gt = keys[i];
+	}
+
+	blkset(blk, v);
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->node : NULL)) {			\
+			printf("%s(%#x) returned %s instead of %s\n",	\
+			       name, v, kstr(n), kstr(exp ? &exp->node : NULL)); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebub_lookup(&ceb_root, blk, 4),    eq);
+	CHECK("lookup_le", cebub_lookup_le(&ceb_root, blk, 4), le);
+	CHECK("lookup_lt", cebub_lookup_lt(&ceb_root, blk, 4), lt);
+	CHECK("lookup_ge", cebub_lookup_ge(&ceb_root, blk, 4), ge);
+	CHECK("lookup_gt", cebub_lookup_gt(&ceb_root, blk, 4), gt);
+#undef CHECK
+}
+
+/* walks the whole tree in both directions, verifying that keys are ordered
+ * and that all nodes are visited. Aborts on error. The walks start from range
+ * lookups of the limits since first/last are not given any key length.
+ */
+static void check_walk(void)
+{
+	const unsigned char lo[4] = { 0, 0, 0, 0 };
+	const unsigned char hi[4] = { 0xff, 0xff, 0xff, 0xff };
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebub_lookup_ge(&ceb_root, lo, 4); node && n <= nb_keys; prev = node, node = cebub_next(&ceb_root, node, 4), n++) {
+		if (prev && memcmp(container_of(prev, struct key, node)->key, container_of(node, struct key, node)->key, 4) >= 0) {
+			printf("key %s after %s\n", kstr(node), kstr(prev));
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebub_lookup_le(&ceb_root, hi, 4)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebub_lookup_le(&ceb_root, hi, 4); node && n <= nb_keys; prev = node, node = cebub_prev(&ceb_root, node, 4), n++) {
+		if (prev && memcmp(container_of(prev, struct key, node)->key, container_of(node, struct key, node)->key, 4) <= 0) {
+			printf("key %s before %s\n", kstr(node), kstr(prev));
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebub_lookup_ge(&ceb_root, lo, 4)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+/* returns the key of node <node>, which is <len> bytes long */
+static const unsigned char *nkey(const struct ceb_node *node, size_t len)
+{
+	if (len == 4)
+		return container_of(node, struct key, node)->key;
+	return container_of(node, struct lkey, node)->key;
+}
+
+/* fills <blk> with a random key of <len> bytes, limited to <mask> for 4-byte
+ * keys, and made of a single random bit or none for longer ones.
+ */
+static void rndblk(unsigned char *blk, size_t len, uint32_t mask)
+{
+	uint32_t bit;
+
+	if (len == 4) {
+		blkset(blk, rnd32() & mask);
+		return;
+	}
+	memset(blk, 0, len);
+	bit = rnd32() % (len * 8 + 1);
+	if (bit)
+		blk[(bit - 1) / 8] = 0x80 >> ((bit - 1) % 8);
+}
+
+/* steps iterator <iter> over tree <root> of <len>-byte keys forwards or
+ * backwards from the node of key <cur>, or from off the tree if <*on> is zero,
+ * and compares the result with the equivalent lookups unless the iterator
+ * became stale, in which case it's repositioned using a seek. <cur> and <*on>
+ * are updated. Aborts on error.
+ */
+static void check_iter(struct ceb_node **root, struct ceb_iter *iter, unsigned char *cur, int *on, int back, size_t len, uint32_t mask)
+{
+	static const unsigned char lo[32], hi[32] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	};
+	struct ceb_node *ret, *exp;
+
+	ret = back ? cebub_iter_prev(iter, len) : cebub_iter_next(iter, len);
+	if (ceb_iter_stale(iter)) {
+		rndblk(cur, len, mask);
+		ret = cebub_iter_seek(iter, cur, len);
+		exp = cebub_lookup_ge(root, cur, len);
+	}
+	else if (!*on)
+		exp = back ? cebub_lookup_le(root, hi, len) : cebub_lookup_ge(root, lo, len);
+	else
+		exp = back ? cebub_lookup_lt(root, cur, len) : cebub_lookup_gt(root, cur, len);
+
+	if (ret != exp) {
+		printf("iter %s over %zu-byte keys (%s) returned %p instead of %p\n", back ? "prev" : "next",
+		       len, *on ? "on" : "off", ret, exp);
+		abort();
+	}
+
+	*on = !!ret;
+	if (ret)
+		memcpy(cur, nkey(ret, len), len);
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	struct ceb_iter iter;
+	struct key *key;
+	struct lkey *lkey;
+	unsigned char blo[4], bhi[4], cur[32];
+	uint32_t mask = 0xff0ff;
+	int count = 1000;
+	uint32_t v, lo, hi;
+	size_t cnt;
+	int idx, on;
+	int steps;
+
+	if (argc > 1 && **(argv + 1) == '-') {
+		printf("Usage: %s [cnt [mask [seed]]]\n", argv[0]);
+		exit(1);
+	}
+
+	if (argc > 1)
+		count = atoi(argv[1]);
+
+	if (argc > 2)
+		mask = strtoul(argv[2], NULL, 0);
+
+	if (argc > 3)
+		rnd32seed = atol(argv[3]);
+
+	keys = calloc(count, sizeof(*keys));
+	steps = count;
+
+	/* random inserts and deletes, each followed by range lookups of a
+	 * random key, which is mostly absent. One delete out of 4 removes a
+	 * range of keys starting at the node's key instead.
+	 */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0 && (v & 0xc00) == 0) {
+			/* range delete */
+			lo = blkget(keys[(v >> 12) % nb_keys]->key);
+			hi = lo + ((v >> 20) & 0xfff);
+			if (hi < lo)
+				hi = ~0U;
+			blkset(blo, lo);
+			blkset(bhi, hi);
+
+			for (cnt = idx = 0; idx < nb_keys; idx++)
+				cnt += blkget(keys[idx]->key) >= lo && blkget(keys[idx]->key) <= hi;
+
+			if (cebub_count_range(&ceb_root, blo, bhi, 4) != cnt ||
+			    cebub_delete_range(&ceb_root, blo, bhi, free_cb, NULL, 4) != cnt ||
+			    cebub_count_range(&ceb_root, blo, bhi, 4)) {
+				printf("range %#x-%#x: failed to delete %lu keys\n", lo, hi, (unsigned long)cnt);
+				abort();
+			}
+		}
+		else if (nb_keys && (v & 0x300) == 0) {
+			/* delete */
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			old = cebub_pick(&ceb_root, key->key, 4);
+			if (old != &key->node)
+				abort();
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			blkset(key->key, rnd32() & mask);
+			old = cebub_insert(&ceb_root, &key->node, 4);
+			if (old == &key->node)
+				keys[nb_keys++] = key;
+			else
+				free(key);
+		}
+
+		check(rnd32() & mask);
+		check(rnd32());
+	}
+
+	check_walk();
+
+	/* limits */
+	check(0);
+	check(~0U);
+
+	/* random inserts and deletes while an iterator moves back and forth.
+	 * Removed nodes are not freed since the iterator may still reference
+	 * them.
+	 */
+	keys = realloc(keys, (nb_keys + steps) * sizeof(*keys));
+	cebub_iter_init(&iter, &ceb_root);
+	on = 0;
+	for (count = steps; count--; ) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			idx = (v >> 12) % nb_keys;
+			if (cebub_delete(&ceb_root, &keys[idx]->node, 4) != &keys[idx]->node)
+				abort();
+			keys[idx] = keys[--nb_keys];
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			blkset(key->key, rnd32() & mask);
+			if (cebub_insert(&ceb_root, &key->node, 4) == &key->node)
+				keys[nb_keys++] = key;
+			else
+				free(key);
+		}
+		check_iter(&ceb_root, &iter, cur, &on, rnd32() & 1, 4, mask);
+		check_iter(&ceb_root, &iter, cur, &on, rnd32() & 1, 4, mask);
+	}
+	check_walk();
+
+	/* same with the long keys, most of which are present so that the tree
+	 * remains deeper than the iterator's path and it has to step using key
+	 * lookups.
+	 */
+	cebub_iter_init(&iter, &ceb_lroot);
+	on = 0;
+	for (count = steps; count--; ) {
+		v = rnd32();
+		idx = (v >> 12) % LKEYS;
+		if (lkeys[idx] && (v & 0x300) == 0) {
+			if (cebub_delete(&ceb_lroot, &lkeys[idx]->node, 32) != &lkeys[idx]->node)
+				abort();
+			lkeys[idx] = NULL;
+		}
+		else if (!lkeys[idx]) {
+			lkey = calloc(1, sizeof(*lkey));
+			if (idx)
+				lkey->key[(idx - 1) / 8] = 0x80 >> ((idx - 1) % 8);
+			if (cebub_insert(&ceb_lroot, &lkey->node, 32) != &lkey->node)
+				abort();
+			lkeys[idx] = lkey;
+		}
+		check_iter(&ceb_lroot, &iter, cur, &on, rnd32() & 1, 32, mask);
+		check_iter(&ceb_lroot, &iter, cur, &on, rnd32() & 1, 32, mask);
+	}
+	return 0;
+}
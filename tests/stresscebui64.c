@@ -0,0 +1,225 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebui32_tree.h"
+#include "cebui64_tree.h"
+
+struct ceb_node *ceb_root64 = NULL;
+struct ceb_node *ceb_root32 = NULL;
+
+/* the keys are stored in a separately allocated structure */
+struct data {
+	uint64_t id;
+	uint32_t port;
+};
+
+/* an object indexed by both keys of its data, each node being followed by a
+ * pointer to the key.
+ */
+struct obj {
+	struct ceb_node by_id;
+	const uint64_t *id;
+	struct ceb_node by_port;
+	const uint32_t *port;
+	struct data *data;
+};
+
+/* offset of the port pointer relative to its node */
+#define KOFS32 (offsetof(struct obj, port) - offsetof(struct obj, by_port))
+
+/* all objects present in the 64-bit tree, unsorted */
+struct obj **objs;
+int nb_objs;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns non-zero if object <obj> is in the 32-bit tree */
+static int in32(const struct obj *obj)
+{
+	return cebui32_ofs_lookup(&ceb_root32, KOFS32, *obj->port) == &obj->by_port;
+}
+
+/* compares the result of all lookups around <v> in both trees with the
+ * expected ones calculated from the list of objects. Aborts on error.
+ */
+static void check(uint64_t v)
+{
+	struct obj *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	struct obj *le32 = NULL, *ge32 = NULL;
+	uint32_t v32 = v;
+	int i;
+
+	for (i = 0; i < nb_objs; i++) {
+		struct obj *o = objs[i];
+
+		if (o->data->id == v)
+			eq = o;
+		if (o->data->id <= v && (!le || o->data->id > le->data->id))
+			le = o;
+		if (o->data->id <  v && (!lt || o->data->id > lt->data->id))
+			lt = o;
+		if (o->data->id >= v && (!ge || o->data->id < ge->data->id))
+			ge = o;
+		if (o->data->id >  v && (!gt || o->data->id < gt->data->id))
+			gt = o;
+
+		if (!in32(o))
+			continue;
+		if (o->data->port <= v32 && (!le32 || o->data->port > le32->data->port))
+			le32 = o;
+		if (o->data->port >= v32 && (!ge32 || o->data->port < ge32->data->port))
+			ge32 = o;
+	}
+
+#define CHECK(name, res, exp, field) do {				\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->field : NULL)) {			\
+			printf("%s(%llu) returned %p instead of %p\n",	\
+			       name, (unsigned long long)v, n, exp ? &exp->field : NULL); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("cebui64_lookup",    cebui64_lookup(&ceb_root64, v),    eq, by_id);
+	CHECK("cebui64_lookup_le", cebui64_lookup_le(&ceb_root64, v), le, by_id);
+	CHECK("cebui64_lookup_lt", cebui64_lookup_lt(&ceb_root64, v), lt, by_id);
+	CHECK("cebui64_lookup_ge", cebui64_lookup_ge(&ceb_root64, v), ge, by_id);
+	CHECK("cebui64_lookup_gt", cebui64_lookup_gt(&ceb_root64, v), gt, by_id);
+	CHECK("cebui32_lookup_le", cebui32_ofs_lookup_le(&ceb_root32, KOFS32, v32), le32, by_port);
+	CHECK("cebui32_lookup_ge", cebui32_ofs_lookup_ge(&ceb_root32, KOFS32, v32), ge32, by_port);
+#undef CHECK
+}
+
+/* walks the 64-bit tree in both directions, verifying that keys are ordered
+ * and that all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebui64_first(&ceb_root64); node; prev = node, node = cebui64_next(&ceb_root64, node), n++) {
+		if (prev && *container_of(prev, struct obj, by_id)->id >= *container_of(node, struct obj, by_id)->id) {
+			printf("key %llu after %llu\n",
+			       (unsigned long long)*container_of(node, struct obj, by_id)->id,
+			       (unsigned long long)*container_of(prev, struct obj, by_id)->id);
+			abort();
+		}
+	}
+
+	if (n != nb_objs || prev != cebui64_last(&ceb_root64)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_objs);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebui64_last(&ceb_root64); node; prev = node, node = cebui64_prev(&ceb_root64, node), n++)
+		;
+
+	if (n != nb_objs || prev != cebui64_first(&ceb_root64)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_objs);
+		abort();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct obj *obj;
+	char *p;
+	uint64_t mask = 0xffff;
+	int count = 1000;
+	int debug = 0;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = strtoull(larg = *(argv++), NULL, 0);
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	objs = calloc(count, sizeof(*objs));
+
+	/* random inserts and deletes */
+	while (count--) {
+		v = rnd32();
+		if (nb_objs && (v & 0x300) == 0) {
+			/* delete */
+			idx = (v >> 12) % nb_objs;
+			obj = objs[idx];
+			if (in32(obj) && cebui32_ofs_delete(&ceb_root32, KOFS32, &obj->by_port) != &obj->by_port)
+				abort();
+			if (cebui64_pick(&ceb_root64, obj->data->id) != &obj->by_id)
+				abort();
+			objs[idx] = objs[--nb_objs];
+			free(obj->data);
+			free(obj);
+		}
+		else {
+			obj = calloc(1, sizeof(*obj));
+			obj->data = calloc(1, sizeof(*obj->data));
+			obj->data->id = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+			obj->data->port = rnd32() & mask;
+			obj->id = &obj->data->id;
+			obj->port = &obj->data->port;
+			old = cebui64_insert(&ceb_root64, &obj->by_id);
+			if (old == &obj->by_id) {
+				objs[nb_objs++] = obj;
+				cebui32_ofs_insert(&ceb_root32, KOFS32, &obj->by_port);
+			}
+			else {
+				free(obj->data);
+				free(obj);
+			}
+		}
+
+		check((((uint64_t)rnd32() << 32) + rnd32()) & mask);
+	}
+
+	check_walk();
+
+	/* limits */
+	check(0);
+	check(~0ULL);
+
+	if (debug)
+		cebui64_default_dump(&ceb_root64, orig_argv, 0);
+	return 0;
+}
@@ -0,0 +1,221 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebup32_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+/* the network immediately follows the node, then its prefix length */
+struct key {
+	struct ceb_node node;
+	uint32_t net;
+	uint32_t plen;
+};
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns bit <pos> of prefix <net>/<plen> followed by a one */
+static int pfxbit(uint32_t net, uint32_t plen, uint32_t pos)
+{
+	if (pos < plen)
+		return (net >> (31 - pos)) & 1;
+	return pos == plen;
+}
+
+/* reference comparison, bit by bit */
+static int pfxcmp(uint32_t anet, uint32_t alen, uint32_t bnet, uint32_t blen)
+{
+	uint32_t pos;
+	int c;
+
+	for (pos = 0; pos <= alen || pos <= blen; pos++) {
+		c = pfxbit(anet, alen, pos) - pfxbit(bnet, blen, pos);
+		if (c)
+			return c;
+	}
+	return 0;
+}
+
+/* returns non-zero if prefix <net>/<plen> matches address <addr> */
+static int pfxmatch(uint32_t net, uint32_t plen, uint32_t addr)
+{
+	return !plen || !((net ^ addr) >> (32 - plen));
+}
+
+/* compares the result of the exact and longest match lookups of address
+ * <addr> with the expected ones calculated from the list of keys. Aborts on
+ * error.
+ */
+static void check(uint32_t addr)
+{
+	struct key *eq = NULL, *lpm = NULL;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		struct key *k = keys[i];
+
+		if (pfxcmp(k->net, k->plen, addr, 32) == 0)
+			eq = k;
+		if (pfxmatch(k->net, k->plen, addr) && (!lpm || k->plen > lpm->plen))
+			lpm = k;
+	}
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->node : NULL)) {			\
+			printf("%s(%#x) returned %p instead of %p\n",	\
+			       name, addr, n, exp ? &exp->node : NULL);	\
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup_prefix",  cebup32_lookup_prefix(&ceb_root, addr, 32), eq);
+	CHECK("lookup_longest", cebup32_lookup_longest(&ceb_root, addr),     lpm);
+#undef CHECK
+}
+
+/* walks the tree in both directions, verifying that keys are ordered and that
+ * all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	struct key *k1, *k2;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebup32_first(&ceb_root); node; prev = node, node = cebup32_next(&ceb_root, node), n++) {
+		if (!prev)
+			continue;
+		k1 = container_of(prev, struct key, node);
+		k2 = container_of(node, struct key, node);
+		if (pfxcmp(k1->net, k1->plen, k2->net, k2->plen) >= 0) {
+			printf("%#x/%u after %#x/%u\n", k2->net, k2->plen, k1->net, k1->plen);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebup32_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebup32_last(&ceb_root); node; prev = node, node = cebup32_prev(&ceb_root, node), n++)
+		;
+
+	if (n != nb_keys || prev != cebup32_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct key *key;
+	char *p;
+	uint32_t mask = 0xc3c3c3c3;
+	int count = 1000;
+	int debug = 0;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = strtoul(larg = *(argv++), NULL, 0);
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* random inserts and deletes, either by node or by prefix. Networks
+	 * keep random bits past their prefix length as they must be ignored.
+	 */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (v & 0x1000)
+				old = cebup32_delete(&ceb_root, &key->node);
+			else
+				old = cebup32_pick_prefix(&ceb_root, key->net, key->plen);
+
+			if (old != &key->node)
+				abort();
+
+			/* the node is not in the tree anymore */
+			if (cebup32_lookup_prefix(&ceb_root, key->net, key->plen))
+				abort();
+
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			key = calloc(1, sizeof(*key));
+			key->net = rnd32() & mask;
+			key->plen = rnd32() % 33;
+			old = cebup32_insert(&ceb_root, &key->node);
+			if (old == &key->node)
+				keys[nb_keys++] = key;
+			else if (!old || pfxcmp(container_of(old, struct key, node)->net,
+						container_of(old, struct key, node)->plen,
+						key->net, key->plen) != 0)
+				abort();
+			else
+				free(key);
+		}
+
+		check(rnd32() & mask);
+	}
+
+	check_walk();
+
+	if (debug)
+		cebup32_default_dump(&ceb_root, orig_argv, 0);
+
+	/* limits */
+	check(0);
+	check(~0U);
+	return 0;
+}
@@ -0,0 +1,289 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebupb_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+/* the prefix length in bits immediately follows the node, then the prefix */
+struct key {
+	struct ceb_node node;
+	uint32_t plen;
+	unsigned char data[0];
+};
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* fills <buf> with <maxbits> random bits made of bytes from 0 to <mask> so
+ * that many prefixes cover other ones, and returns a random length of up to
+ * <maxbits>. Bits past the returned length are left random as they must be
+ * ignored.
+ */
+static size_t rndpfx(unsigned char *buf, size_t maxbits, uint32_t mask)
+{
+	size_t i;
+
+	for (i = 0; i < (maxbits + 7) / 8; i++)
+		buf[i] = rnd32() & mask;
+	return rnd32() % (maxbits + 1);
+}
+
+/* returns bit <pos> of prefix <a> of <len> bits followed by a one */
+static int pfxbit(const unsigned char *a, size_t len, size_t pos)
+{
+	if (pos < len)
+		return (a[pos / 8] >> (7 - pos % 8)) & 1;
+	return pos == len;
+}
+
+/* reference comparison, bit by bit */
+static int pfxcmp(const unsigned char *a, size_t alen, const unsigned char *b, size_t blen)
+{
+	size_t pos;
+	int c;
+
+	for (pos = 0; pos <= alen || pos <= blen; pos++) {
+		c = pfxbit(a, alen, pos) - pfxbit(b, blen, pos);
+		if (c)
+			return c;
+	}
+	return 0;
+}
+
+/* returns non-zero if prefix <a> of <alen> bits matches address <v> of <len>
+ * bits.
+ */
+static int pfxmatch(const unsigned char *a, size_t alen, const unsigned char *v, size_t len)
+{
+	size_t pos;
+
+	if (alen > len)
+		return 0;
+
+	for (pos = 0; pos < alen; pos++) {
+		if (pfxbit(a, alen, pos) != pfxbit(v, len, pos))
+			return 0;
+	}
+	return 1;
+}
+
+/* compares the result of the exact and longest match lookups of address <v>
+ * of <len> bits with the expected ones calculated from the list of keys.
+ * Aborts on error.
+ */
+static void check(const unsigned char *v, size_t len)
+{
+	struct key *eq = NULL, *lpm = NULL;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		struct key *k = keys[i];
+
+		if (pfxcmp(k->data, k->plen, v, len) == 0)
+			eq = k;
+		if (pfxmatch(k->data, k->plen, v, len) && (!lpm || k->plen > lpm->plen))
+			lpm = k;
+	}
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->node : NULL)) {			\
+			printf("%s(len=%u) returned %p instead of %p\n",\
+			       name, (unsigned)len, n, exp ? &exp->node : NULL); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup_prefix",  cebupb_lookup_prefix(&ceb_root, v, len),  eq);
+	CHECK("lookup_longest", cebupb_lookup_longest(&ceb_root, v, len), lpm);
+#undef CHECK
+}
+
+/* state of a walk: the node expected next and the one to stop on */
+struct walk_ctx {
+	struct ceb_node *exp;
+	struct ceb_node *stop;
+};
+
+/* walk callback verifying that nodes are visited in the same order as with
+ * first/next. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (node != ctx->exp) {
+		printf("walk visited %p instead of %p\n", node, ctx->exp);
+		abort();
+	}
+	ctx->exp = cebupb_next(&ceb_root, node);
+	return node == ctx->stop;
+}
+
+/* walks the tree in both directions, verifying that keys are ordered and that
+ * all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct walk_ctx ctx;
+	struct ceb_node *node, *prev;
+	struct key *k1, *k2;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebupb_first(&ceb_root); node; prev = node, node = cebupb_next(&ceb_root, node), n++) {
+		if (!prev)
+			continue;
+		k1 = container_of(prev, struct key, node);
+		k2 = container_of(node, struct key, node);
+		if (pfxcmp(k1->data, k1->plen, k2->data, k2->plen) >= 0) {
+			printf("prefix of len %u after prefix of len %u\n", k2->plen, k1->plen);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebupb_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebupb_last(&ceb_root); node; prev = node, node = cebupb_prev(&ceb_root, node), n++)
+		;
+
+	if (n != nb_keys || prev != cebupb_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	/* full walk, then one stopping on a node in the middle */
+	ctx.exp = cebupb_first(&ceb_root);
+	ctx.stop = NULL;
+	if (cebupb_walk(&ceb_root, walk_cb, &ctx) || ctx.exp) {
+		printf("walk stopped before the end\n");
+		abort();
+	}
+
+	if (nb_keys) {
+		ctx.exp = cebupb_first(&ceb_root);
+		ctx.stop = &keys[nb_keys / 2]->node;
+		if (cebupb_walk(&ceb_root, walk_cb, &ctx) != ctx.stop) {
+			printf("walk didn't stop on the requested node\n");
+			abort();
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	unsigned char buf[64];
+	struct key *key;
+	char *p;
+	uint32_t mask = 0xc3;
+	size_t maxbits = 24;
+	int count = 1000;
+	size_t len;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	if (argc && **argv == '-') {
+		printf("Usage: %s [cnt [maxbits [mask [seed]]]]\n", argv0);
+		exit(1);
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		maxbits = atoi(larg = *(argv++));
+
+	if (argc > 2)
+		mask = strtoul(larg = *(argv++), NULL, 0);
+
+	if (argc > 3)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	if (maxbits > sizeof(buf) * 8)
+		maxbits = sizeof(buf) * 8;
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* random inserts and deletes, either by node or by key */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (v & 0x1000)
+				old = cebupb_delete(&ceb_root, &key->node);
+			else
+				old = cebupb_pick_prefix(&ceb_root, key->data, key->plen);
+
+			if (old != &key->node)
+				abort();
+
+			/* the node is not in the tree anymore */
+			if (cebupb_lookup_prefix(&ceb_root, key->data, key->plen))
+				abort();
+
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			len = rndpfx(buf, maxbits, mask);
+			key = calloc(1, sizeof(*key) + (maxbits + 7) / 8);
+			key->plen = len;
+			memcpy(key->data, buf, (maxbits + 7) / 8);
+			old = cebupb_insert(&ceb_root, &key->node);
+			if (old == &key->node)
+				keys[nb_keys++] = key;
+			else if (!old || pfxcmp(container_of(old, struct key, node)->data,
+						container_of(old, struct key, node)->plen,
+						key->data, key->plen) != 0)
+				abort();
+			else
+				free(key);
+		}
+
+		/* addresses are mostly full length */
+		len = rndpfx(buf, maxbits, mask);
+		check(buf, (v & 0x3000) ? maxbits : len);
+	}
+
+	check_walk();
+
+	/* limits */
+	check(buf, 0);
+	memset(buf, 0xff, sizeof(buf));
+	check(buf, maxbits);
+	memset(buf, 0, sizeof(buf));
+	check(buf, maxbits);
+	return 0;
+}
@@ -0,0 +1,716 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebus_tree.h"
+#include "cebusi_tree.h"
+#include "cebuisi_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+struct ceb_node *ceb_iroot = NULL;
+struct ceb_node *ceb_sroot = NULL;
+
+/* the same string is indexed directly and indirectly, and also in a case
+ * sensitive tree.
+ */
+struct key {
+	struct ceb_node snode;
+	struct ceb_node inode;
+	const char *ptr;
+	struct ceb_node node;
+	char str[0];
+};
+
+/* offset of the pointer relative to the indirect node */
+#define IKOFS (offsetof(struct key, ptr) - offsetof(struct key, inode))
+
+/* offset of the string relative to the case sensitive node */
+#define SKOFS (offsetof(struct key, str) - offsetof(struct key, snode))
+
+/* all keys present in the trees, unsorted */
+struct key **keys;
+int nb_keys;
+
+/* characters used in keys, including those surrounding the letters */
+static const char alphabet[] = "aAbBzZ@[`{0";
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* fills <buf> with a random string of up to <maxlen> characters taken from
+ * the first <nbchr> ones of the alphabet.
+ */
+static void rndkey(char *buf, size_t maxlen, size_t nbchr)
+{
+	size_t len = rnd32() % (maxlen + 1);
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = alphabet[rnd32() % nbchr];
+	buf[i] = 0;
+}
+
+/* reference comparison: strcmp() on the lower case versions */
+static int keycmp(const char *a, const char *b)
+{
+	unsigned char c, d;
+
+	do {
+		c = *a++; d = *b++;
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		if (d >= 'A' && d <= 'Z')
+			d += 'a' - 'A';
+	} while (c && c == d);
+	return c - d;
+}
+
+/* compares the result of all lookups of <v> in all trees with the expected
+ * ones calculated from the list of keys, also passing <v> as a slice which is
+ * followed by other characters, or by a zero and other characters. Aborts on
+ * error.
+ */
+static void check(const char *v)
+{
+	struct key *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	struct key *sle = NULL, *sge = NULL, *seq = NULL;
+	size_t len = strlen(v);
+	char slice[300];
+	int i, c;
+
+	memcpy(slice, v, len);
+	strcpy(slice + len, "aZ{");
+
+	for (i = 0; i < nb_keys; i++) {
+		struct key *k = keys[i];
+
+		c = keycmp(k->str, v);
+		if (c == 0)
+			eq = k;
+		if (c <= 0 && (!le || keycmp(k->str, le->str) > 0))
+			le = k;
+		if (c <  0 && (!lt || keycmp(k->str, lt->str) > 0))
+			lt = k;
+		if (c >= 0 && (!ge || keycmp(k->str, ge->str) < 0))
+			ge = k;
+		if (c >  0 && (!gt || keycmp(k->str, gt->str) < 0))
+			gt = k;
+
+		/* case sensitive tree */
+		c = strcmp(k->str, v);
+		if (c == 0)
+			seq = k;
+		if (c <= 0 && (!sle || strcmp(k->str, sle->str) > 0))
+			sle = k;
+		if (c >= 0 && (!sge || strcmp(k->str, sge->str) < 0))
+			sge = k;
+	}
+
+#define CHECK(name, res, exp, field) do {				\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->field : NULL)) {			\
+			printf("%s(\"%s\") returned %p instead of %p\n",\
+			       name, v, n, exp ? &exp->field : NULL);	\
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("cebusi_lookup",     cebusi_lookup(&ceb_root, v),    eq, node);
+	CHECK("cebusi_lookup_le",  cebusi_lookup_le(&ceb_root, v), le, node);
+	CHECK("cebusi_lookup_lt",  cebusi_lookup_lt(&ceb_root, v), lt, node);
+	CHECK("cebusi_lookup_ge",  cebusi_lookup_ge(&ceb_root, v), ge, node);
+	CHECK("cebusi_lookup_gt",  cebusi_lookup_gt(&ceb_root, v), gt, node);
+	CHECK("cebuisi_lookup",    cebuisi_ofs_lookup(&ceb_iroot, IKOFS, v),    eq, inode);
+	CHECK("cebuisi_lookup_le", cebuisi_ofs_lookup_le(&ceb_iroot, IKOFS, v), le, inode);
+	CHECK("cebuisi_lookup_lt", cebuisi_ofs_lookup_lt(&ceb_iroot, IKOFS, v), lt, inode);
+	CHECK("cebuisi_lookup_ge", cebuisi_ofs_lookup_ge(&ceb_iroot, IKOFS, v), ge, inode);
+	CHECK("cebuisi_lookup_gt", cebuisi_ofs_lookup_gt(&ceb_iroot, IKOFS, v), gt, inode);
+
+	CHECK("cebusi_lookup_len",     cebusi_lookup_len(&ceb_root, slice, len),    eq, node);
+	CHECK("cebusi_lookup_le_len",  cebusi_lookup_le_len(&ceb_root, slice, len), le, node);
+	CHECK("cebusi_lookup_lt_len",  cebusi_lookup_lt_len(&ceb_root, slice, len), lt, node);
+	CHECK("cebusi_lookup_ge_len",  cebusi_lookup_ge_len(&ceb_root, slice, len), ge, node);
+	CHECK("cebusi_lookup_gt_len",  cebusi_lookup_gt_len(&ceb_root, slice, len), gt, node);
+	CHECK("cebuisi_lookup_len",    cebuisi_ofs_lookup_len(&ceb_iroot, IKOFS, slice, len),    eq, inode);
+	CHECK("cebuisi_lookup_le_len", cebuisi_ofs_lookup_le_len(&ceb_iroot, IKOFS, slice, len), le, inode);
+	CHECK("cebuisi_lookup_lt_len", cebuisi_ofs_lookup_lt_len(&ceb_iroot, IKOFS, slice, len), lt, inode);
+	CHECK("cebuisi_lookup_ge_len", cebuisi_ofs_lookup_ge_len(&ceb_iroot, IKOFS, slice, len), ge, inode);
+	CHECK("cebuisi_lookup_gt_len", cebuisi_ofs_lookup_gt_len(&ceb_iroot, IKOFS, slice, len), gt, inode);
+
+	CHECK("cebus_lookup",        cebus_ofs_lookup(&ceb_sroot, SKOFS, v),              seq, snode);
+	CHECK("cebus_lookup_le",     cebus_ofs_lookup_le(&ceb_sroot, SKOFS, v),           sle, snode);
+	CHECK("cebus_lookup_ge",     cebus_ofs_lookup_ge(&ceb_sroot, SKOFS, v),           sge, snode);
+	CHECK("cebus_lookup_len",    cebus_ofs_lookup_len(&ceb_sroot, SKOFS, slice, len),    seq, snode);
+	CHECK("cebus_lookup_le_len", cebus_ofs_lookup_le_len(&ceb_sroot, SKOFS, slice, len), sle, snode);
+	CHECK("cebus_lookup_ge_len", cebus_ofs_lookup_ge_len(&ceb_sroot, SKOFS, slice, len), sge, snode);
+
+	/* the slice ends at its first zero */
+	slice[len] = 0;
+	CHECK("cebus_lookup_len",    cebus_ofs_lookup_len(&ceb_sroot, SKOFS, slice, len + 3),    seq, snode);
+	CHECK("cebusi_lookup_gt_len", cebusi_lookup_gt_len(&ceb_root, slice, len + 3), gt, node);
+#undef CHECK
+}
+
+/* nodes visited by walk_prefix(), which stops after <max> of them */
+struct visit {
+	struct ceb_node **nodes;
+	int n, max;
+};
+
+static int visit_cb(struct ceb_node *node, void *arg)
+{
+	struct visit *vis = arg;
+
+	vis->nodes[vis->n++] = node;
+	return vis->n == vis->max;
+}
+
+/* returns non-zero if <str> starts with <pfx>, case-insensitively if <ci> */
+static int keypfx(const char *str, const char *pfx, int ci)
+{
+	size_t len = strlen(pfx);
+	char tmp[300];
+
+	if (strlen(str) < len)
+		return 0;
+	if (!ci)
+		return strncmp(str, pfx, len) == 0;
+	memcpy(tmp, str, len);
+	tmp[len] = 0;
+	return keycmp(tmp, pfx) == 0;
+}
+
+/* walks the keys starting with prefix <v> in all trees and compares them with
+ * the ones expected from the list of keys, then checks that the walk stops
+ * when the callback asks for it. Aborts on error.
+ */
+static void check_prefix(const char *v)
+{
+	struct ceb_node *ret;
+	struct visit vis;
+	struct key *k, *prev;
+	int exp_ci = 0, exp_cs = 0;
+	int i, t;
+
+	for (i = 0; i < nb_keys; i++) {
+		exp_ci += keypfx(keys[i]->str, v, 1);
+		exp_cs += keypfx(keys[i]->str, v, 0);
+	}
+
+	vis.nodes = calloc(nb_keys + 1, sizeof(*vis.nodes));
+	for (t = 0; t < 3; t++) {
+		int exp = t < 2 ? exp_ci : exp_cs;
+
+		vis.n = 0;
+		vis.max = nb_keys + 1;
+		if (t == 0)
+			ret = cebusi_walk_prefix(&ceb_root, v, visit_cb, &vis);
+		else if (t == 1)
+			ret = cebuisi_ofs_walk_prefix(&ceb_iroot, IKOFS, v, visit_cb, &vis);
+		else
+			ret = cebus_ofs_walk_prefix(&ceb_sroot, SKOFS, v, visit_cb, &vis);
+
+		if (ret || vis.n != exp) {
+			printf("walk_prefix(%d, \"%s\") visited %d nodes instead of %d\n", t, v, vis.n, exp);
+			abort();
+		}
+
+		for (prev = NULL, i = 0; i < vis.n; prev = k, i++) {
+			if (t == 0)
+				k = container_of(vis.nodes[i], struct key, node);
+			else if (t == 1)
+				k = container_of(vis.nodes[i], struct key, inode);
+			else
+				k = container_of(vis.nodes[i], struct key, snode);
+
+			if (!keypfx(k->str, v, t < 2) ||
+			    (prev && (t < 2 ? keycmp(prev->str, k->str) : strcmp(prev->str, k->str)) >= 0)) {
+				printf("walk_prefix(%d, \"%s\") visited \"%s\"\n", t, v, k->str);
+				abort();
+			}
+		}
+
+		/* stop on the second node */
+		if (exp >= 2) {
+			vis.n = 0;
+			vis.max = 2;
+			if (t == 0)
+				ret = cebusi_walk_prefix(&ceb_root, v, visit_cb, &vis);
+			else if (t == 1)
+				ret = cebuisi_ofs_walk_prefix(&ceb_iroot, IKOFS, v, visit_cb, &vis);
+			else
+				ret = cebus_ofs_walk_prefix(&ceb_sroot, SKOFS, v, visit_cb, &vis);
+			if (vis.n != 2 || ret != vis.nodes[1]) {
+				printf("walk_prefix(%d, \"%s\") didn't stop\n", t, v);
+				abort();
+			}
+		}
+	}
+	free(vis.nodes);
+}
+
+/* state of a walk: the node expected next, the one to stop on and the number
+ * of nodes visited.
+ */
+struct walk_ctx {
+	struct ceb_node *exp;
+	struct ceb_node *stop;
+	size_t visits;
+};
+
+/* walk callback verifying that nodes are visited in the same order as with
+ * first/next. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (node != ctx->exp) {
+		printf("walk visited %p instead of %p\n", node, ctx->exp);
+		abort();
+	}
+	ctx->exp = cebusi_next(&ceb_root, node);
+	ctx->visits++;
+	return node == ctx->stop;
+}
+
+/* walks the direct tree in both directions, verifying that keys are ordered
+ * and that all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct walk_ctx ctx;
+	struct ceb_node *node, *prev;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebusi_first(&ceb_root); node; prev = node, node = cebusi_next(&ceb_root, node), n++) {
+		if (prev && keycmp(container_of(prev, struct key, node)->str, container_of(node, struct key, node)->str) >= 0) {
+			printf("key \"%s\" after \"%s\"\n", container_of(node, struct key, node)->str, container_of(prev, struct key, node)->str);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebusi_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebusi_last(&ceb_root); node; prev = node, node = cebusi_prev(&ceb_root, node), n++)
+		;
+
+	if (n != nb_keys || prev != cebusi_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	/* full walk, then one stopping on a node in the middle */
+	ctx.exp = cebusi_first(&ceb_root);
+	ctx.stop = NULL;
+	ctx.visits = 0;
+	if (cebusi_walk(&ceb_root, walk_cb, &ctx) || ctx.exp || ctx.visits != (size_t)nb_keys) {
+		printf("walk stopped before the end\n");
+		abort();
+	}
+
+	if (nb_keys) {
+		ctx.exp = cebusi_first(&ceb_root);
+		ctx.stop = &keys[nb_keys / 2]->node;
+		if (cebusi_walk(&ceb_root, walk_cb, &ctx) != ctx.stop) {
+			printf("walk didn't stop on the requested node\n");
+			abort();
+		}
+	}
+}
+
+/* state of a range deletion: its bounds and the number of nodes passed to
+ * the callback.
+ */
+struct del_ctx {
+	const char *lo, *hi;
+	size_t calls;
+};
+
+/* range deletion callback: the node must have left the tree and be in the
+ * range. It's still indexed in the other trees, so it's not released here.
+ */
+static void free_cb(struct ceb_node *node, void *arg)
+{
+	struct del_ctx *ctx = arg;
+	const char *str = container_of(node, struct key, node)->str;
+
+	if (ceb_intree(node) || keycmp(str, ctx->lo) < 0 || keycmp(str, ctx->hi) > 0) {
+		printf("range deletion '%s'-'%s' passed \"%s\"\n", ctx->lo, ctx->hi, str);
+		abort();
+	}
+	ctx->calls++;
+}
+
+/* deletes the keys between <lo> and <hi> from the direct and indirect trees,
+ * verifying their number and the nodes passed to the callback, then that all
+ * other nodes remain in the trees. The deleted keys are then removed from the
+ * case sensitive tree and released, and the remaining ones walked. Aborts on
+ * error.
+ */
+static void check_delete_range(const char *lo, const char *hi)
+{
+	struct del_ctx ctx = { .lo = lo, .hi = hi, .calls = 0 };
+	struct key *k;
+	size_t exp = 0;
+	int i, in;
+
+	for (i = 0; i < nb_keys; i++)
+		exp += keycmp(keys[i]->str, lo) >= 0 && keycmp(keys[i]->str, hi) <= 0;
+
+	if (cebusi_delete_range(&ceb_root, lo, hi, free_cb, &ctx) != exp || ctx.calls != exp ||
+	    cebuisi_ofs_delete_range(&ceb_iroot, IKOFS, lo, hi, NULL, NULL) != exp ||
+	    cebusi_count_range(&ceb_root, lo, hi)) {
+		printf("range '%s'-'%s': failed to delete %zu keys\n", lo, hi, exp);
+		abort();
+	}
+
+	for (i = nb_keys - 1; i >= 0; i--) {
+		k = keys[i];
+		in = keycmp(k->str, lo) >= 0 && keycmp(k->str, hi) <= 0;
+		if (in == ceb_intree(&k->node) || in == ceb_intree(&k->inode) ||
+		    (!in && cebusi_lookup(&ceb_root, k->str) != &k->node)) {
+			printf("range '%s'-'%s': \"%s\" is %s\n", lo, hi, k->str, in ? "still there" : "lost");
+			abort();
+		}
+		if (!in)
+			continue;
+		if (cebus_ofs_delete(&ceb_sroot, SKOFS, &k->snode) != &k->snode)
+			abort();
+		keys[i] = keys[--nb_keys];
+		free(k);
+	}
+	check_walk();
+}
+
+/* walks the nodes of the direct tree between <lo> and <hi>, verifying that
+ * they are visited in the same order as with lookup_ge/next and that they
+ * are all those in the range, then checks their count in all trees. Aborts
+ * on error.
+ */
+static void check_range(const char *lo, const char *hi)
+{
+	struct walk_ctx ctx;
+	size_t exp = 0, sexp = 0;
+	int i;
+
+	for (i = 0; i < nb_keys; i++) {
+		if (keycmp(keys[i]->str, lo) >= 0 && keycmp(keys[i]->str, hi) <= 0)
+			exp++;
+		if (strcmp(keys[i]->str, lo) >= 0 && strcmp(keys[i]->str, hi) <= 0)
+			sexp++;
+	}
+
+	ctx.exp = cebusi_lookup_ge(&ceb_root, lo);
+	ctx.stop = NULL;
+	ctx.visits = 0;
+	if (cebusi_walk_range(&ceb_root, lo, hi, walk_cb, &ctx) || ctx.visits != exp) {
+		printf("range walk '%s'-'%s' visited %zu nodes instead of %zu\n", lo, hi, ctx.visits, exp);
+		abort();
+	}
+
+	if (cebusi_count_range(&ceb_root, lo, hi) != exp ||
+	    cebuisi_ofs_count_range(&ceb_iroot, IKOFS, lo, hi) != exp ||
+	    cebus_ofs_count_range(&ceb_sroot, SKOFS, lo, hi) != sexp) {
+		printf("range count '%s'-'%s' differs from %zu/%zu\n", lo, hi, exp, sexp);
+		abort();
+	}
+}
+
+/* fills <buf> with a key made of up to <max> 'a' followed by a 'b', as found
+ * in the chain built by add_deep().
+ */
+static void deepkey(char *buf, int max)
+{
+	int n = rnd32() % (max + 1);
+
+	memset(buf, 'a', n);
+	strcpy(buf + n, "b");
+}
+
+/* moves iterator <iter> to the first node not lower than a random key, either
+ * taken from the alphabet or from the deep chain, and compares the result with
+ * lookup_ge. <*cur> and <*on> are updated. Aborts on error.
+ */
+static void check_seek(struct ceb_iter *iter, const char **cur, int *on, size_t maxlen, size_t nbchr)
+{
+	static char seek[256];
+	struct ceb_node *ret, *exp;
+
+	if (rnd32() & 1)
+		rndkey(seek, maxlen, nbchr);
+	else
+		deepkey(seek, 200);
+
+	ret = cebusi_iter_seek(iter, seek);
+	exp = cebusi_lookup_ge(&ceb_root, seek);
+	if (ret != exp) {
+		printf("iter seek to \"%s\" returned %p instead of %p\n", seek, ret, exp);
+		abort();
+	}
+
+	*on = !!ret;
+	*cur = ret ? container_of(ret, struct key, node)->str : seek;
+}
+
+/* steps iterator <iter> forwards or backwards from the node of key <*cur>, or
+ * from off the tree if <*on> is zero, and compares the result with the
+ * equivalent lookups unless the iterator became stale, in which case it's
+ * repositioned using a seek. <*cur> and <*on> are updated. Aborts on error.
+ */
+static void check_iter(struct ceb_iter *iter, const char **cur, int *on, int back, size_t maxlen, size_t nbchr)
+{
+	struct ceb_node *ret, *exp;
+
+	ret = back ? cebusi_iter_prev(iter) : cebusi_iter_next(iter);
+	if (ceb_iter_stale(iter)) {
+		check_seek(iter, cur, on, maxlen, nbchr);
+		return;
+	}
+	else if (!*on)
+		exp = back ? cebusi_last(&ceb_root) : cebusi_first(&ceb_root);
+	else
+		exp = back ? cebusi_lookup_lt(&ceb_root, *cur) : cebusi_lookup_gt(&ceb_root, *cur);
+
+	if (ret != exp) {
+		printf("iter %s from \"%s\" (%s) returned %p instead of %p\n", back ? "prev" : "next",
+		       *cur, *on ? "on" : "off", ret, exp);
+		abort();
+	}
+
+	*on = !!ret;
+	if (ret)
+		*cur = container_of(ret, struct key, node)->str;
+}
+
+/* inserts into all trees the keys made of <n> 'a' followed by <end>, for <n>
+ * from 0 to <max>, unless already present. Each of them differs from the
+ * previous ones one character later, so that they form a chain of <max>
+ * nodes, deeper than what walks and iterators keep track of. With a 'b', each
+ * key sorts before the previous ones and the chain goes left, otherwise they
+ * are prefixes of each other and it goes right.
+ */
+static void add_deep(int max, const char *end)
+{
+	struct key *key;
+	int n;
+
+	keys = realloc(keys, (nb_keys + max + 1) * sizeof(*keys));
+	for (n = 0; n <= max; n++) {
+		key = calloc(1, sizeof(*key) + n + strlen(end) + 1);
+		memset(key->str, 'a', n);
+		strcpy(key->str + n, end);
+		key->ptr = key->str;
+		if (cebusi_insert(&ceb_root, &key->node) != &key->node) {
+			free(key);
+			continue;
+		}
+		if (cebuisi_ofs_insert(&ceb_iroot, IKOFS, &key->inode) != &key->inode ||
+		    cebus_ofs_insert(&ceb_sroot, SKOFS, &key->snode) != &key->snode)
+			abort();
+		keys[nb_keys++] = key;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	char buf[256], buf2[256];
+	struct ceb_iter iter;
+	const char *cur = "";
+	struct key *key;
+	char *p;
+	size_t nbchr = sizeof(alphabet) - 1;
+	size_t maxlen = 5;
+	int count = 1000;
+	uint32_t v;
+	int idx, on = 0;
+	int steps;
+
+	argv++; argc--;
+
+	if (argc && **argv == '-') {
+		printf("Usage: %s [cnt [maxlen [nbchr [seed]]]]\n", argv0);
+		exit(1);
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		maxlen = atoi(larg = *(argv++));
+
+	if (argc > 2)
+		nbchr = atoi(larg = *(argv++));
+
+	if (argc > 3)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	if (maxlen >= sizeof(buf))
+		maxlen = sizeof(buf) - 1;
+
+	if (!nbchr || nbchr > sizeof(alphabet) - 1)
+		nbchr = sizeof(alphabet) - 1;
+
+	keys = calloc(count, sizeof(*keys));
+	steps = count;
+
+	/* random inserts and deletes, keys differing only by their case must
+	 * be rejected.
+	 */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0 && (v & 0xc00) == 0) {
+			/* range delete starting at a key */
+			strcpy(buf, keys[(v >> 12) % nb_keys]->str);
+			rndkey(buf2, maxlen, nbchr);
+			if (keycmp(buf, buf2) <= 0)
+				check_delete_range(buf, buf2);
+			else
+				check_delete_range(buf2, buf);
+		}
+		else if (nb_keys && (v & 0x300) == 0) {
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (cebusi_delete(&ceb_root, &key->node) != &key->node)
+				abort();
+			if (cebuisi_ofs_pick(&ceb_iroot, IKOFS, key->str) != &key->inode)
+				abort();
+			if (cebus_ofs_delete(&ceb_sroot, SKOFS, &key->snode) != &key->snode)
+				abort();
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			rndkey(buf, maxlen, nbchr);
+			key = calloc(1, sizeof(*key) + strlen(buf) + 1);
+			strcpy(key->str, buf);
+			key->ptr = key->str;
+			old = cebusi_insert(&ceb_root, &key->node);
+			if (old == &key->node) {
+				if (cebuisi_ofs_insert(&ceb_iroot, IKOFS, &key->inode) != &key->inode)
+					abort();
+				if (cebus_ofs_insert(&ceb_sroot, SKOFS, &key->snode) != &key->snode)
+					abort();
+				keys[nb_keys++] = key;
+			}
+			else if (keycmp(container_of(old, struct key, node)->str, key->str) != 0)
+				abort();
+			else
+				free(key);
+		}
+
+		rndkey(buf, maxlen, nbchr);
+		check(buf);
+		buf[rnd32() % (strlen(buf) + 1)] = 0;
+		check_prefix(buf);
+		rndkey(buf2, maxlen, nbchr);
+		check_range(buf, buf2);
+	}
+
+	check_walk();
+
+	/* limits */
+	check("");
+	check("{{{{{{");
+	check_prefix("");
+	check_prefix("{{{{{{");
+	check_range("", "{{{{{{");
+
+	/* walks over a tree deeper than their stack must continue with key
+	 * lookups, and range walks must start with one when their lower bound
+	 * is deeper than that.
+	 */
+	add_deep(200, "b");
+	check_walk();
+	memset(buf, 'a', 150);
+	strcpy(buf + 150, "b");
+	check_range(buf, "b");
+	check_range(buf, "{{{{{{");
+	check_range(buf + 100, buf + 140);
+	check_range("", "{{{{{{");
+	check(buf);
+	check(buf + 10);
+
+	/* random inserts and deletes, partly in the deep chain, while an
+	 * iterator moves back and forth and sometimes seeks, so that it also
+	 * has to step without its path. Removed nodes are not freed since the
+	 * iterator may still reference them.
+	 */
+	keys = realloc(keys, (nb_keys + steps) * sizeof(*keys));
+	cebusi_iter_init(&iter, &ceb_root);
+	while (steps--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (cebusi_delete(&ceb_root, &key->node) != &key->node ||
+			    cebuisi_ofs_delete(&ceb_iroot, IKOFS, &key->inode) != &key->inode ||
+			    cebus_ofs_delete(&ceb_sroot, SKOFS, &key->snode) != &key->snode)
+				abort();
+			keys[idx] = keys[--nb_keys];
+		}
+		else if ((v & 0x300) != 0x300) {
+			if (v & 0x400)
+				rndkey(buf, maxlen, nbchr);
+			else
+				deepkey(buf, 200);
+			key = calloc(1, sizeof(*key) + strlen(buf) + 1);
+			strcpy(key->str, buf);
+			key->ptr = key->str;
+			if (cebusi_insert(&ceb_root, &key->node) == &key->node) {
+				if (cebuisi_ofs_insert(&ceb_iroot, IKOFS, &key->inode) != &key->inode ||
+				    cebus_ofs_insert(&ceb_sroot, SKOFS, &key->snode) != &key->snode)
+					abort();
+				keys[nb_keys++] = key;
+			}
+			else
+				free(key);
+		}
+
+		if ((v & 0x7000) == 0)
+			check_seek(&iter, &cur, &on, maxlen, nbchr);
+		check_iter(&iter, &cur, &on, rnd32() & 1, maxlen, nbchr);
+		check_iter(&iter, &cur, &on, rnd32() & 1, maxlen, nbchr);
+	}
+	check_walk();
+
+	/* range deletions in a tree deeper than their path, either with a
+	 * bound below it, or covering a subtree too deep to be purged at once,
+	 * must continue with one deletion at a time.
+	 */
+	add_deep(200, "b");
+	add_deep(200, "");
+	memset(buf, 'a', 150);
+	buf[150] = 0;
+	check_delete_range(buf + 10, buf);
+	strcpy(buf2, buf);
+	strcpy(buf2 + 140, "b");
+	check_delete_range(buf2, buf2 + 20);
+	check_delete_range("a", "ab");
+	check_delete_range("", "{{{{{{");
+	return 0;
+}
@@ -0,0 +1,298 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebuv_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+/* the key's length immediately follows the node, then the key */
+struct key {
+	struct ceb_node node;
+	uint32_t len;
+	unsigned char data[0];
+};
+
+/* all keys present in the tree, unsorted */
+struct key **keys;
+int nb_keys;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* fills <buf> with a random key of up to <maxlen> bytes made of values from
+ * 0 to <mask> so that many keys are prefixes of other ones, and returns its
+ * length.
+ */
+static size_t rndkey(unsigned char *buf, size_t maxlen, uint32_t mask)
+{
+	size_t len = rnd32() % (maxlen + 1);
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = rnd32() & mask;
+	return len;
+}
+
+/* reference comparison: lexicographic with the shortest key first */
+static int keycmp(const unsigned char *a, size_t alen, const unsigned char *b, size_t blen)
+{
+	int ret = memcmp(a, b, alen < blen ? alen : blen);
+
+	if (ret)
+		return ret;
+	return (alen > blen) - (alen < blen);
+}
+
+/* compares the result of all lookups around key <v> of length <len> with the
+ * expected ones calculated from the list of keys. Aborts on error.
+ */
+static void check(const unsigned char *v, size_t len)
+{
+	struct key *le = NULL, *lt = NULL, *ge = NULL, *gt = NULL, *eq = NULL;
+	int i, c;
+
+	for (i = 0; i < nb_keys; i++) {
+		struct key *k = keys[i];
+
+		c = keycmp(k->data, k->len, v, len);
+		if (c == 0)
+			eq = k;
+		if (c <= 0 && (!le || keycmp(k->data, k->len, le->data, le->len) > 0))
+			le = k;
+		if (c <  0 && (!lt || keycmp(k->data, k->len, lt->data, lt->len) > 0))
+			lt = k;
+		if (c >= 0 && (!ge || keycmp(k->data, k->len, ge->data, ge->len) < 0))
+			ge = k;
+		if (c >  0 && (!gt || keycmp(k->data, k->len, gt->data, gt->len) < 0))
+			gt = k;
+	}
+
+#define CHECK(name, res, exp) do {					\
+		const struct ceb_node *n = res;				\
+		if (n != (exp ? &exp->node : NULL)) {			\
+			printf("%s(len=%u) returned %p instead of %p\n",\
+			       name, (unsigned)len, n, exp ? &exp->node : NULL); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebuv_lookup(&ceb_root, v, len),    eq);
+	CHECK("lookup_le", cebuv_lookup_le(&ceb_root, v, len), le);
+	CHECK("lookup_lt", cebuv_lookup_lt(&ceb_root, v, len), lt);
+	CHECK("lookup_ge", cebuv_lookup_ge(&ceb_root, v, len), ge);
+	CHECK("lookup_gt", cebuv_lookup_gt(&ceb_root, v, len), gt);
+#undef CHECK
+}
+
+/* walks the tree in both directions, verifying that keys are ordered and that
+ * all nodes are visited. Aborts on error.
+ */
+static void check_walk(void)
+{
+	struct ceb_node *node, *prev;
+	struct key *k1, *k2;
+	int n;
+
+	for (n = 0, prev = NULL, node = cebuv_first(&ceb_root); node; prev = node, node = cebuv_next(&ceb_root, node), n++) {
+		if (!prev)
+			continue;
+		k1 = container_of(prev, struct key, node);
+		k2 = container_of(node, struct key, node);
+		if (keycmp(k1->data, k1->len, k2->data, k2->len) >= 0) {
+			printf("key of len %u after key of len %u\n", k2->len, k1->len);
+			abort();
+		}
+	}
+
+	if (n != nb_keys || prev != cebuv_last(&ceb_root)) {
+		printf("forward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+
+	for (n = 0, prev = NULL, node = cebuv_last(&ceb_root); node; prev = node, node = cebuv_prev(&ceb_root, node), n++)
+		;
+
+	if (n != nb_keys || prev != cebuv_first(&ceb_root)) {
+		printf("backward walk found %d nodes instead of %d\n", n, nb_keys);
+		abort();
+	}
+}
+
+/* orders keys like keycmp(), for qsort() */
+static int keysort(const void *a, const void *b)
+{
+	const struct key *ka = *(const struct key **)a;
+	const struct key *kb = *(const struct key **)b;
+
+	return keycmp(ka->data, ka->len, kb->data, kb->len);
+}
+
+/* state of a range walk: the keys expected in this order, their number and
+ * the number of nodes visited.
+ */
+struct walk_ctx {
+	struct key **exp;
+	size_t nb, visits;
+};
+
+/* range walk callback verifying that nodes are visited in the order of the
+ * sorted keys. Aborts on error.
+ */
+static int walk_cb(struct ceb_node *node, void *arg)
+{
+	struct walk_ctx *ctx = arg;
+
+	if (ctx->visits >= ctx->nb || node != &ctx->exp[ctx->visits]->node) {
+		printf("range walk visited %p instead of %p\n", node,
+		       ctx->visits < ctx->nb ? &ctx->exp[ctx->visits]->node : NULL);
+		abort();
+	}
+	ctx->visits++;
+	return 0;
+}
+
+/* walks and counts the nodes between <lo> of length <lo_len> and <hi> of
+ * length <hi_len>, comparing them with the sorted keys of this range. Aborts
+ * on error.
+ */
+static void check_range(const unsigned char *lo, size_t lo_len, const unsigned char *hi, size_t hi_len)
+{
+	struct walk_ctx ctx;
+	int i;
+
+	ctx.exp = malloc((nb_keys + 1) * sizeof(*ctx.exp));
+	ctx.nb = ctx.visits = 0;
+	for (i = 0; i < nb_keys; i++) {
+		if (keycmp(keys[i]->data, keys[i]->len, lo, lo_len) >= 0 &&
+		    keycmp(keys[i]->data, keys[i]->len, hi, hi_len) <= 0)
+			ctx.exp[ctx.nb++] = keys[i];
+	}
+	qsort(ctx.exp, ctx.nb, sizeof(*ctx.exp), keysort);
+
+	if (cebuv_walk_range(&ceb_root, lo, lo_len, hi, hi_len, walk_cb, &ctx) || ctx.visits != ctx.nb ||
+	    cebuv_count_range(&ceb_root, lo, lo_len, hi, hi_len) != ctx.nb) {
+		printf("range of len %u-%u: visited %zu nodes instead of %zu\n",
+		       (unsigned)lo_len, (unsigned)hi_len, ctx.visits, ctx.nb);
+		abort();
+	}
+	free(ctx.exp);
+}
+
+int main(int argc, char **argv)
+{
+	struct ceb_node *old;
+	char *orig_argv, *argv0 = *argv, *larg;
+	unsigned char buf[256], buf2[256];
+	struct key *key;
+	char *p;
+	uint32_t mask = 0x3;
+	size_t maxlen = 6;
+	int count = 1000;
+	size_t len, len2;
+	uint32_t v;
+	int idx;
+
+	argv++; argc--;
+
+	if (argc && **argv == '-') {
+		printf("Usage: %s [cnt [maxlen [mask [seed]]]]\n", argv0);
+		exit(1);
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		maxlen = atoi(larg = *(argv++));
+
+	if (argc > 2)
+		mask = strtoul(larg = *(argv++), NULL, 0);
+
+	if (argc > 3)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	if (maxlen > sizeof(buf))
+		maxlen = sizeof(buf);
+
+	keys = calloc(count, sizeof(*keys));
+
+	/* random inserts and deletes, either by node or by key */
+	while (count--) {
+		v = rnd32();
+		if (nb_keys && (v & 0x300) == 0) {
+			idx = (v >> 12) % nb_keys;
+			key = keys[idx];
+			if (v & 0x1000)
+				old = cebuv_delete(&ceb_root, &key->node);
+			else
+				old = cebuv_pick(&ceb_root, key->data, key->len);
+
+			if (old != &key->node)
+				abort();
+
+			/* the node is not in the tree anymore */
+			if (cebuv_lookup(&ceb_root, key->data, key->len))
+				abort();
+
+			keys[idx] = keys[--nb_keys];
+			free(key);
+		}
+		else {
+			len = rndkey(buf, maxlen, mask);
+			key = calloc(1, sizeof(*key) + len);
+			key->len = len;
+			memcpy(key->data, buf, len);
+			old = cebuv_insert(&ceb_root, &key->node);
+			if (old == &key->node)
+				keys[nb_keys++] = key;
+			else if (!old || keycmp(container_of(old, struct key, node)->data,
+						container_of(old, struct key, node)->len,
+						key->data, key->len) != 0)
+				abort();
+			else
+				free(key);
+		}
+
+		len = rndkey(buf, maxlen, mask);
+		check(buf, len);
+
+		/* a range between random keys of different lengths, and one
+		 * from a key's prefix to the key.
+		 */
+		len2 = rndkey(buf2, maxlen, mask);
+		if (keycmp(buf, len, buf2, len2) <= 0)
+			check_range(buf, len, buf2, len2);
+		else
+			check_range(buf2, len2, buf, len);
+		check_range(buf, rnd32() % (len + 1), buf, len);
+	}
+
+	check_walk();
+
+	/* limits */
+	check(buf, 0);
+	memset(buf, 0xff, maxlen);
+	check(buf, maxlen);
+	check_range(buf, 0, buf, maxlen);
+	return 0;
+}
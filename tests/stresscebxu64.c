@@ -0,0 +1,309 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cebu64_tree.h"
+#include "cebxu64_tree.h"
+
+/* The items are stored in an array that is regularly reallocated as it grows,
+ * and indexed in a tree based on the array's address, whose root is kept
+ * outside. The same keys are also indexed in an absolute tree made of
+ * reference nodes, used to check the results.
+ */
+struct item {
+	struct cebx_node node; // indexed node, key follows
+	uint64_t key;
+};
+
+struct ref {
+	struct ceb_node node;
+	uint64_t key;
+};
+
+uint32_t root = 0;
+struct item *items;
+struct ceb_node *ceb_root = NULL;
+struct ref *refs;
+
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32()
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns the index of item node <node>, or -1 for NULL */
+static long idx(const struct cebx_node *node)
+{
+	if (!node)
+		return -1;
+	return container_of(node, struct item, node) - items;
+}
+
+/* returns the index of reference node <node>, or -1 for NULL */
+static long ridx(const struct ceb_node *node)
+{
+	if (!node)
+		return -1;
+	return container_of(node, struct ref, node) - refs;
+}
+
+/* compares the indexed tree against the reference one using all lookup
+ * methods around key <v>. Aborts on error.
+ */
+static void check(const char *step, uint64_t v)
+{
+	long i1, i2;
+
+#define CHECK(name, rel, abs) do {					\
+		i1 = idx(rel); i2 = ridx(abs);				\
+		if (i1 != i2) {						\
+			printf("%s: %s(%llu) mismatch: %ld vs %ld\n",	\
+			       step, name, (unsigned long long)v, i1, i2); \
+			abort();					\
+		}							\
+	} while (0)
+
+	CHECK("lookup",    cebxu64_lookup(&root, items, v),    cebu64_lookup(&ceb_root, v));
+	CHECK("lookup_le", cebxu64_lookup_le(&root, items, v), cebu64_lookup_le(&ceb_root, v));
+	CHECK("lookup_lt", cebxu64_lookup_lt(&root, items, v), cebu64_lookup_lt(&ceb_root, v));
+	CHECK("lookup_ge", cebxu64_lookup_ge(&root, items, v), cebu64_lookup_ge(&ceb_root, v));
+	CHECK("lookup_gt", cebxu64_lookup_gt(&root, items, v), cebu64_lookup_gt(&ceb_root, v));
+#undef CHECK
+}
+
+/* walks the indexed tree and the reference one in both directions and
+ * verifies they contain the same nodes. Aborts on error.
+ */
+static void check_walk(const char *step)
+{
+	struct cebx_node *node;
+	struct ceb_node *rnode;
+
+	for (node = cebxu64_first(&root, items), rnode = cebu64_first(&ceb_root);
+	     node || rnode;
+	     node = cebxu64_next(&root, items, node), rnode = cebu64_next(&ceb_root, rnode)) {
+		if (idx(node) != ridx(rnode)) {
+			printf("%s: forward walk mismatch: %ld vs %ld\n", step, idx(node), ridx(rnode));
+			abort();
+		}
+	}
+
+	for (node = cebxu64_last(&root, items), rnode = cebu64_last(&ceb_root);
+	     node || rnode;
+	     node = cebxu64_prev(&root, items, node), rnode = cebu64_prev(&ceb_root, rnode)) {
+		if (idx(node) != ridx(rnode)) {
+			printf("%s: backward walk mismatch: %ld vs %ld\n", step, idx(node), ridx(rnode));
+			abort();
+		}
+	}
+}
+
+/* steps iterator <iter> over the indexed tree forwards or backwards from key
+ * <*cur>, or from outside the tree if <*on> is zero, and compares the result
+ * with the same move in the reference tree. A stale iterator is repositioned
+ * on a random key using a seek. Aborts on error.
+ */
+static void check_iter(struct ceb_iter *iter, uint64_t *cur, int *on, int back, uint64_t mask)
+{
+	struct cebx_node *ret;
+	struct ceb_node *exp;
+
+	ret = back ? cebxu64_iter_prev(iter) : cebxu64_iter_next(iter);
+	if (ceb_iter_stale(iter)) {
+		*cur = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		ret = cebxu64_iter_seek(iter, *cur);
+		exp = cebu64_lookup_ge(&ceb_root, *cur);
+	}
+	else if (!*on)
+		exp = back ? cebu64_last(&ceb_root) : cebu64_first(&ceb_root);
+	else
+		exp = back ? cebu64_lookup_lt(&ceb_root, *cur) : cebu64_lookup_gt(&ceb_root, *cur);
+
+	if (idx(ret) != ridx(exp)) {
+		printf("iter %s from %#llx (%s) returned %ld instead of %ld\n", back ? "prev" : "next",
+		       (unsigned long long)*cur, *on ? "on" : "off", idx(ret), ridx(exp));
+		abort();
+	}
+
+	*on = !!ret;
+	if (ret)
+		*cur = container_of(ret, struct item, node)->key;
+}
+
+int main(int argc, char **argv)
+{
+	char *orig_argv, *argv0 = *argv, *larg;
+	struct ceb_iter iter;
+	struct cebx_node *node;
+	struct item *item;
+	char *p;
+	uint64_t v;
+	uint64_t mask = 0xffff;
+	uint64_t cur, lo, hi;
+	size_t cnt;
+	int count = 1000;
+	int alloc = 0;
+	int debug = 0;
+	int i, j, on;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [cnt [mask [seed]]]\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+
+	if (argc > 0)
+		count = atoi(larg = *(argv++));
+
+	if (argc > 1)
+		mask = atoll(larg = *(argv++));
+
+	if (argc > 2)
+		rnd32seed = atol(larg = *(argv++));
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	refs = calloc(count, sizeof(*refs));
+
+	/* insert random keys, and delete some from time to time. The array is
+	 * grown by small steps so that it gets moved by realloc() many times.
+	 */
+	for (i = 0; i < count; i++) {
+		if (i >= alloc) {
+			alloc += 16;
+			items = realloc(items, alloc * sizeof(*items));
+			check_walk("realloc");
+		}
+
+		v = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		item = &items[i];
+		item->key = refs[i].key = v;
+
+		if (cebxu64_insert(&root, items, &item->node) == &item->node) {
+			if (cebu64_insert(&ceb_root, &refs[i].node) != &refs[i].node)
+				abort();
+		}
+
+		if (!(rnd32() & 7)) {
+			v = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+			if (ridx(cebu64_pick(&ceb_root, v)) != idx(cebxu64_pick(&root, items, v)))
+				abort();
+		}
+		check("insert", v);
+	}
+
+	check_walk("orig");
+
+	/* a node located before the base cannot be addressed, and must be
+	 * rejected before the tree is even looked at.
+	 */
+	if (cebxu64_insert(&root, items + 1, &items[0].node) != NULL)
+		abort();
+	check_walk("before");
+
+	if (debug)
+		cebxu64_default_dump(&root, items, orig_argv, 0);
+
+	for (i = 0; i < count; i++) {
+		v = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		check("lookup", v);
+	}
+
+	/* an iterator moves back and forth over the tree while random keys are
+	 * deleted and inserted again around it. Deleted nodes remain readable in
+	 * the array, and deleting the iterator's current node must always make it
+	 * stale.
+	 */
+	cebxu64_iter_init(&iter, &root, items);
+	cur = 0; on = 0;
+	for (i = 0; i < count; i++) {
+		if (on && !(rnd32() & 15)) {
+			node = cebxu64_lookup(&root, items, cur);
+			if (!node)
+				abort();
+			j = idx(node);
+			if (cebxu64_delete(&root, items, node) != node ||
+			    cebu64_delete(&ceb_root, &refs[j].node) != &refs[j].node)
+				abort();
+			if (cebxu64_iter_next(&iter) || !ceb_iter_stale(&iter)) {
+				printf("iter: deleting current node %#llx didn't make it stale\n", (unsigned long long)cur);
+				abort();
+			}
+		}
+		else {
+			j = rnd32() % count;
+			item = &items[j];
+			node = cebxu64_lookup(&root, items, item->key);
+			if (node == &item->node) {
+				if (cebxu64_delete(&root, items, node) != node ||
+				    cebu64_delete(&ceb_root, &refs[j].node) != &refs[j].node)
+					abort();
+			}
+			else if (!node) {
+				if (cebxu64_insert(&root, items, &item->node) != &item->node ||
+				    cebu64_insert(&ceb_root, &refs[j].node) != &refs[j].node)
+					abort();
+			}
+		}
+		check_iter(&iter, &cur, &on, rnd32() & 1, mask);
+		check_iter(&iter, &cur, &on, rnd32() & 1, mask);
+	}
+	check_walk("iter");
+
+	/* random ranges deleted from the indexed and reference trees must remove
+	 * the same keys from both.
+	 */
+	for (i = 0; i < 16; i++) {
+		lo = (((uint64_t)rnd32() << 32) + rnd32()) & mask;
+		hi = lo + ((rnd32() & mask) >> 6);
+		if (hi < lo)
+			hi = lo;
+
+		cnt = cebu64_count_range(&ceb_root, lo, hi);
+		if (cebxu64_count_range(&root, items, lo, hi) != cnt ||
+		    cebxu64_delete_range(&root, items, lo, hi, NULL, NULL) != cnt ||
+		    cebu64_delete_range(&ceb_root, lo, hi, NULL, NULL) != cnt ||
+		    cebxu64_count_range(&root, items, lo, hi)) {
+			printf("range %#llx-%#llx: failed to delete %lu keys\n",
+			       (unsigned long long)lo, (unsigned long long)hi, (unsigned long)cnt);
+			abort();
+		}
+		check_walk("range");
+	}
+
+	/* delete everything */
+	for (i = 0; i < count; i++) {
+		item = &items[i];
+		if (cebxu64_lookup(&root, items, item->key) == &item->node) {
+			if (cebxu64_delete(&root, items, &item->node) != &item->node)
+				abort();
+			if (cebu64_delete(&ceb_root, &refs[i].node) != &refs[i].node)
+				abort();
+		}
+	}
+
+	if (root || ceb_root)
+		abort();
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <sys/time.h>
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ceb32_tree.h"
+
+struct ceb_node *ceb_root = NULL;
+
+struct key {
+	struct ceb_node node;
+	uint32_t key;
+};
+
+struct ceb_node *add_value(struct ceb_node **root, uint32_t value)
+{
+	struct key *key;
+
+	key = calloc(1, sizeof(*key));
+	key->key = value;
+	return ceb32_insert(root, &key->node);
+}
+
+int main(int argc, char **argv)
+{
+	const struct ceb_node *old;
+	char *argv0 = *argv, *larg;
+	char *orig_argv;
+	char *p;
+	uint32_t v;
+	int debug = 0;
+
+	argv++; argc--;
+
+	while (argc && **argv == '-') {
+		if (strcmp(*argv, "-d") == 0)
+			debug++;
+		else {
+			printf("Usage: %s [-d]* [value]*\n", argv0);
+			exit(1);
+		}
+		argc--; argv++;
+	}
+
+	orig_argv = larg = *argv;
+	while (argc > 0) {
+		v = atoi(argv[0]);
+		old = ceb32_lookup(&ceb_root, v);
+		if (old)
+			fprintf(stderr, "Note: value %u already present at %p, adding a duplicate\n", v, old);
+		old = add_value(&ceb_root, v);
+
+		if (debug) {
+			static int round;
+			char cmd[100];
+			size_t len;
+
+			len = snprintf(cmd, sizeof(cmd), "%s [%d] +%d", orig_argv, round, v);
+			ceb32_default_dump(&ceb_root, len < sizeof(cmd) ? cmd : orig_argv, old);
+			round++;
+		}
+
+		argv++;
+		argc--;
+	}
+
+	/* rebuild non-debug args as a single string */
+	for (p = orig_argv; p < larg; *p++ = ' ')
+		p += strlen(p);
+
+	if (!debug)
+		ceb32_default_dump(&ceb_root, orig_argv, 0);
+
+	return 0;
+}
@@ -43,6 +43,35 @@ struct ceb_node *add_value(struct ceb_node **root, unsigned long value)
 	} while (1);
 }
 
+static uint32_t rnd32seed = 2463534242U;
+static uint32_t rnd32(void *arg)
+{
+	rnd32seed ^= rnd32seed << 13;
+	rnd32seed ^= rnd32seed >> 17;
+	rnd32seed ^= rnd32seed << 5;
+	return rnd32seed;
+}
+
+/* returns the position of <node> in the array <nodes> of <n> nodes sorted by
+ * key, or -1 if it's not there.
+ */
+static int node_pos(struct ceb_node **nodes, int n, const struct ceb_node *node)
+{
+	unsigned long k = container_of(node, struct key, node)->key;
+	int lo = 0, hi = n - 1, mid;
+
+	while (lo <= hi) {
+		mid = (lo + hi) / 2;
+		if (nodes[mid] == node)
+			return mid;
+		if (container_of(nodes[mid], struct key, node)->key < k)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return -1;
+}
+
 int main(int argc, char **argv)
 {
 	const struct ceb_node *old;
@@ -55,6 +84,13 @@ int main(int argc, char **argv)
 	int found;
 	int lookup_mode = 0; // 0 = EQ; -1 = LE; 1 = GE
 	int do_count = 0;
+	int do_random = 0; // 1 = raw random picks, 2 = with bias correction
+	unsigned int depth;
+	struct ceb_node **nodes;
+	int *picks;
+	int min, max;
+	int idx;
+	int err = 0;
 
 	argv++; argc--;
 
@@ -71,8 +107,12 @@ int main(int argc, char **argv)
 			lookup_mode=-2;
 		else if (strcmp(*argv, "-c") == 0)
 			do_count=1;
+		else if (strcmp(*argv, "-r") == 0)
+			do_random=1;
+		else if (strcmp(*argv, "-R") == 0)
+			do_random=2;
 		else {
-			printf("Usage: %s [-dLlgGc]* [value]*\n", argv0);
+			printf("Usage: %s [-dLlgGcrR]* [value]*\n", argv0);
 			exit(1);
 		}
 		argc--; argv++;
@@ -133,8 +173,56 @@ int main(int argc, char **argv)
 		fprintf(stderr, "counted %d elements\n", found);
 	}
 
+	/* pick 1000 random elements per node and report how often each was
+	 * picked. With the bias correction, all nodes must be picked about the
+	 * same number of times, otherwise the test fails.
+	 */
+	if (do_random) {
+		found = 0;
+		for (ret = cebul_first(&ceb_root); ret; ret = cebul_next(&ceb_root, ret))
+			found++;
+
+		nodes = calloc(found + 1, sizeof(*nodes));
+		for (idx = 0, ret = cebul_first(&ceb_root); ret; ret = cebul_next(&ceb_root, ret))
+			nodes[idx++] = ret;
+
+		/* log2(nodes) + 4 for the bias correction */
+		for (depth = 0; do_random == 2 && (1UL << depth) < (unsigned long)found * 16; depth++)
+			;
+
+		picks = calloc(found + 1, sizeof(*picks));
+		for (v = 0; v < (unsigned long)found * 1000; v++) {
+			ret = cebul_lookup_random(&ceb_root, rnd32, NULL, depth);
+			idx = node_pos(nodes, found, ret);
+			if (idx < 0) {
+				fprintf(stderr, "lookup_random() returned unknown node %p\n", ret);
+				abort();
+			}
+			picks[idx]++;
+		}
+
+		min = max = found ? picks[0] : 0;
+		for (idx = 0; idx < found; idx++) {
+			fprintf(stderr, "  %lu: picked %d times\n", container_of(nodes[idx], struct key, node)->key, picks[idx]);
+			if (picks[idx] < min)
+				min = picks[idx];
+			if (picks[idx] > max)
+				max = picks[idx];
+		}
+
+		/* the expected deviation is about 3%, so a 1.5 ratio is only
+		 * reached when the correction doesn't work.
+		 */
+		if (do_random == 2 && found && (!min || max * 2 >= min * 3)) {
+			fprintf(stderr, "uneven picks at depth %u: %d to %d times\n", depth, min, max);
+			err = 1;
+		}
+		free(picks);
+		free(nodes);
+	}
+
 	if (!debug)
 		cebul_default_dump(&ceb_root, orig_argv, 0);
 
-	return 0;
+	return err;
 }